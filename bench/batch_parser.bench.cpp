@@ -0,0 +1,82 @@
+#include <mapbox/svg/batch_parser.hpp>
+#include <mapbox/svg/path_buffer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Icon-like paths of varying length: a few curves and lines with 2-4 decimals.
+std::vector<std::string> makeCorpus(const std::size_t count) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> commands(4, 120);
+    std::uniform_real_distribution<double> coordinate(-20, 20);
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    char number[32];
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string path = "M7.5,0.5";
+        const int n = commands(random);
+        for (int k = 0; k < n; ++k) {
+            path += k % 3 ? 'c' : 'l';
+            for (int a = 0; a < (k % 3 ? 6 : 2); ++a) {
+                std::snprintf(number, sizeof(number), a ? ",%.4g" : "%.4g", coordinate(random));
+                path += number;
+            }
+        }
+        path += 'z';
+        corpus.push_back(std::move(path));
+    }
+    return corpus;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::string> corpus = makeCorpus(50000);
+    std::vector<mapbox::svg::PathSlice> paths;
+    std::size_t bytes = 0;
+    for (const std::string& path : corpus) {
+        paths.push_back({ path.data(), path.size() });
+        bytes += path.size();
+    }
+
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("batch_parser: %zu paths, %.1f MB, %u hardware threads\n", paths.size(),
+                bytes / 1e6, cores);
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(cores);
+
+    double baseline = 0;
+    for (const unsigned threads : threadCounts) {
+        std::atomic<std::size_t> commands{ 0 };
+        const auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < 5; ++iteration) {
+            mapbox::svg::parseBatch(
+                paths.data(), paths.size(), [] { return mapbox::svg::PathBuffer(); },
+                [&](std::size_t, mapbox::svg::PathBuffer& buffer,
+                    const mapbox::svg::PathParseResult&) {
+                    commands.fetch_add(buffer.size(), std::memory_order_relaxed);
+                    buffer.clear();
+                },
+                threads);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count() / 5;
+        if (threads == 1) {
+            baseline = seconds;
+        }
+        std::printf("  %3u threads  %8.1f MB/s  %6.2fx  (%.1f%% efficiency)\n", threads,
+                    bytes / seconds / 1e6, baseline / seconds,
+                    100 * baseline / seconds / threads);
+    }
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <mapbox/svg/mvt_encoder.hpp>
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/path_buffer.hpp>
+#include <mapbox/svg/path_cache.hpp>
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_validator.hpp>
+
+#include "perf_counters.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Times several receivers over the path corpus in bench/corpus, one path per line:
+//
+// icons.txt          small UI icons on a 24 unit grid, in the compact style of icon sets
+// map_outlines.txt   a few long closed outlines in tile coordinates, 3 to 6 decimals
+// arcs.txt           arc-heavy rounded shapes, with flags packed without separators
+// exponents.txt      curves with every number in scientific notation
+// long_numbers.txt   numbers with 20 to 40 digits, which need the slow conversion path
+// minified.txt       minified output without separators where the grammar allows it
+//
+// The files are synthetic: random but fixed, so that results stay comparable between runs. The
+// icons are composed of circles, rounded rectangles, stars, bars, arrows and curved blobs.
+
+namespace {
+
+// One path per line.
+struct Corpus {
+    std::string name;
+    std::string text;
+    std::vector<std::pair<const char*, std::size_t>> paths;
+    std::size_t commands = 0;
+};
+
+bool load(const char* filename, Corpus& corpus) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    corpus.text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    const char* base = std::strrchr(filename, '/');
+    corpus.name = base ? base + 1 : filename;
+
+    const char* cursor = corpus.text.data();
+    const char* const end = cursor + corpus.text.size();
+    while (cursor != end) {
+        const char* line = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = line ? line : end;
+        if (lineEnd != cursor) {
+            corpus.paths.emplace_back(cursor, lineEnd - cursor);
+        }
+        cursor = line ? line + 1 : end;
+    }
+    return true;
+}
+
+struct SumReceiver {
+    double sum = 0;
+
+    void moveTo(double x, double y, bool) {
+        sum += x + y;
+    }
+    void closePath() {
+    }
+    void lineTo(double x, double y, bool) {
+        sum += x + y;
+    }
+    void horizontalLineTo(double x, bool) {
+        sum += x;
+    }
+    void verticalLineTo(double y, bool) {
+        sum += y;
+    }
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool) {
+        sum += x1 + y1 + x2 + y2 + x + y;
+    }
+    void smoothCurveTo(double x2, double y2, double x, double y, bool) {
+        sum += x2 + y2 + x + y;
+    }
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool) {
+        sum += x1 + y1 + x + y;
+    }
+    void smoothQuadraticCurveTo(double x, double y, bool) {
+        sum += x + y;
+    }
+    void arc(double rx, double ry, double r, bool, bool, double x, double y, bool) {
+        sum += rx + ry + r + x + y;
+    }
+};
+
+struct SegmentCounter {
+    unsigned long segments = 0;
+
+    void moveTo(double, double) {
+    }
+    void closePath() {
+    }
+    void lineTo(double, double) {
+        ++segments;
+    }
+};
+
+// Parses the corpus repeatedly for at least a quarter of a second and prints the averages.
+template <typename Parse>
+void measure(const Corpus& corpus, const char* receiver, PerfCounters* counters, Parse parse) {
+    std::size_t iterations = 0;
+    double seconds = 0;
+    if (counters) {
+        counters->start();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        for (const auto& path : corpus.paths) {
+            parse(path.first, path.second);
+        }
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    if (counters) {
+        counters->stop();
+    }
+
+    const double commands = double(corpus.commands) * iterations;
+    std::printf("  %-18s %8.1f MB/s  %7.2f Mcommands/s  %7.1f ns/command", receiver,
+                corpus.text.size() * iterations / seconds / 1e6, commands / seconds / 1e6,
+                seconds * 1e9 / commands);
+    if (counters) {
+        if (counters->has(PerfCounters::Cycles) && counters->has(PerfCounters::Instructions)) {
+            std::printf("  %6.1f cycles/command  %4.2f IPC",
+                        (*counters)[PerfCounters::Cycles] / commands,
+                        double((*counters)[PerfCounters::Instructions]) /
+                            (*counters)[PerfCounters::Cycles]);
+        }
+        if (counters->has(PerfCounters::BranchMisses)) {
+            std::printf("  %5.3f branch misses/command",
+                        (*counters)[PerfCounters::BranchMisses] / commands);
+        }
+        if (counters->has(PerfCounters::CacheMisses)) {
+            std::printf("  %5.3f cache misses/command",
+                        (*counters)[PerfCounters::CacheMisses] / commands);
+        }
+    }
+    std::printf("\n");
+}
+
+void run(Corpus& corpus, PerfCounters* counters) {
+    mapbox::svg::PathValidator validator;
+    std::size_t invalid = 0;
+    for (const auto& path : corpus.paths) {
+        invalid += !validator(path.first, path.second);
+        corpus.commands += validator.statistics().commands;
+    }
+    std::printf("%s: %zu paths, %.1f kB, %zu commands%s\n", corpus.name.c_str(),
+                corpus.paths.size(), corpus.text.size() / 1e3, corpus.commands,
+                invalid ? " (some paths have errors)" : "");
+    if (corpus.commands == 0) {
+        return;
+    }
+
+    measure(corpus, "PathValidator", counters,
+            [&](const char* data, std::size_t size) { validator(data, size); });
+
+    SumReceiver sum;
+    mapbox::svg::PathParser<SumReceiver> sumParser(sum);
+    measure(corpus, "double receiver", counters,
+            [&](const char* data, std::size_t size) { sumParser(data, size); });
+
+    mapbox::svg::PathBuffer buffer;
+    mapbox::svg::PathParser<mapbox::svg::PathBuffer> bufferParser(buffer);
+    measure(corpus, "PathBuffer", counters, [&](const char* data, std::size_t size) {
+        buffer.clear();
+        bufferParser(data, size);
+    });
+
+    // Every path is in the cache after the first pass, so this measures hits.
+    SumReceiver cachedSum;
+    mapbox::svg::PathCache cache(64 << 20);
+    measure(corpus, "PathCache replay", counters, [&](const char* data, std::size_t size) {
+        cache.replay(data, size, cachedSum);
+    });
+
+    mapbox::svg::FloatPathBuffer floatBuffer;
+    mapbox::svg::PathParser<mapbox::svg::FloatPathBuffer, float> floatParser(floatBuffer);
+    measure(corpus, "FloatPathBuffer", counters, [&](const char* data, std::size_t size) {
+        floatBuffer.clear();
+        floatParser(data, size);
+    });
+
+    SegmentCounter segments;
+    mapbox::svg::PathFlattener<SegmentCounter> flattener(segments, 0.25);
+    mapbox::svg::PathNormalizer<mapbox::svg::PathFlattener<SegmentCounter>> normalizer(flattener);
+    mapbox::svg::PathParser<decltype(normalizer)> flattenParser(normalizer);
+    measure(corpus, "flattened", counters, [&](const char* data, std::size_t size) {
+        normalizer.reset();
+        flattenParser(data, size);
+    });
+
+    mapbox::svg::PathBounds bounds;
+    mapbox::svg::PathParser<mapbox::svg::PathBounds> boundsParser(bounds);
+    measure(corpus, "PathBounds", counters, [&](const char* data, std::size_t size) {
+        bounds.reset();
+        boundsParser(data, size);
+    });
+
+    std::vector<uint32_t> geometry;
+    mapbox::svg::MvtEncoder encoder(geometry);
+    mapbox::svg::PathFlattener<mapbox::svg::MvtEncoder> mvtFlattener(encoder, 0.25);
+    mapbox::svg::PathNormalizer<decltype(mvtFlattener)> mvtNormalizer(mvtFlattener);
+    mapbox::svg::PathParser<decltype(mvtNormalizer)> mvtParser(mvtNormalizer);
+    measure(corpus, "MVT geometry", counters, [&](const char* data, std::size_t size) {
+        geometry.clear();
+        encoder.reset();
+        mvtNormalizer.reset();
+        mvtParser(data, size);
+        encoder.finish();
+    });
+
+    if (sum.sum == 42 && cachedSum.sum == 42 && segments.segments == 42 &&
+        bounds.bounds().maxX == 42) {
+        std::printf(" ");
+    }
+}
+
+} // namespace
+
+// Usage: bench-corpus [--counters] bench/corpus/*.txt
+int main(int argc, char** argv) {
+    PerfCounters perfCounters;
+    PerfCounters* counters = nullptr;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--counters") == 0) {
+            if (perfCounters.open()) {
+                counters = &perfCounters;
+            } else {
+                std::printf("hardware counters are not available\n");
+            }
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: %s [--counters] corpus-file...\n", argv[0]);
+        return 1;
+    }
+
+    for (const char* file : files) {
+        Corpus corpus;
+        if (!load(file, corpus)) {
+            std::fprintf(stderr, "can't read %s\n", file);
+            return 1;
+        }
+        run(corpus, counters);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <mapbox/svg/number_parser.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// `d` attributes of typical 15px map icons.
+const char* const icons[] = {
+    "M7.5,0C5.0676,0,2.2297,1.4865,2.2297,5.2703C2.2297,7.8378,6.2838,13.5135,7.5,15c1.0811-1.4865,"
+    "5.2703-7.027,5.2703-9.7297C12.7703,1.4865,9.9324,0,7.5,0z M7.5,7.1351c-1.0811,0-1.8919-0.8108-"
+    "1.8919-1.8919S6.4189,3.3514,7.5,3.3514s1.8919,0.8108,1.8919,1.8919S8.5811,7.1351,7.5,7.1351z",
+    "M14,7.5c0,3.5899-2.9101,6.5-6.5,6.5S1,11.0899,1,7.5S3.9101,1,7.5,1S14,3.9101,14,7.5z",
+    "M10.5,1.5l-2,3h-5l-2-3H10.5z M3,6v7.5C3,13.7761,3.2239,14,3.5,14h8c0.2761,0,0.5-0.2239,0.5-0.5V6"
+    "H3z M5.5,12.5h-1v-5h1V12.5z M8,12.5H7v-5h1V12.5z M10.5,12.5h-1v-5h1V12.5z",
+    "M12.6,11.6V6.3L7.5,1.2L2.4,6.3v5.3H1.5v2h12v-2H12.6z M6,11.6V8.4h3v3.2H6z",
+    "M13.1,5.4l-1.8-1.8c-0.2-0.2-0.5-0.2-0.7,0L9.9,4.3L8.6,3L9.3,2.3c0.2-0.2,0.2-0.5,0-0.7L8.5,0.8"
+    "c-0.2-0.2-0.5-0.2-0.7,0L0.9,7.7c-0.2,0.2-0.2,0.5,0,0.7l0.8,0.8c0.2,0.2,0.5,0.2,0.7,0l0.7-0.7"
+    "l1.3,1.3l-0.7,0.7c-0.2,0.2-0.2,0.5,0,0.7l1.8,1.8c0.2,0.2,0.5,0.2,0.7,0l6.9-6.9C13.3,5.9,13.3,"
+    "5.6,13.1,5.4z",
+    "M3.5,1C2.6716,1,2,1.6716,2,2.5v7C2,10.3284,2.6716,11,3.5,11H4l-1,3h1.5l1-3h4l1,3H12l-1-3h0.5"
+    "c0.8284,0,1.5-0.6716,1.5-1.5v-7C13,1.6716,12.3284,1,11.5,1H3.5z M4,3h7v4H4V3z M4.5,8.5c0.5523,"
+    "0,1,0.4477,1,1s-0.4477,1-1,1s-1-0.4477-1-1S3.9477,8.5,4.5,8.5z M10.5,8.5c0.5523,0,1,0.4477,1,1"
+    "s-0.4477,1-1,1s-1-0.4477-1-1S9.9477,8.5,10.5,8.5z",
+    "M6.85,1.35l-5.5,5.5C1.1454,7.0363,1.0242,7.2997,1,7.5c0,0.5,0.5,1,1,1h1v4c0,0.5523,0.4477,1,1,1"
+    "h2v-3h3v3h2c0.5523,0,1-0.4477,1-1v-4h1c0.5,0,1-0.5,1-1c-0.0242-0.2003-0.1454-0.4637-0.35-0.65"
+    "l-5.5-5.5C8.4607,1.1587,8.2004,1.0075,7.5,1C7.0146,1.0075,6.7543,1.1587,6.85,1.35z",
+    "M7.5,0.5c-0.8284,0-1.5,0.6716-1.5,1.5v4.4199L1.2197,9.8535C1.0773,9.9589,0.9965,10.1271,1,10.3047"
+    "v1.0156c0.0009,0.3442,0.3452,0.5833,0.668,0.4629L6,10.168v2.0059l-1.2734,0.9551C4.5855,13.2365,"
+    "4.5007,13.4049,4.5,13.582V14c0.0001,0.2761,0.2241,0.4999,0.5002,0.4998c0.0556,0,0.1108-0.0093,"
+    "0.1635-0.0276L7.5,13.6895l2.3365,0.7827c0.261,0.0901,0.5457-0.0484,0.6358-0.3094C10.4905,"
+    "14.1099,10.4999,14.0551,10.5,14v-0.418c-0.0007-0.1771-0.0855-0.3455-0.2266-0.4531L9,12.1738V10.168"
+    "l4.332,1.6152c0.3228,0.1204,0.6671-0.1187,0.668-0.4629v-1.0156c0.0035-0.1776-0.0773-0.3458-0.2197"
+    "-0.4512L9,6.4199V2C9,1.1716,8.3284,0.5,7.5,0.5z",
+};
+
+struct Number {
+    const char* first;
+    const char* last;
+};
+
+std::vector<Number> collectNumbers() {
+    std::vector<Number> numbers;
+    for (const char* icon : icons) {
+        const char* const last = icon + std::strlen(icon);
+        for (const char* cursor = icon; cursor != last;) {
+            double value = 0;
+            const char* next = mapbox::svg::detail::parseNumber(cursor, last, value);
+            if (next == cursor) {
+                ++cursor;
+            } else {
+                numbers.push_back({ cursor, last });
+                cursor = next;
+            }
+        }
+    }
+    return numbers;
+}
+
+template <typename Scan>
+double measure(const std::vector<Number>& numbers, const int iterations, Scan scan) {
+    double sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const Number& number : numbers) {
+            sum += scan(number);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (sum == 42) {
+        std::printf(" ");
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (double(numbers.size()) * iterations);
+}
+
+} // namespace
+
+int main() {
+    const std::vector<Number> numbers = collectNumbers();
+    const int iterations = 20000;
+
+    const double strtodTime = measure(numbers, iterations, [](const Number& number) {
+        return std::strtod(number.first, nullptr);
+    });
+    const double scannerTime = measure(numbers, iterations, [](const Number& number) {
+        double value = 0;
+        mapbox::svg::detail::parseNumber(number.first, number.last, value);
+        return value;
+    });
+
+    std::printf("number_parser: %zu numbers from %zu icons\n", numbers.size(),
+                sizeof(icons) / sizeof(icons[0]));
+    std::printf("  strtod               %8.2f ns/number\n", strtodTime);
+    std::printf("  detail::parseNumber  %8.2f ns/number  (%.1fx)\n", scannerTime,
+                strtodTime / scannerTime);
+    return 0;
+}
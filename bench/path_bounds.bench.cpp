@@ -0,0 +1,127 @@
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct BoxReceiver {
+    mapbox::svg::BoundingBox box;
+
+    void moveTo(double x, double y) {
+        box.extend(x, y);
+    }
+
+    void closePath() {
+    }
+
+    void lineTo(double x, double y) {
+        box.extend(x, y);
+    }
+};
+
+// The arguments of a cubic, or of an arc with the radii, the rotation of a quarter of them and the
+// flags derived from the control points.
+struct Segment {
+    double x1, y1, x2, y2, x, y;
+};
+
+const std::size_t pathLength = 16;
+const int repetitions = 200;
+
+template <typename Run>
+double measure(const char* name, const std::size_t segments, Run run) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("  %-28s %8.1f ns/segment\n", name, ns / segments / repetitions);
+    return ns;
+}
+
+// Bounds of each path of `pathLength` segments, through the vertex receiver interface.
+template <typename Receiver, typename Reset, typename Bounds>
+void cubics(Receiver& receiver, Reset reset, Bounds bounds, const std::vector<Segment>& segments) {
+    for (std::size_t i = 0; i < segments.size(); i += pathLength) {
+        reset();
+        receiver.moveTo(segments[i].x, segments[i].y, false);
+        for (std::size_t k = i + 1; k < i + pathLength; ++k) {
+            const Segment& s = segments[k];
+            receiver.curveTo(s.x1, s.y1, s.x2, s.y2, s.x, s.y, false);
+        }
+        bounds();
+    }
+}
+
+template <typename Receiver, typename Reset, typename Bounds>
+void arcs(Receiver& receiver, Reset reset, Bounds bounds, const std::vector<Segment>& segments) {
+    for (std::size_t i = 0; i < segments.size(); i += pathLength) {
+        reset();
+        receiver.moveTo(segments[i].x, segments[i].y, false);
+        for (std::size_t k = i + 1; k < i + pathLength; ++k) {
+            const Segment& s = segments[k];
+            const double rotation = s.x2 > 48 ? s.x2 * 5 : 0;
+            receiver.arc(s.x1 / 2, s.y1 / 4, rotation, s.y2 > 32, s.y2 > 16, s.x, s.y, false);
+        }
+        bounds();
+    }
+}
+
+} // namespace
+
+int main() {
+    const double tolerance = 0.1;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> coordinate(0, 64);
+
+    std::vector<Segment> segments(1024 * pathLength);
+    for (Segment& s : segments) {
+        s = { coordinate(random), coordinate(random), coordinate(random),
+              coordinate(random), coordinate(random), coordinate(random) };
+    }
+
+    std::printf("path_bounds: %zu paths of %zu random cubics or arcs in a 64x64 box, flattening "
+                "tolerance %g\n",
+                segments.size() / pathLength, pathLength - 1, tolerance);
+
+    double sum = 0;
+    mapbox::svg::PathBounds exact;
+    const auto resetExact = [&] { exact.reset(); };
+    const auto sumExact = [&] { sum += exact.bounds().maxX - exact.bounds().minY; };
+
+    BoxReceiver flattened;
+    mapbox::svg::PathFlattener<BoxReceiver> flattener(flattened, tolerance);
+    mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+    const auto resetFlattened = [&] {
+        normalizer.reset();
+        flattened.box = mapbox::svg::BoundingBox();
+    };
+    const auto sumFlattened = [&] { sum += flattened.box.maxX - flattened.box.minY; };
+
+    const double exactTime = measure("PathBounds cubics", segments.size(), [&] {
+        cubics(exact, resetExact, sumExact, segments);
+    });
+    const double flattenTime = measure("flattened cubics", segments.size(), [&] {
+        cubics(normalizer, resetFlattened, sumFlattened, segments);
+    });
+    std::printf("  speedup %.1fx\n", flattenTime / exactTime);
+
+    const double exactArcTime = measure("PathBounds arcs", segments.size(), [&] {
+        arcs(exact, resetExact, sumExact, segments);
+    });
+    const double flattenArcTime = measure("flattened arcs", segments.size(), [&] {
+        arcs(normalizer, resetFlattened, sumFlattened, segments);
+    });
+    std::printf("  speedup %.1fx\n", flattenArcTime / exactArcTime);
+
+    if (sum == 42) {
+        std::printf(" ");
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <mapbox/svg/path_flattener.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct CountingReceiver {
+    unsigned long segments = 0;
+    double sum = 0;
+
+    void moveTo(double x, double y) {
+        sum += x + y;
+    }
+
+    void closePath() {
+    }
+
+    void lineTo(double x, double y) {
+        ++segments;
+        sum += x + y;
+    }
+};
+
+struct Cubic {
+    double x0, y0, x1, y1, x2, y2, x3, y3;
+};
+
+// Reference: split at t = 0.5 until the control points are within the tolerance of the chord.
+void subdivide(const Cubic& c, const double tolerance, CountingReceiver& receiver, int depth = 0) {
+    const double dx = c.x3 - c.x0, dy = c.y3 - c.y0;
+    const double length = std::hypot(dx, dy);
+    const double d1 = std::abs((c.x1 - c.x3) * dy - (c.y1 - c.y3) * dx);
+    const double d2 = std::abs((c.x2 - c.x3) * dy - (c.y2 - c.y3) * dx);
+    if (depth >= 16 || (d1 + d2) <= tolerance * length) {
+        receiver.lineTo(c.x3, c.y3);
+        return;
+    }
+    const double x01 = (c.x0 + c.x1) / 2, y01 = (c.y0 + c.y1) / 2;
+    const double x12 = (c.x1 + c.x2) / 2, y12 = (c.y1 + c.y2) / 2;
+    const double x23 = (c.x2 + c.x3) / 2, y23 = (c.y2 + c.y3) / 2;
+    const double xa = (x01 + x12) / 2, ya = (y01 + y12) / 2;
+    const double xb = (x12 + x23) / 2, yb = (y12 + y23) / 2;
+    const double xm = (xa + xb) / 2, ym = (ya + yb) / 2;
+    subdivide({ c.x0, c.y0, x01, y01, xa, ya, xm, ym }, tolerance, receiver, depth + 1);
+    subdivide({ xm, ym, xb, yb, x23, y23, c.x3, c.y3 }, tolerance, receiver, depth + 1);
+}
+
+// Reference: halve the angle range until the chord is within the tolerance of the circle.
+void subdivideArc(double cx, double cy, double r, double a0, double a1, double tolerance,
+                  CountingReceiver& receiver) {
+    if (r * (1 - std::cos((a1 - a0) / 2)) <= tolerance) {
+        receiver.lineTo(cx + r * std::cos(a1), cy + r * std::sin(a1));
+        return;
+    }
+    const double middle = (a0 + a1) / 2;
+    subdivideArc(cx, cy, r, a0, middle, tolerance, receiver);
+    subdivideArc(cx, cy, r, middle, a1, tolerance, receiver);
+}
+
+template <typename Run>
+double measure(const char* name, CountingReceiver& receiver, const std::size_t curves, Run run) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("  %-28s %8.1f ns/curve  %6.2f segments/curve\n", name, ns / curves,
+                double(receiver.segments) / curves);
+    return ns;
+}
+
+} // namespace
+
+int main() {
+    const double tolerance = 0.1;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> coordinate(0, 64);
+
+    std::vector<Cubic> cubics(200000);
+    for (Cubic& c : cubics) {
+        c = { coordinate(random), coordinate(random), coordinate(random), coordinate(random),
+              coordinate(random), coordinate(random), coordinate(random), coordinate(random) };
+    }
+
+    std::printf("path_flattener: %zu random cubics and arcs in a 64x64 box, tolerance %g\n",
+                cubics.size(), tolerance);
+
+    CountingReceiver analytic;
+    mapbox::svg::PathFlattener<CountingReceiver> flattener(analytic, tolerance);
+    const double analyticTime = measure("PathFlattener::curveTo", analytic, cubics.size(), [&] {
+        for (const Cubic& c : cubics) {
+            flattener.moveTo(c.x0, c.y0);
+            flattener.curveTo(c.x1, c.y1, c.x2, c.y2, c.x3, c.y3);
+        }
+    });
+
+    CountingReceiver recursive;
+    const double recursiveTime = measure("recursive subdivision", recursive, cubics.size(), [&] {
+        for (const Cubic& c : cubics) {
+            recursive.moveTo(c.x0, c.y0);
+            subdivide(c, tolerance, recursive);
+        }
+    });
+    std::printf("  speedup %.1fx\n", recursiveTime / analyticTime);
+
+    CountingReceiver analyticArcs;
+    mapbox::svg::PathFlattener<CountingReceiver> arcFlattener(analyticArcs, tolerance);
+    const double analyticArcTime = measure("PathFlattener::arc", analyticArcs, cubics.size(), [&] {
+        for (const Cubic& c : cubics) {
+            arcFlattener.moveTo(c.x0, c.y0);
+            arcFlattener.arc(c.x1 / 2, c.x1 / 2, 0, c.y1 > 32, c.x2 > 32, c.x3, c.y3);
+        }
+    });
+
+    CountingReceiver recursiveArcs;
+    const double recursiveArcTime = measure("recursive arc subdivision", recursiveArcs,
+                                            cubics.size(), [&] {
+        for (const Cubic& c : cubics) {
+            mapbox::svg::EllipticalArc e;
+            recursiveArcs.moveTo(c.x0, c.y0);
+            if (mapbox::svg::EllipticalArc::fromEndpoints(c.x0, c.y0, c.x1 / 2, c.x1 / 2, 0,
+                                                          c.y1 > 32, c.x2 > 32, c.x3, c.y3, e)) {
+                subdivideArc(e.cx, e.cy, e.rx, e.theta1, e.theta1 + e.deltaTheta, tolerance,
+                             recursiveArcs);
+            }
+        }
+    });
+    std::printf("  speedup %.1fx\n", recursiveArcTime / analyticArcTime);
+
+    if (analytic.sum + recursive.sum + analyticArcs.sum + recursiveArcs.sum == 42) {
+        std::printf(" ");
+    }
+    return 0;
+}
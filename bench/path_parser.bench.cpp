@@ -0,0 +1,224 @@
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_transform.hpp>
+#include <mapbox/svg/path_validator.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+
+struct SumReceiver {
+    double sum = 0;
+    unsigned long commands = 0;
+
+    void moveTo(double x, double y, bool) {
+        add(x + y);
+    }
+    void closePath() {
+        add(0);
+    }
+    void lineTo(double x, double y, bool) {
+        add(x + y);
+    }
+    void horizontalLineTo(double x, bool) {
+        add(x);
+    }
+    void verticalLineTo(double y, bool) {
+        add(y);
+    }
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool) {
+        add(x1 + y1 + x2 + y2 + x + y);
+    }
+    void smoothCurveTo(double x2, double y2, double x, double y, bool) {
+        add(x2 + y2 + x + y);
+    }
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool) {
+        add(x1 + y1 + x + y);
+    }
+    void smoothQuadraticCurveTo(double x, double y, bool) {
+        add(x + y);
+    }
+    void arc(double rx, double ry, double r, bool, bool, double x, double y, bool) {
+        add(rx + ry + r + x + y);
+    }
+
+    void add(double value) {
+        sum += value;
+        ++commands;
+    }
+};
+
+// Takes endpoints only, so curves arrive as lines and their control points aren't converted.
+struct EndpointReceiver {
+    double sum = 0;
+    unsigned long commands = 0;
+
+    void moveTo(double x, double y, bool) {
+        add(x + y);
+    }
+    void lineTo(double x, double y, bool) {
+        add(x + y);
+    }
+    void horizontalLineTo(double x, bool) {
+        add(x);
+    }
+    void verticalLineTo(double y, bool) {
+        add(y);
+    }
+
+    void add(double value) {
+        sum += value;
+        ++commands;
+    }
+};
+
+// Counts subpaths, without converting any numbers.
+struct SubpathReceiver {
+    double sum = 0;
+    unsigned long commands = 0;
+
+    void moveTo(mapbox::svg::UnconvertedNumber, mapbox::svg::UnconvertedNumber, bool) {
+        ++commands;
+    }
+    void closePath() {
+    }
+};
+
+// Output of a bitmap tracer: absolute integer coordinates, pretty-printed with one curve per line.
+std::string tracedPath(std::size_t curves) {
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> step(-40, 40);
+    std::string path = "M 10240 20480\n";
+    int x = 10240, y = 20480;
+    for (std::size_t i = 0; i < curves; ++i) {
+        path += "        C ";
+        for (int k = 0; k < 3; ++k) {
+            x += step(random);
+            y += step(random);
+            path += std::to_string(x) + " " + std::to_string(y) + (k < 2 ? " " : "\n");
+        }
+    }
+    return path + "        Z\n";
+}
+
+// Output of a design tool exporting with high precision: compact relative curves.
+std::string precisePath(std::size_t curves) {
+    std::mt19937 random(13);
+    std::uniform_real_distribution<double> step(-20, 20);
+    std::string path = "M512.123456,384.654321";
+    char number[32];
+    for (std::size_t i = 0; i < curves; ++i) {
+        path += 'c';
+        for (int k = 0; k < 6; ++k) {
+            std::snprintf(number, sizeof(number), k ? ",%.6f" : "%.6f", step(random));
+            path += number;
+        }
+    }
+    return path + "z";
+}
+
+void run(const char* name, const std::string& path) {
+    SumReceiver receiver;
+    mapbox::svg::PathParser<SumReceiver> parser(receiver);
+    const int iterations = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        parser(path.data(), path.size());
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("  %-10s %7.1f MB  %8.1f MB/s  %7.1f ns/command%s\n", name, path.size() / 1e6,
+                path.size() * iterations / seconds / 1e6, seconds * 1e9 / receiver.commands,
+                receiver.sum == 42 ? " " : "");
+}
+
+// Like run(), with a receiver that leaves out some of the commands or numbers.
+template <typename Receiver>
+void analyze(const char* name, const std::string& path, const char* kind) {
+    Receiver receiver;
+    mapbox::svg::PathParser<Receiver> parser(receiver);
+    const int iterations = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        parser(path.data(), path.size());
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("  %-10s %7.1f MB  %8.1f MB/s  (%s)%s\n", name, path.size() / 1e6,
+                path.size() * iterations / seconds / 1e6, kind, receiver.sum == 42 ? " " : "");
+}
+
+void validate(const char* name, const std::string& path) {
+    mapbox::svg::PathValidator validator;
+    const int iterations = 20;
+    std::size_t commands = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        validator(path.data(), path.size());
+        commands += validator.statistics().commands;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("  %-10s %7.1f MB  %8.1f MB/s  %7.1f ns/command  (PathValidator)\n", name,
+                path.size() / 1e6, path.size() * iterations / seconds / 1e6,
+                seconds * 1e9 / commands);
+}
+
+// Like run(), with a transform stage in front of the receiver.
+template <typename Transform>
+void transform(const char* name,
+               const std::string& path,
+               const Transform& matrix,
+               const char* kind) {
+    SumReceiver receiver;
+    mapbox::svg::PathTransform<SumReceiver, Transform> stage(receiver, matrix);
+    mapbox::svg::PathParser<decltype(stage)> parser(stage);
+    const int iterations = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        stage.reset();
+        parser(path.data(), path.size());
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("  %-10s %7.1f MB  %8.1f MB/s  %7.1f ns/command  (%s)%s\n", name,
+                path.size() / 1e6, path.size() * iterations / seconds / 1e6,
+                seconds * 1e9 / receiver.commands, kind, receiver.sum == 42 ? " " : "");
+}
+
+void transforms(const char* name, const std::string& path) {
+    transform(name, path, mapbox::svg::IdentityTransform(), "identity");
+    transform(name, path, mapbox::svg::TranslateTransform{ 5, 7 }, "translate");
+    transform(name, path, mapbox::svg::ScaleTransform{ 2, 2, 5, 7 }, "scale");
+    transform(name, path, mapbox::svg::AffineTransform(1, 0.5, -0.5, 1, 5, 7), "affine");
+}
+
+} // namespace
+
+int main() {
+#if defined(MAPBOX_SVG_AVX2)
+    const char* kernels = "AVX2";
+#elif defined(MAPBOX_SVG_SSE2)
+    const char* kernels = "SSE2";
+#elif defined(MAPBOX_SVG_NEON)
+    const char* kernels = "NEON";
+#else
+    const char* kernels = "scalar";
+#endif
+    std::printf("path_parser (%s kernels)\n", kernels);
+    const std::string traced = tracedPath(200000);
+    const std::string precise = precisePath(200000);
+    run("traced", traced);
+    run("precise", precise);
+    validate("traced", traced);
+    validate("precise", precise);
+    analyze<EndpointReceiver>("traced", traced, "endpoints only");
+    analyze<EndpointReceiver>("precise", precise, "endpoints only");
+    analyze<SubpathReceiver>("traced", traced, "subpaths only");
+    analyze<SubpathReceiver>("precise", precise, "subpaths only");
+    transforms("traced", traced);
+    transforms("precise", precise);
+    return 0;
+}
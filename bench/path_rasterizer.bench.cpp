@@ -0,0 +1,117 @@
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_rasterizer.hpp>
+#include <mapbox/svg/path_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> load(const char* filename) {
+    std::vector<std::string> paths;
+    std::ifstream file(filename);
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            paths.push_back(line);
+        }
+    }
+    return paths;
+}
+
+// Parses the paths into the rasterizer through a transform that fits `box` into the canvas.
+void parse(const std::vector<std::string>& paths,
+           const mapbox::svg::BoundingBox& box,
+           const unsigned size,
+           mapbox::svg::PathRasterizer& rasterizer) {
+    mapbox::svg::ScaleTransform scale;
+    scale.sx = scale.sy = size / std::max(box.maxX - box.minX, box.maxY - box.minY);
+    scale.tx = -box.minX * scale.sx;
+    scale.ty = -box.minY * scale.sy;
+    mapbox::svg::PathFlattener<mapbox::svg::PathRasterizer> flattener(rasterizer, 0.1);
+    mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+    mapbox::svg::PathTransform<decltype(normalizer), mapbox::svg::ScaleTransform> transform(
+        normalizer, scale);
+    mapbox::svg::PathParser<decltype(transform)> parser(transform);
+    for (const std::string& path : paths) {
+        parser(path.c_str());
+        transform.reset();
+        normalizer.reset();
+    }
+}
+
+template <typename Run>
+double measure(Run run) {
+    std::size_t iterations = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        run();
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    return seconds / iterations;
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> icons = load("bench/corpus/icons.txt");
+    if (icons.empty()) {
+        icons.push_back("M12 2a10 10 0 1 1 0 20 10 10 0 1 1 0-20z");
+    }
+    std::printf("path_rasterizer: %zu icons, parsed and rendered one at a time\n", icons.size());
+    const mapbox::svg::BoundingBox iconBox = { 0, 0, 24, 24 };
+    mapbox::svg::RasterOptions options;
+    options.threads = 1;
+    for (const unsigned size : { 24u, 64u, 256u }) {
+        std::vector<uint8_t> alpha(size * size);
+        mapbox::svg::PathRasterizer rasterizer;
+        const double seconds = measure([&] {
+            for (const std::string& icon : icons) {
+                rasterizer.reset();
+                parse({ icon }, iconBox, size, rasterizer);
+                rasterizer.rasterize(options, alpha.data(), size, size, size);
+            }
+        }) / icons.size();
+        std::printf("  %4ux%-4u %10.1f us/icon %10.1f Mpixel/s\n", size, size, seconds * 1e6,
+                    size * size / seconds / 1e6);
+    }
+
+    const std::vector<std::string> outlines = load("bench/corpus/map_outlines.txt");
+    if (outlines.empty()) {
+        return 0;
+    }
+    mapbox::svg::PathBounds bounds;
+    for (const std::string& outline : outlines) {
+        mapbox::svg::PathParser<mapbox::svg::PathBounds> parser(bounds);
+        parser(outline.c_str());
+    }
+    const unsigned size = 4096;
+    mapbox::svg::PathRasterizer rasterizer;
+    const double parsing = measure([&] {
+        rasterizer.reset();
+        parse(outlines, bounds.bounds(), size, rasterizer);
+    });
+    std::printf("path_rasterizer: map outlines as a %ux%u poster, parsed in %.1f ms\n", size, size,
+                parsing * 1e3);
+    std::vector<uint8_t> alpha(std::size_t(size) * size);
+    for (const unsigned tileSize : { 64u, 256u }) {
+        for (const unsigned threads : { 1u, 0u }) {
+            options.tileSize = tileSize;
+            options.threads = threads;
+            const double seconds =
+                measure([&] { rasterizer.rasterize(options, alpha.data(), size, size, size); });
+            std::printf("  tiles of %3u, %-12s %8.1f ms %10.1f Mpixel/s\n", tileSize,
+                        threads ? "1 thread" : "all threads", seconds * 1e3,
+                        double(size) * size / seconds / 1e6);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_simplifier.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CountingReceiver {
+    unsigned long points = 0;
+    double sum = 0;
+
+    void moveTo(double x, double y) {
+        ++points;
+        sum += x + y;
+    }
+
+    void closePath() {
+    }
+
+    void lineTo(double x, double y) {
+        ++points;
+        sum += x + y;
+    }
+};
+
+std::vector<std::string> load(const char* filename) {
+    std::vector<std::string> paths;
+    std::ifstream file(filename);
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            paths.push_back(line);
+        }
+    }
+    return paths;
+}
+
+template <typename Run>
+double measure(Run run) {
+    std::size_t iterations = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        run();
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    return seconds / iterations;
+}
+
+// Parses and flattens every path into `receiver`.
+template <typename Receiver>
+void parse(const std::vector<std::string>& paths, Receiver& receiver) {
+    mapbox::svg::PathFlattener<Receiver> flattener(receiver, 0.25);
+    mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+    mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+    for (const std::string& path : paths) {
+        parser(path.c_str());
+        normalizer.reset();
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> outlines = load("bench/corpus/map_outlines.txt");
+    if (outlines.empty()) {
+        return 0;
+    }
+    // Repeats the corpus into a few megabytes of contours.
+    const std::size_t copies = 8;
+    std::size_t bytes = 0;
+    std::vector<std::string> contours;
+    for (std::size_t i = 0; i < copies; ++i) {
+        for (const std::string& outline : outlines) {
+            contours.push_back(outline);
+            bytes += outline.size();
+        }
+    }
+
+    CountingReceiver flattened;
+    const double baseline = measure([&] {
+        flattened = CountingReceiver();
+        parse(contours, flattened);
+    });
+    std::printf("path_simplifier: %.1f MB of map outlines, %lu points flattened in %.1f ms\n",
+                bytes / 1e6, flattened.points, baseline * 1e3);
+
+    for (const double tolerance : { 0.5, 2.0, 8.0 }) {
+        for (const bool preserveTopology : { false, true }) {
+            CountingReceiver counter;
+            mapbox::svg::PathSimplifier<CountingReceiver> simplifier(counter, tolerance,
+                                                                     preserveTopology);
+            const double seconds = measure([&] {
+                counter = CountingReceiver();
+                simplifier.reset();
+                parse(contours, simplifier);
+                simplifier.finish();
+            });
+            std::printf("  tolerance %4.1f %-10s %9lu points (%5.1f%%) %8.1f ms %6.1f ns/point "
+                        "more than flattening\n",
+                        tolerance, preserveTopology ? "topology" : "", counter.points,
+                        100.0 * counter.points / flattened.points, seconds * 1e3,
+                        (seconds - baseline) / flattened.points * 1e9);
+        }
+    }
+    return 0;
+}
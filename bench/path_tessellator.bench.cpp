@@ -0,0 +1,91 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_tessellator.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> load(const char* filename) {
+    std::vector<std::string> paths;
+    std::ifstream file(filename);
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            paths.push_back(line);
+        }
+    }
+    return paths;
+}
+
+template <typename Run>
+double measure(Run run) {
+    std::size_t iterations = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        run();
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    return seconds / iterations;
+}
+
+struct Totals {
+    std::size_t vertices = 0;
+    std::size_t triangles = 0;
+    std::size_t failures = 0;
+};
+
+// Parses, flattens and tessellates every path on its own into the same buffers.
+Totals tessellate(const std::vector<std::string>& paths,
+                  const double tolerance,
+                  mapbox::svg::PathTessellator& tessellator) {
+    Totals totals;
+    mapbox::svg::PathFlattener<mapbox::svg::PathTessellator> flattener(tessellator, tolerance);
+    mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+    mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+    for (const std::string& path : paths) {
+        tessellator.reset();
+        normalizer.reset();
+        parser(path.c_str());
+        totals.failures += !tessellator.tessellate(mapbox::svg::FillRule::NonZero);
+        totals.vertices += tessellator.vertexCount();
+        totals.triangles += tessellator.indexCount() / 3;
+    }
+    return totals;
+}
+
+void run(const char* name, const std::vector<std::string>& paths, const double tolerance) {
+    const std::size_t capacity = 1 << 20;
+    std::vector<float> vertices(2 * capacity);
+    std::vector<uint32_t> indices(3 * 2 * capacity);
+    mapbox::svg::PathTessellator tessellator(vertices.data(), capacity, indices.data(),
+                                             indices.size());
+    Totals totals;
+    const double seconds = measure([&] { totals = tessellate(paths, tolerance, tessellator); });
+    std::printf("path_tessellator: %-14s %6zu paths %9zu vertices %9zu triangles %zu failed\n",
+                name, paths.size(), totals.vertices, totals.triangles, totals.failures);
+    std::printf("  %10.1f us/path %10.0f paths/s %8.1f ns/vertex\n", seconds / paths.size() * 1e6,
+                paths.size() / seconds, seconds / totals.vertices * 1e9);
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> icons = load("bench/corpus/icons.txt");
+    if (icons.empty()) {
+        icons.push_back("M12 2a10 10 0 1 1 0 20 10 10 0 1 1 0-20z");
+    }
+    run("icons", icons, 0.05);
+
+    const std::vector<std::string> outlines = load("bench/corpus/map_outlines.txt");
+    if (!outlines.empty()) {
+        run("map outlines", outlines, 0.05);
+    }
+    return 0;
+}
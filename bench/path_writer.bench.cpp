@@ -0,0 +1,144 @@
+#include <mapbox/svg/path_writer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// VertexReceiver that writes every command with its letter and absolute coordinates, the way
+// paths were written with streams.
+class StreamWriter {
+public:
+    StreamWriter(std::ostringstream& out_) : out(out_) {
+    }
+
+    void moveTo(double x, double y, bool) {
+        out << 'M' << x << ' ' << y;
+    }
+    void lineTo(double x, double y, bool) {
+        out << 'L' << x << ' ' << y;
+    }
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool) {
+        out << 'C' << x1 << ' ' << y1 << ' ' << x2 << ' ' << y2 << ' ' << x << ' ' << y;
+    }
+    void arc(double rx,
+             double ry,
+             double rotation,
+             bool large,
+             bool sweep,
+             double x,
+             double y,
+             bool) {
+        out << 'A' << rx << ' ' << ry << ' ' << rotation << ' ' << large << ' ' << sweep << ' '
+            << x << ' ' << y;
+    }
+    void closePath() {
+        out << 'Z';
+    }
+
+private:
+    std::ostringstream& out;
+};
+
+// A line, cubic or arc to the last point, with arcs taking their radii from the first point.
+struct Segment {
+    int type;
+    double x1, y1, x2, y2, x, y;
+};
+
+const std::size_t pathLength = 16;
+const int repetitions = 20;
+
+template <typename Receiver>
+void replay(Receiver& receiver, const std::vector<Segment>& segments, const std::size_t i) {
+    receiver.moveTo(segments[i].x, segments[i].y, false);
+    for (std::size_t k = i + 1; k < i + pathLength; ++k) {
+        const Segment& s = segments[k];
+        switch (s.type) {
+            case 0: receiver.lineTo(s.x, s.y, false); break;
+            case 1: receiver.curveTo(s.x1, s.y1, s.x2, s.y2, s.x, s.y, false); break;
+            default: receiver.arc(s.x1, s.y1, 0, s.x2 > s.y2, s.x2 > s.x, s.x, s.y, false); break;
+        }
+    }
+    receiver.closePath();
+}
+
+template <typename Run>
+double measure(const char* name, const std::size_t paths, Run run) {
+    std::size_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        bytes = run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("  %-32s %8.1f ns/path %8.1f bytes/path\n", name, ns / paths / repetitions,
+                double(bytes) / paths);
+    return ns;
+}
+
+void compare(const char* name, const std::vector<Segment>& segments, const int precision) {
+    const std::size_t paths = segments.size() / pathLength;
+    std::printf("%s\n", name);
+
+    std::string d;
+    mapbox::svg::PathWriter writer(d, precision);
+    const double writerTime = measure("PathWriter", paths, [&] {
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < segments.size(); i += pathLength) {
+            d.clear();
+            writer.reset();
+            replay(writer, segments, i);
+            bytes += d.size();
+        }
+        return bytes;
+    });
+
+    std::ostringstream stream;
+    if (precision < 0) {
+        stream << std::setprecision(17);
+    } else {
+        stream << std::fixed << std::setprecision(precision);
+    }
+    StreamWriter streamWriter(stream);
+    const double streamTime = measure("ostringstream", paths, [&] {
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < segments.size(); i += pathLength) {
+            stream.str(std::string());
+            replay(streamWriter, segments, i);
+            bytes += stream.str().size();
+        }
+        return bytes;
+    });
+    std::printf("  speedup %.1fx\n", streamTime / writerTime);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> type(0, 2);
+    std::uniform_int_distribution<int> grid(0, 4096);
+    std::uniform_real_distribution<double> coordinate(0, 512);
+
+    std::vector<Segment> tile(1024 * pathLength), transformed(tile.size());
+    for (std::size_t i = 0; i < tile.size(); ++i) {
+        const int t = type(random);
+        tile[i] = { t, 1.0 * grid(random), 1.0 * grid(random), 1.0 * grid(random),
+                    1.0 * grid(random), 1.0 * grid(random), 1.0 * grid(random) };
+        transformed[i] = { t, coordinate(random), coordinate(random), coordinate(random),
+                           coordinate(random), coordinate(random), coordinate(random) };
+    }
+
+    std::printf("path_writer: %zu paths of %zu lines, cubics or arcs\n", tile.size() / pathLength,
+                pathLength);
+    compare("integer coordinates, shortest round trip", tile, -1);
+    compare("transformed coordinates, shortest round trip", transformed, -1);
+    compare("transformed coordinates, 3 decimals", transformed, 3);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+// Hardware counters for the benchmarks, read through perf_event_open on Linux. Elsewhere, or when
+// the kernel doesn't allow it (see /proc/sys/kernel/perf_event_paranoid), `open()` returns false
+// and the benchmarks only report times.
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounters {
+public:
+    enum Counter { Cycles, Instructions, BranchMisses, CacheMisses, Count };
+
+    PerfCounters() {
+        for (int& fd : fds) {
+            fd = -1;
+        }
+    }
+    PerfCounters(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const int fd : fds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    // Opens the counters for the calling thread. Returns false if none are available.
+    bool open() {
+#if defined(__linux__)
+        static const uint64_t configs[Count] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES,
+            PERF_COUNT_HW_CACHE_MISSES,
+        };
+        bool any = false;
+        for (int i = 0; i < Count; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            any = any || fds[i] != -1;
+        }
+        return any;
+#else
+        return false;
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        for (const int fd : fds) {
+            if (fd != -1) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop() {
+#if defined(__linux__)
+        for (int i = 0; i < Count; ++i) {
+            values[i] = 0;
+            if (fds[i] != -1) {
+                ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t value;
+                if (read(fds[i], &value, sizeof(value)) == sizeof(value)) {
+                    values[i] = value;
+                }
+            }
+        }
+#endif
+    }
+
+    bool has(const Counter counter) const {
+        return fds[counter] != -1;
+    }
+
+    // The count between the last start() and stop().
+    uint64_t operator[](const Counter counter) const {
+        return values[counter];
+    }
+
+private:
+    int fds[Count];
+    uint64_t values[Count] = {};
+};
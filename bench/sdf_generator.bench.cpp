@@ -0,0 +1,137 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_transform.hpp>
+#include <mapbox/svg/sdf_generator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Reference: the winding number and the distance from every segment, for every pixel.
+struct BruteForceGenerator {
+    std::vector<mapbox::svg::detail::SdfSegment> segments;
+    double x = 0, y = 0, startX = 0, startY = 0;
+
+    void moveTo(double x_, double y_) {
+        closePath();
+        x = startX = x_;
+        y = startY = y_;
+    }
+
+    void closePath() {
+        if (x != startX || y != startY) {
+            segments.push_back(mapbox::svg::detail::makeSdfSegment(x, y, startX, startY));
+        }
+        x = startX;
+        y = startY;
+    }
+
+    void lineTo(double x_, double y_) {
+        segments.push_back(mapbox::svg::detail::makeSdfSegment(x, y, x_, y_));
+        x = x_;
+        y = y_;
+    }
+
+    void generate(const mapbox::svg::SdfOptions& options, std::vector<uint8_t>& field) {
+        closePath();
+        const std::size_t width = options.width + 2 * options.buffer;
+        const std::size_t height = options.height + 2 * options.buffer;
+        field.resize(width * height);
+        for (std::size_t row = 0; row < height; ++row) {
+            for (std::size_t column = 0; column < width; ++column) {
+                const double px = column + 0.5 - options.buffer;
+                const double py = row + 0.5 - options.buffer;
+                int winding = 0;
+                double best = INFINITY;
+                for (const auto& e : segments) {
+                    if (std::min(e.y0, e.y1) <= py && py < std::max(e.y0, e.y1) &&
+                        e.x0 + (py - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0) < px) {
+                        winding += e.y1 > e.y0 ? 1 : -1;
+                    }
+                    best = std::min(best, mapbox::svg::detail::segmentDistanceSquared(e, px, py));
+                }
+                const double distance = mapbox::svg::isInside(options.fillRule, winding)
+                                            ? -std::sqrt(best)
+                                            : std::sqrt(best);
+                const double value =
+                    std::floor(255 - 255 * (distance / options.radius + options.cutoff) + 0.5);
+                field[row * width + column] = uint8_t(std::min(255.0, std::max(0.0, value)));
+            }
+        }
+    }
+};
+
+// Parses every icon at the size of the options, then times the fields alone.
+template <typename Generator>
+void measure(const char* name,
+             const std::vector<std::string>& icons,
+             const mapbox::svg::SdfOptions& options,
+             const double baseline,
+             double& seconds) {
+    std::vector<std::vector<uint8_t>> fields(icons.size());
+    std::size_t iterations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        for (std::size_t i = 0; i < icons.size(); ++i) {
+            Generator generator;
+            mapbox::svg::ScaleTransform scale;
+            scale.sx = scale.sy = options.width / 24.0;
+            mapbox::svg::PathFlattener<Generator> flattener(generator, 0.1);
+            mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+            mapbox::svg::PathTransform<decltype(normalizer), mapbox::svg::ScaleTransform> transform(
+                normalizer, scale);
+            mapbox::svg::PathParser<decltype(transform)> parser(transform);
+            parser(icons[i].c_str());
+            generator.generate(options, fields[i]);
+        }
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    seconds /= iterations * icons.size();
+    std::printf("  %-26s %10.1f us/icon", name, seconds * 1e6);
+    if (baseline > 0) {
+        std::printf("  %6.1fx", baseline / seconds);
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::string> icons;
+    std::ifstream file("bench/corpus/icons.txt");
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            icons.push_back(line);
+        }
+    }
+    if (icons.empty()) {
+        icons.push_back("M12 2a10 10 0 1 1 0 20 10 10 0 1 1 0-20z");
+    }
+    std::printf("sdf_generator: %zu icons\n", icons.size());
+
+    for (const unsigned size : { 24u, 96u }) {
+        mapbox::svg::SdfOptions options;
+        options.width = options.height = size;
+        options.buffer = size / 8;
+        options.radius = size / 3.0;
+        std::printf(" %ux%u, buffer %u, radius %.0f\n", size, size, options.buffer,
+                    options.radius);
+
+        double bruteForce = 0, seconds = 0;
+        measure<BruteForceGenerator>("brute force", icons, options, 0, bruteForce);
+        options.threads = 1;
+        measure<mapbox::svg::SdfGenerator>("SdfGenerator, 1 thread", icons, options, bruteForce,
+                                           seconds);
+        options.threads = 0;
+        measure<mapbox::svg::SdfGenerator>("SdfGenerator", icons, options, bruteForce, seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <mapbox/svg/mapped_file.hpp>
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/svg_reader.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+
+// A sprite source: icons in groups with transforms, mostly paths with some basic shapes, and the
+// usual editor clutter around them.
+std::string makeDocument(const int icons) {
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> coordinate(0, 2400);
+    const auto number = [&] { return std::to_string(coordinate(random) / 100.0).substr(0, 5); };
+
+    std::string document = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg "
+                           "xmlns=\"http://www.w3.org/2000/svg\" width=\"960\" height=\"960\">\n";
+    for (int i = 0; i < icons; ++i) {
+        document += "  <!-- icon " + std::to_string(i) + " -->\n";
+        document += "  <g id=\"icon-" + std::to_string(i) + "\" transform=\"translate(" +
+                    std::to_string(i % 40 * 24) + " " + std::to_string(i / 40 * 24) + ")\">\n";
+        document += "    <title>icon</title>\n    <path fill=\"#333\" d=\"M" + number() + " " +
+                    number();
+        for (int k = 0; k < 12; ++k) {
+            document += (k % 3 == 0 ? " C" : " L") + number() + " " + number();
+            if (k % 3 == 0) {
+                document += " " + number() + " " + number() + " " + number() + " " + number();
+            }
+        }
+        document += "Z\"/>\n";
+        if (i % 3 == 0) {
+            document += "    <rect x=\"2\" y=\"2\" width=\"20\" height=\"20\" rx=\"4\" "
+                        "fill=\"none\" stroke=\"#333\"/>\n";
+        }
+        if (i % 5 == 0) {
+            document += "    <circle cx=\"12\" cy=\"12\" r=\"3\"/>\n";
+        }
+        document += "  </g>\n";
+    }
+    return document + "</svg>\n";
+}
+
+template <typename Run>
+void measure(const char* name, const std::size_t bytes, Run run) {
+    std::size_t iterations = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        run();
+        ++iterations;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < 0.25);
+    std::printf("  %-24s %8.1f MB/s\n", name, bytes * iterations / seconds / 1e6);
+}
+
+} // namespace
+
+int main() {
+    const std::string document = makeDocument(1600);
+    const char* filename = "bench-svg_reader.svg";
+    std::FILE* file = std::fopen(filename, "wb");
+    if (!file) {
+        return 1;
+    }
+    std::fwrite(document.data(), 1, document.size(), file);
+    std::fclose(file);
+
+    mapbox::svg::MappedFile mapped;
+    if (!mapped.open(filename)) {
+        return 1;
+    }
+    std::printf("svg_reader: synthetic sprite source, %.1f kB\n", mapped.size() / 1e3);
+
+    std::size_t tags = 0;
+    measure("SvgTokenizer", mapped.size(), [&] {
+        mapbox::svg::SvgTokenizer tokenizer(mapped.data(), mapped.size());
+        mapbox::svg::SvgTag tag;
+        while (tokenizer.next(tag)) {
+            ++tags;
+        }
+    });
+
+    std::size_t shapes = 0;
+    measure("SvgReader", mapped.size(), [&] {
+        mapbox::svg::SvgReader reader(mapped.data(), mapped.size());
+        mapbox::svg::SvgShape shape;
+        while (reader.next(shape)) {
+            ++shapes;
+        }
+    });
+
+    mapbox::svg::PathBounds bounds;
+    measure("SvgReader + PathBounds", mapped.size(), [&] {
+        bounds.reset();
+        mapbox::svg::SvgReader reader(mapped.data(), mapped.size());
+        mapbox::svg::SvgShape shape;
+        while (reader.next(shape)) {
+            shape.drawTransformed(bounds);
+        }
+    });
+
+    mapped.close();
+    std::remove(filename);
+    if (tags == 42 && shapes == 42 && bounds.bounds().maxX == 42) {
+        std::printf(" ");
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_slice.hpp>
+#include <mapbox/svg/worker_threads.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+struct PathParseResult {
+    bool success;
+    PathParseErrorType error;
+    std::ptrdiff_t errorOffset;
+};
+
+// Parses many paths on several threads. Every worker creates one receiver with `makeReceiver()`
+// and one PathParser bound to it, and reuses both for all of its paths. After each path,
+// `onParsed(index, receiver, result)` is called on the worker's thread, e.g. to move the output
+// out of the receiver and reset it.
+//
+// Usage:
+//
+// std::vector<mapbox::svg::PathSlice> paths = ...;
+// auto results = mapbox::svg::parseBatch(paths.data(), paths.size(),
+//     [] { return mapbox::svg::PathBuffer(); },
+//     [&](std::size_t i, mapbox::svg::PathBuffer& buffer, const mapbox::svg::PathParseResult&) {
+//         buffers[i] = buffer;
+//         buffer.clear();
+//     });
+//
+// The paths are split into one contiguous range per worker. A worker that runs out of work
+// steals small blocks from the front of the other workers' ranges, so uneven path sizes don't
+// leave threads idle. Results are returned in input order.
+//
+// If `makeReceiver` or `onParsed` throws, the other workers finish their paths, and the first
+// exception is rethrown to the caller once all threads are joined.
+
+namespace detail {
+
+// A range of path indices that its owner and thieves consume from the front. Padded so that two
+// workers' counters don't share a cache line.
+struct WorkRange {
+    std::atomic<std::size_t> next;
+    std::size_t end;
+    char padding[64 - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+};
+
+} // namespace detail
+
+template <typename MakeReceiver, typename OnParsed>
+std::vector<PathParseResult> parseBatch(const PathSlice* paths,
+                                        std::size_t count,
+                                        MakeReceiver makeReceiver,
+                                        OnParsed onParsed,
+                                        unsigned threads = 0) {
+    std::vector<PathParseResult> results(count);
+    if (count == 0) {
+        return results;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = unsigned(std::min<std::size_t>(threads, count));
+
+    // Paths are claimed in small blocks to keep the atomic traffic down.
+    const std::size_t blockSize =
+        std::max<std::size_t>(1, std::min<std::size_t>(64, count / (threads * 16)));
+
+    std::unique_ptr<detail::WorkRange[]> ranges(new detail::WorkRange[threads]);
+    for (unsigned i = 0; i < threads; ++i) {
+        ranges[i].next = count * i / threads;
+        ranges[i].end = count * (i + 1) / threads;
+    }
+
+    auto work = [&](const unsigned self) {
+        auto receiver = makeReceiver();
+        PathParser<decltype(receiver)> parser(receiver);
+        for (unsigned k = 0; k < threads; ++k) {
+            // Start with the worker's own range, then visit the others.
+            detail::WorkRange& range = ranges[(self + k) % threads];
+            while (true) {
+                const std::size_t first =
+                    range.next.fetch_add(blockSize, std::memory_order_relaxed);
+                if (first >= range.end) {
+                    break;
+                }
+                const std::size_t last = std::min(first + blockSize, range.end);
+                for (std::size_t i = first; i < last; ++i) {
+                    PathParseResult& result = results[i];
+                    result.success = parser(paths[i].data, paths[i].size);
+                    result.error = parser.errorType();
+                    result.errorOffset = result.success ? 0 : parser.errorOffset();
+                    onParsed(i, receiver, static_cast<const PathParseResult&>(result));
+                }
+            }
+        }
+    };
+
+    detail::runOnThreads(threads, work);
+    return results;
+}
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Vector kernels are picked at compile time from the target's instruction set. Define
+// MAPBOX_SVG_NO_SIMD to force the portable scalar versions.
+#if !defined(MAPBOX_SVG_NO_SIMD)
+#if defined(__AVX2__)
+#define MAPBOX_SVG_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAPBOX_SVG_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MAPBOX_SVG_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(MAPBOX_SVG_AVX2) || defined(MAPBOX_SVG_SSE2) || defined(MAPBOX_SVG_NEON)
+#define MAPBOX_SVG_VECTOR 1
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define MAPBOX_SVG_LITTLE_ENDIAN 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define MAPBOX_SVG_LITTLE_ENDIAN 1
+#endif
+
+namespace mapbox {
+namespace svg {
+namespace detail {
+
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isNumberStart(const char c) {
+    return isDigit(c) || c == '.' || c == '-' || c == '+';
+}
+
+inline unsigned countTrailingZeros(const uint32_t mask) {
+#if defined(__GNUC__)
+    return unsigned(__builtin_ctz(mask));
+#else
+    unsigned count = 0;
+    for (uint32_t m = mask; !(m & 1); m >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+#if defined(MAPBOX_SVG_NEON)
+// One bit per byte of a comparison result, like _mm_movemask_epi8.
+inline uint32_t movemask16(const uint8x16_t bytes) {
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bits = vandq_u8(bytes, vld1q_u8(weights));
+    return uint32_t(vaddv_u8(vget_low_u8(bits))) | uint32_t(vaddv_u8(vget_high_u8(bits))) << 8;
+}
+#endif
+
+// Bit i is set if p[i] is a decimal digit. All 16 bytes at `p` must be readable.
+inline uint32_t digitMask16(const char* p) {
+#if defined(MAPBOX_SVG_AVX2) || defined(MAPBOX_SVG_SSE2)
+    // Shift '0'..'9' to the bottom of the signed range so that one comparison finds them.
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i shifted = _mm_add_epi8(bytes, _mm_set1_epi8(char(0x80 - '0')));
+    const __m128i digits = _mm_cmplt_epi8(shifted, _mm_set1_epi8(char(0x80 + 10)));
+    return uint32_t(_mm_movemask_epi8(digits));
+#elif defined(MAPBOX_SVG_NEON)
+    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    return movemask16(vcltq_u8(vsubq_u8(bytes, vdupq_n_u8('0')), vdupq_n_u8(10)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+        mask |= uint32_t(isDigit(p[i])) << i;
+    }
+    return mask;
+#endif
+}
+
+// Returns the first character at or after `p` that isn't whitespace.
+inline const char* skipWhitespace(const char* p, const char* const last) {
+#if defined(MAPBOX_SVG_AVX2)
+    while (last - p >= 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')),
+                            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))));
+        const uint32_t mask = ~uint32_t(_mm256_movemask_epi8(whitespace));
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 32;
+    }
+#elif defined(MAPBOX_SVG_SSE2)
+    while (last - p >= 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                      _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+                         _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')),
+                                      _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))));
+        const uint32_t mask = ~uint32_t(_mm_movemask_epi8(whitespace)) & 0xFFFFu;
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 16;
+    }
+#elif defined(MAPBOX_SVG_NEON)
+    while (last - p >= 16) {
+        const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t whitespace =
+            vorrq_u8(vorrq_u8(vceqq_u8(bytes, vdupq_n_u8(' ')), vceqq_u8(bytes, vdupq_n_u8('\t'))),
+                     vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('\n')),
+                              vceqq_u8(bytes, vdupq_n_u8('\r'))));
+        const uint32_t mask = ~movemask16(whitespace) & 0xFFFFu;
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p != last && isWhitespace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+#if defined(MAPBOX_SVG_LITTLE_ENDIAN)
+// SWAR: combines the eight digit values in the bytes of `value`, first byte most significant, by
+// merging neighbouring digits, then pairs, then quads.
+inline uint64_t combineDigits8(uint64_t value) {
+    value = ((value & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    value = ((value & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return ((value & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+}
+#endif
+
+// Value of the `count` (at most 8) decimal digits at `p`. All 8 bytes at `p` must be readable.
+inline uint64_t parseDigits8(const char* p, const unsigned count) {
+#if defined(MAPBOX_SVG_LITTLE_ENDIAN)
+    if (count == 0) {
+        return 0;
+    }
+    // Move the digits to the top of the word, so that the missing leading ones read as zero.
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    value -= 0x3030303030303030ull;
+    return combineDigits8(value << 8 * (8 - count));
+#else
+    uint64_t value = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        value = value * 10 + uint64_t(p[i] - '0');
+    }
+    return value;
+#endif
+}
+
+// Value of the `count` (at most 8) decimal digits that end at `end`. All 8 bytes before `end` must
+// be readable.
+inline uint64_t parseDigits8Before(const char* end, const unsigned count) {
+#if defined(MAPBOX_SVG_LITTLE_ENDIAN)
+    if (count == 0) {
+        return 0;
+    }
+    // The digits are already at the top of the word. Clear whatever precedes them before
+    // subtracting, so that no byte borrows from a digit.
+    const uint64_t keep = ~uint64_t(0) << 8 * (8 - count);
+    uint64_t value;
+    std::memcpy(&value, end - 8, sizeof(value));
+    return combineDigits8((value & keep) - (0x3030303030303030ull & keep));
+#else
+    return parseDigits8(end - count, count);
+#endif
+}
+
+} // namespace detail
+} // namespace svg
+} // namespace mapbox
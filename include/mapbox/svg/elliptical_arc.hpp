@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cmath>
+
+namespace mapbox {
+namespace svg {
+
+// Center parameterization of an SVG elliptical arc: the points
+//
+//     x = cx + rx * cos(theta) * cosPhi - ry * sin(theta) * sinPhi
+//     y = cy + rx * cos(theta) * sinPhi + ry * sin(theta) * cosPhi
+//
+// for theta from theta1 to theta1 + deltaTheta.
+struct EllipticalArc {
+    double cx, cy;
+    double rx, ry;
+    double cosPhi, sinPhi;
+    double theta1, deltaTheta;
+
+    double pointX(const double theta) const {
+        return cx + rx * std::cos(theta) * cosPhi - ry * std::sin(theta) * sinPhi;
+    }
+
+    double pointY(const double theta) const {
+        return cy + rx * std::cos(theta) * sinPhi + ry * std::sin(theta) * cosPhi;
+    }
+
+    // Converts the endpoint parameterization used by the `A` command, following
+    // https://www.w3.org/TR/SVG11/implnote.html#ArcConversionEndpointToCenter. Radii that are too
+    // small to reach the end point are scaled up. Returns false if the arc is a straight line (a
+    // radius is zero), or is omitted altogether (the end points coincide).
+    static bool fromEndpoints(double x1,
+                              double y1,
+                              double rx,
+                              double ry,
+                              double xAxisRotation,
+                              bool largeArcFlag,
+                              bool sweepFlag,
+                              double x2,
+                              double y2,
+                              EllipticalArc& arc) {
+        if (!centerFromEndpoints(x1, y1, rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x2, y2,
+                                 arc)) {
+            return false;
+        }
+
+        // The end points relative to the center, in the frame of the ellipse axes.
+        const double u1 = (arc.cosPhi * (x1 - arc.cx) + arc.sinPhi * (y1 - arc.cy)) / arc.rx;
+        const double v1 = (-arc.sinPhi * (x1 - arc.cx) + arc.cosPhi * (y1 - arc.cy)) / arc.ry;
+        const double u2 = (arc.cosPhi * (x2 - arc.cx) + arc.sinPhi * (y2 - arc.cy)) / arc.rx;
+        const double v2 = (-arc.sinPhi * (x2 - arc.cx) + arc.cosPhi * (y2 - arc.cy)) / arc.ry;
+
+        const double pi = 3.14159265358979323846;
+        arc.theta1 = std::atan2(v1, u1);
+        double deltaTheta = std::atan2(v2, u2) - arc.theta1;
+        if (sweepFlag && deltaTheta < 0) {
+            deltaTheta += 2 * pi;
+        } else if (!sweepFlag && deltaTheta > 0) {
+            deltaTheta -= 2 * pi;
+        }
+        arc.deltaTheta = deltaTheta;
+        return true;
+    }
+
+    // Like fromEndpoints, but only sets the center, the radii and the rotation, which is enough
+    // when the angles aren't needed. The arc runs in the direction of increasing theta if
+    // `sweepFlag` is set.
+    static bool centerFromEndpoints(double x1,
+                                    double y1,
+                                    double rx,
+                                    double ry,
+                                    double xAxisRotation,
+                                    bool largeArcFlag,
+                                    bool sweepFlag,
+                                    double x2,
+                                    double y2,
+                                    EllipticalArc& arc) {
+        if ((x1 == x2 && y1 == y2) || rx == 0 || ry == 0) {
+            return false;
+        }
+        rx = std::abs(rx);
+        ry = std::abs(ry);
+
+        // Most arcs aren't rotated, which saves the trigonometry.
+        if (xAxisRotation == 0) {
+            arc.cosPhi = 1;
+            arc.sinPhi = 0;
+        } else {
+            const double pi = 3.14159265358979323846;
+            const double phi = std::fmod(xAxisRotation, 360.0) * pi / 180;
+            arc.cosPhi = std::cos(phi);
+            arc.sinPhi = std::sin(phi);
+        }
+
+        const double dx = (x1 - x2) / 2;
+        const double dy = (y1 - y2) / 2;
+        const double x1p = arc.cosPhi * dx + arc.sinPhi * dy;
+        const double y1p = -arc.sinPhi * dx + arc.cosPhi * dy;
+
+        const double lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+        if (lambda > 1) {
+            const double scale = std::sqrt(lambda);
+            rx *= scale;
+            ry *= scale;
+        }
+
+        const double rxy = rx * rx * y1p * y1p;
+        const double ryx = ry * ry * x1p * x1p;
+        const double numerator = rx * rx * ry * ry - rxy - ryx;
+        double coefficient = numerator > 0 ? std::sqrt(numerator / (rxy + ryx)) : 0;
+        if (largeArcFlag == sweepFlag) {
+            coefficient = -coefficient;
+        }
+        const double cxp = coefficient * rx * y1p / ry;
+        const double cyp = -coefficient * ry * x1p / rx;
+
+        arc.cx = arc.cosPhi * cxp - arc.sinPhi * cyp + (x1 + x2) / 2;
+        arc.cy = arc.sinPhi * cxp + arc.cosPhi * cyp + (y1 + y2) / 2;
+        arc.rx = rx;
+        arc.ry = ry;
+        return true;
+    }
+};
+
+} // namespace svg
+} // namespace mapbox
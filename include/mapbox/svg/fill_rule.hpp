@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mapbox {
+namespace svg {
+
+// How the winding number of a point decides whether it is inside a filled path, as for the SVG
+// `fill-rule` property.
+enum class FillRule : uint8_t {
+    NonZero,
+    EvenOdd,
+};
+
+inline bool isInside(const FillRule rule, const int winding) {
+    return rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+}
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <mapbox/svg/number_parser.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace mapbox {
+namespace svg {
+
+// A signed fixed-point number with `FractionBits` fractional bits, stored as a scaled integer:
+// the value is `raw / 2^FractionBits`. Used as a PathParser coordinate type, numbers are
+// converted from their decimal digits straight to the scaled integer, without going through
+// floating point.
+//
+// Usage:
+//
+// using Fixed = mapbox::svg::FixedPoint<8>;
+// mapbox::svg::PathParser<VertexReceiver, Fixed> parser(receiver);
+// parser("M6,12.5"); // receiver.moveTo(Fixed::fromRaw(1536), Fixed::fromRaw(3200), false)
+//
+// Numbers are rounded to the nearest representable value, ties away from zero. Numbers outside
+// the range of `Integer` are reported as NumberParsing errors.
+
+template <int FractionBits, typename Integer = int32_t>
+struct FixedPoint {
+    static_assert(std::is_integral<Integer>::value && std::is_signed<Integer>::value,
+                  "FixedPoint needs a signed integer type");
+    static_assert(sizeof(Integer) <= 4, "FixedPoint supports at most 32-bit storage");
+    static_assert(FractionBits >= 0 && FractionBits < int(sizeof(Integer) * 8),
+                  "FixedPoint needs at least one integer bit");
+
+    using integer_type = Integer;
+    static constexpr int fractionBits = FractionBits;
+
+    Integer raw;
+
+    static FixedPoint fromRaw(const Integer raw_) {
+        FixedPoint result;
+        result.raw = raw_;
+        return result;
+    }
+
+    double toDouble() const {
+        return double(raw) / double(uint64_t(1) << FractionBits);
+    }
+
+    bool operator==(const FixedPoint& other) const {
+        return raw == other.raw;
+    }
+
+    bool operator!=(const FixedPoint& other) const {
+        return raw != other.raw;
+    }
+};
+
+template <int FractionBits, typename Integer>
+constexpr int FixedPoint<FractionBits, Integer>::fractionBits;
+
+namespace detail {
+
+// Just enough 192-bit unsigned arithmetic for the conversion, in 32-bit limbs so that it doesn't
+// depend on compiler extensions.
+class Wide {
+public:
+    explicit Wide(const uint64_t value)
+        : limbs{ uint32_t(value), uint32_t(value >> 32), 0, 0, 0, 0 } {
+    }
+
+    // Returns false if the result doesn't fit.
+    bool multiply(const uint32_t factor) {
+        uint64_t carry = 0;
+        for (uint32_t& limb : limbs) {
+            carry += uint64_t(limb) * factor;
+            limb = uint32_t(carry);
+            carry >>= 32;
+        }
+        return carry == 0;
+    }
+
+    void add(const uint32_t term) {
+        uint64_t carry = term;
+        for (uint32_t& limb : limbs) {
+            carry += limb;
+            limb = uint32_t(carry);
+            carry >>= 32;
+        }
+    }
+
+    // Divides in place, rounding down.
+    void divide(const uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (int i = size - 1; i >= 0; --i) {
+            remainder = remainder << 32 | limbs[i];
+            limbs[i] = uint32_t(remainder / divisor);
+            remainder %= divisor;
+        }
+    }
+
+    bool isZero() const {
+        uint32_t bits = 0;
+        for (const uint32_t limb : limbs) {
+            bits |= limb;
+        }
+        return bits == 0;
+    }
+
+    // Returns false if the value doesn't fit in 64 bits.
+    bool toUint64(uint64_t& value) const {
+        value = uint64_t(limbs[1]) << 32 | limbs[0];
+        uint32_t high = 0;
+        for (int i = 2; i < size; ++i) {
+            high |= limbs[i];
+        }
+        return high == 0;
+    }
+
+private:
+    static constexpr int size = 6;
+    uint32_t limbs[size];
+};
+
+// Reads the digits of a number whose mantissa was truncated. Every rounding boundary is a multiple
+// of 2^-32, and so of 10^-32: the digits down to that place are kept exactly, and any nonzero
+// digits past it become a 1 in the place below, which lies between the same two boundaries.
+// Returns false if the number is too large for `value`.
+inline bool readDigits(const DecimalNumber& number, Wide& value, int64_t& power) {
+    static constexpr int64_t lastPlace = -32;
+    int64_t place = number.digitsExponent - 1;
+    for (const char* cursor = number.digitsBegin; cursor != number.digitsEnd; ++cursor) {
+        place += *cursor != '.';
+    }
+    value = Wide(0);
+    power = lastPlace;
+    bool sticky = false;
+    for (const char* cursor = number.digitsBegin; cursor != number.digitsEnd; ++cursor) {
+        if (*cursor == '.') {
+            continue;
+        }
+        const uint32_t digit = uint32_t(*cursor - '0');
+        if (place >= lastPlace) {
+            if (!value.multiply(10)) {
+                return false;
+            }
+            value.add(digit);
+            power = place;
+        } else {
+            sticky = sticky || digit != 0;
+        }
+        --place;
+    }
+    if (sticky) {
+        if (!value.multiply(10)) {
+            return false;
+        }
+        value.add(1);
+        --power;
+    }
+    return true;
+}
+
+// Rounds a scanned number to a multiple of 2^-fractionBits and returns the scaled magnitude, or
+// false if it is larger than `max`.
+inline bool decimalToScaled(const DecimalNumber& number,
+                            const int fractionBits,
+                            const uint64_t max,
+                            uint64_t& result) {
+    Wide value(number.mantissa);
+    int64_t power = number.power;
+    if (number.truncated && !readDigits(number, value, power)) {
+        return false;
+    }
+    // Twice the scaled value, so that the last bit of the integer part decides the rounding.
+    if (!value.multiply(uint32_t(1) << (fractionBits / 2)) ||
+        !value.multiply(uint32_t(1) << (fractionBits - fractionBits / 2)) || !value.multiply(2)) {
+        return false;
+    }
+
+    for (; power > 0 && !value.isZero(); --power) {
+        if (!value.multiply(10)) {
+            return false;
+        }
+        uint64_t check;
+        if (!value.toUint64(check) || check / 2 > max) {
+            return false;
+        }
+    }
+    for (; power < 0 && !value.isZero(); power += 9) {
+        value.divide(power <= -9 ? 1000000000u : uint32_t(integerPowerOfTen(unsigned(-power))));
+    }
+
+    uint64_t twice;
+    if (!value.toUint64(twice)) {
+        return false;
+    }
+    result = twice / 2 + (twice & 1);
+    return result <= max;
+}
+
+// Scans a number (see scanNumber) into a fixed-point value. Returns `first` if there is no number
+// or it is out of range.
+template <int FractionBits, typename Integer>
+const char* parseNumber(const char* first,
+                        const char* last,
+                        FixedPoint<FractionBits, Integer>& value) {
+    DecimalNumber number;
+    const char* next = scanNumber(first, last, number);
+    if (next == first) {
+        return first;
+    }
+    // The most negative value has no positive counterpart.
+    const uint64_t max = uint64_t(std::numeric_limits<Integer>::max()) + number.negative;
+    uint64_t magnitude;
+    if (!decimalToScaled(number, FractionBits, max, magnitude)) {
+        return first;
+    }
+    value.raw = Integer(number.negative ? -int64_t(magnitude) : int64_t(magnitude));
+    return next;
+}
+
+// Out of range numbers are already rejected by parseNumber.
+template <int FractionBits, typename Integer>
+struct CoordinateTraits<FixedPoint<FractionBits, Integer>> {
+    static const char* parse(const char* first,
+                             const char* last,
+                             FixedPoint<FractionBits, Integer>& value) {
+        return parseNumber(first, last, value);
+    }
+
+    static bool isOverflow(const FixedPoint<FractionBits, Integer>&) {
+        return false;
+    }
+};
+
+} // namespace detail
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPBOX_SVG_MMAP
+#endif
+
+namespace mapbox {
+namespace svg {
+
+// A read-only view of a whole file, mapped into memory where the platform supports it and read
+// into a buffer otherwise.
+//
+// Usage:
+//
+// mapbox::svg::MappedFile file;
+// if (file.open("sprite.svg")) {
+//     mapbox::svg::SvgReader reader(file.data(), file.size());
+//     ...
+// }
+//
+// The data isn't NUL-terminated, and stays valid until the file is closed or opened again.
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    bool open(const char* filename) {
+        close();
+#if defined(MAPBOX_SVG_MMAP)
+        const int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = std::size_t(status.st_size);
+        if (length > 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            // Documents are read front to back, once.
+            ::madvise(mapped, length, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+        return true;
+#else
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        length = buffer.size();
+        return true;
+#endif
+    }
+
+    void close() {
+#if defined(MAPBOX_SVG_MMAP)
+        if (mapping) {
+            ::munmap(const_cast<char*>(mapping), length);
+        }
+#endif
+        mapping = nullptr;
+        buffer.clear();
+        length = 0;
+    }
+
+    const char* data() const {
+        return mapping ? mapping : buffer.data();
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    const char* mapping = nullptr;
+    std::vector<char> buffer;
+    std::size_t length = 0;
+};
+
+} // namespace svg
+} // namespace mapbox
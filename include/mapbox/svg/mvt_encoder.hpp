@@ -0,0 +1,421 @@
+#pragma once
+
+#include <mapbox/svg/fill_rule.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+// LineReceiver (see PathFlattener) that writes Mapbox Vector Tile geometry: command integers
+// with zigzag-encoded coordinate deltas, appended to a caller-provided buffer.
+//
+// Usage:
+//
+// std::vector<uint32_t> geometry;
+// mapbox::svg::MvtEncoder encoder(geometry);
+// mapbox::svg::PathFlattener<mapbox::svg::MvtEncoder> flattener(encoder, 0.5);
+// mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+// mapbox::svg::PathTransform<decltype(normalizer), mapbox::svg::ScaleTransform> transform(
+//     normalizer, { 4096 / 24.0, 4096 / 24.0 });
+// mapbox::svg::PathParser<decltype(transform)> parser(transform);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// encoder.finish();
+//
+// Points are rounded to the integer grid of the tile, so the transform in front maps the path
+// into the tile extent, and the flattening tolerance is in tile units. Points that round to the
+// previous one are dropped, and consecutive lines share one LineTo command.
+//
+// The encoder writes POLYGON geometry by default. Every subpath becomes a ring, whether or not it
+// ends with a closepath, since SVG fills them as closed. Rings don't repeat their first point, and
+// those with fewer than three points or without area are dropped. Each ring is written as soon as
+// it ends. With the nonzero fill rule, rings wound against the first ring of the feature are its
+// holes: if the first ring has a negative area, every ring is reversed in place, so that exterior
+// rings get the positive area MVT asks for.
+//
+// With `FillRule::EvenOdd`, holes may run either way, so `finish()` tells them apart by nesting: a
+// ring inside an odd number of other rings is a hole. It rewrites the feature, each exterior ring
+// followed by the holes right inside it, which takes a copy of the feature's geometry, and a sweep
+// over the bounding boxes of the rings finds the pairs to test.
+//
+// With `MvtEncoder::LineString`, every subpath with a segment is written as a line, and a
+// closepath draws the segment back to the start.
+//
+// Call `finish()` after the last path of a feature, which ends a trailing subpath, and `reset()`
+// before encoding the next feature, since deltas run across all paths of a feature.
+
+class MvtEncoder {
+public:
+    enum Command : uint32_t { MoveTo = 1, LineTo = 2, ClosePath = 7 };
+
+    // The geometry types of the specification that a path can be written as.
+    enum GeometryType : uint32_t { LineString = 2, Polygon = 3 };
+
+    static uint32_t command(const Command id, const uint32_t count) {
+        return (id & 0x7) | (count << 3);
+    }
+
+    static uint32_t zigzag(const int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    MvtEncoder(std::vector<uint32_t>& geometry_,
+               const GeometryType type_ = Polygon,
+               const FillRule fillRule_ = FillRule::NonZero)
+        : geometry(geometry_), type(type_), fillRule(fillRule_) {
+        reset();
+    }
+    MvtEncoder(const MvtEncoder&) = delete;
+    MvtEncoder(MvtEncoder&&) = delete;
+
+    // Starts a new feature, appending to the buffer from its current end.
+    void reset() {
+        cursorX = cursorY = 0;
+        reference = 0;
+        rings.clear();
+        featureStart = geometry.size();
+        featureX = featureY = 0;
+        open = false;
+        closed = false;
+    }
+
+    void finish() {
+        endSubpath();
+        if (nesting() && rings.size() > 1) {
+            nest();
+        }
+        rings.clear();
+        featureStart = geometry.size();
+        featureX = cursorX;
+        featureY = cursorY;
+    }
+
+    void moveTo(double x, double y) {
+        endSubpath();
+        start(quantize(x), quantize(y));
+    }
+
+    void closePath() {
+        if (!open) {
+            return;
+        }
+        if (type == Polygon) {
+            endRing();
+        } else {
+            // A line needs the closing segment written out.
+            add(startX, startY);
+            endLine();
+        }
+        open = false;
+        closed = true;
+    }
+
+    void lineTo(double x_, double y_) {
+        const int32_t x = quantize(x_), y = quantize(y_);
+        if (!open) {
+            // Drawing after a closepath starts at the start of the closed subpath.
+            if (!closed) {
+                return;
+            }
+            start(startX, startY);
+        }
+        add(x, y);
+    }
+
+private:
+    // A ring of the current feature, for the nesting of the even-odd rule: where it starts in the
+    // buffer, its number of points and first point, twice its signed area as written, and its
+    // bounding box. `parent` is the innermost ring it lies in, and `depth` the number of rings.
+    struct Ring {
+        std::size_t index, count;
+        int32_t x, y;
+        int64_t area;
+        int32_t minX, minY, maxX, maxY;
+        std::size_t parent, depth;
+    };
+
+    struct Point {
+        int32_t x, y;
+    };
+
+    // Rounds to the nearest integer, saturating at the range of the deltas.
+    static int32_t quantize(const double value) {
+        const double rounded = std::floor(value + 0.5);
+        if (!(rounded > -1073741824.0)) {
+            return -1073741824;
+        }
+        return rounded < 1073741823.0 ? static_cast<int32_t>(rounded) : 1073741823;
+    }
+
+    static int32_t unzigzag(const uint32_t value) {
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    static int64_t cross(const int32_t ax, const int32_t ay, const int32_t bx, const int32_t by) {
+        return int64_t(ax) * by - int64_t(bx) * ay;
+    }
+
+    bool nesting() const {
+        return type == Polygon && fillRule == FillRule::EvenOdd;
+    }
+
+    void start(const int32_t x, const int32_t y) {
+        moveIndex = geometry.size();
+        moveCursorX = cursorX;
+        moveCursorY = cursorY;
+        geometry.push_back(command(MoveTo, 1));
+        geometry.push_back(zigzag(x - cursorX));
+        geometry.push_back(zigzag(y - cursorY));
+        startX = cursorX = minX = maxX = x;
+        startY = cursorY = minY = maxY = y;
+        lines = 0;
+        area = 0;
+        open = true;
+        closed = false;
+    }
+
+    void add(const int32_t x, const int32_t y) {
+        if (x == cursorX && y == cursorY) {
+            return;
+        }
+        if (lines == 0) {
+            lineHeader = geometry.size();
+            geometry.push_back(0);
+        }
+        geometry.push_back(zigzag(x - cursorX));
+        geometry.push_back(zigzag(y - cursorY));
+        area += cross(cursorX, cursorY, x, y);
+        previousX = cursorX;
+        previousY = cursorY;
+        cursorX = x;
+        cursorY = y;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        ++lines;
+    }
+
+    void endSubpath() {
+        if (!open) {
+            return;
+        }
+        if (type == Polygon) {
+            endRing();
+        } else {
+            endLine();
+        }
+        open = false;
+    }
+
+    void endLine() {
+        if (lines == 0) {
+            drop();
+        } else {
+            geometry[lineHeader] = command(LineTo, lines);
+        }
+    }
+
+    void endRing() {
+        // The ring closes on its own, so a last point back at the start is redundant.
+        if (lines > 0 && cursorX == startX && cursorY == startY) {
+            geometry.resize(geometry.size() - 2);
+            area -= cross(previousX, previousY, startX, startY);
+            cursorX = previousX;
+            cursorY = previousY;
+            --lines;
+        }
+        area += cross(cursorX, cursorY, startX, startY);
+        if (lines < 2 || area == 0) {
+            drop();
+            return;
+        }
+        geometry[lineHeader] = command(LineTo, lines);
+        if (reference == 0) {
+            reference = area > 0 ? 1 : -1;
+        }
+        if (reference < 0) {
+            reverse();
+            area = -area;
+        }
+        geometry.push_back(command(ClosePath, 1));
+        if (nesting()) {
+            rings.push_back({ moveIndex, lines + 1, startX, startY, area, minX, minY, maxX, maxY,
+                              rings.size(), 0 });
+        }
+    }
+
+    // Reverses the ring just written, keeping its first point: the first delta spans the whole
+    // ring, and the others are those of the ring in reverse order, negated.
+    void reverse() {
+        uint32_t* const deltas = &geometry[lineHeader + 1];
+        const int32_t secondX = startX + unzigzag(deltas[0]);
+        const int32_t secondY = startY + unzigzag(deltas[1]);
+        deltas[0] = zigzag(cursorX - startX);
+        deltas[1] = zigzag(cursorY - startY);
+        for (std::size_t i = 1, j = lines - 1; i <= j; ++i, --j) {
+            const uint32_t x = deltas[2 * i], y = deltas[2 * i + 1];
+            deltas[2 * i] = zigzag(-unzigzag(deltas[2 * j]));
+            deltas[2 * i + 1] = zigzag(-unzigzag(deltas[2 * j + 1]));
+            deltas[2 * j] = zigzag(-unzigzag(x));
+            deltas[2 * j + 1] = zigzag(-unzigzag(y));
+        }
+        cursorX = secondX;
+        cursorY = secondY;
+    }
+
+    // Removes the current subpath, and restores the cursor from before its MoveTo.
+    void drop() {
+        geometry.resize(moveIndex);
+        cursorX = moveCursorX;
+        cursorY = moveCursorY;
+    }
+
+    // Reads the points of a ring from the copy of the feature.
+    void readRing(const Ring& ring, std::vector<Point>& result) const {
+        const uint32_t* deltas = &scratch[ring.index - featureStart + 4];
+        result.assign(1, Point{ ring.x, ring.y });
+        for (std::size_t i = 1; i < ring.count; ++i, deltas += 2) {
+            result.push_back(
+                { result.back().x + unzigzag(deltas[0]), result.back().y + unzigzag(deltas[1]) });
+        }
+    }
+
+    // Whether `inner` lies in `outer`, as told by the first point of `inner`, since rings of a
+    // path that fills properly don't cross.
+    bool contains(const Ring& outer, const Ring& inner) {
+        if (std::abs(inner.area) >= std::abs(outer.area) || inner.x < outer.minX ||
+            inner.x > outer.maxX || inner.y < outer.minY || inner.y > outer.maxY) {
+            return false;
+        }
+        readRing(outer, points);
+        const Point* p = points.data();
+        bool inside = false;
+        for (std::size_t j = 0, k = outer.count - 1; j < outer.count; k = j++) {
+            if ((p[j].y > inner.y) != (p[k].y > inner.y)) {
+                const int64_t side = (int64_t(p[k].x) - p[j].x) * (int64_t(inner.y) - p[j].y) -
+                                     (int64_t(inner.x) - p[j].x) * (int64_t(p[k].y) - p[j].y);
+                inside ^= p[k].y > p[j].y ? side > 0 : side < 0;
+            }
+        }
+        return inside;
+    }
+
+    // Finds the rings each ring lies in, by a sweep from left to right: the first point of each
+    // ring is only tested against the rings whose bounding boxes span it horizontally. Then
+    // writes the feature again, each exterior ring followed by its holes.
+    void nest() {
+        scratch.assign(geometry.begin() + std::ptrdiff_t(featureStart), geometry.end());
+        byLeft.resize(rings.size());
+        byPoint.resize(rings.size());
+        for (std::size_t i = 0; i < rings.size(); ++i) {
+            byLeft[i] = byPoint[i] = i;
+        }
+        std::sort(byLeft.begin(), byLeft.end(), [&](const std::size_t a, const std::size_t b) {
+            return rings[a].minX < rings[b].minX;
+        });
+        std::sort(byPoint.begin(), byPoint.end(), [&](const std::size_t a, const std::size_t b) {
+            return rings[a].x < rings[b].x;
+        });
+        active.clear();
+        std::size_t next = 0;
+        for (const std::size_t i : byPoint) {
+            Ring& inner = rings[i];
+            for (; next < byLeft.size() && rings[byLeft[next]].minX <= inner.x; ++next) {
+                active.push_back(byLeft[next]);
+            }
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [&](const std::size_t j) {
+                                            return rings[j].maxX < inner.x;
+                                        }),
+                         active.end());
+            for (const std::size_t j : active) {
+                if (j == i || !contains(rings[j], inner)) {
+                    continue;
+                }
+                ++inner.depth;
+                if (inner.parent == i ||
+                    std::abs(rings[j].area) < std::abs(rings[inner.parent].area)) {
+                    inner.parent = j;
+                }
+            }
+        }
+
+        geometry.resize(featureStart);
+        cursorX = featureX;
+        cursorY = featureY;
+        for (std::size_t i = 0; i < rings.size(); ++i) {
+            if (rings[i].depth % 2 != 0) {
+                continue;
+            }
+            writeRing(rings[i], true);
+            for (std::size_t j = 0; j < rings.size(); ++j) {
+                if (rings[j].depth % 2 != 0 && rings[j].parent == i) {
+                    writeRing(rings[j], false);
+                }
+            }
+        }
+    }
+
+    // Writes a ring of the copy of the feature, with a positive area if it is exterior.
+    void writeRing(const Ring& ring, const bool exterior) {
+        readRing(ring, points);
+        const bool backwards = (ring.area > 0) != exterior;
+        const std::size_t count = points.size();
+        geometry.push_back(command(MoveTo, 1));
+        delta(points[0]);
+        geometry.push_back(command(LineTo, uint32_t(count - 1)));
+        for (std::size_t j = 1; j < count; ++j) {
+            delta(points[backwards ? count - j : j]);
+        }
+        geometry.push_back(command(ClosePath, 1));
+    }
+
+    void delta(const Point& point) {
+        geometry.push_back(zigzag(point.x - cursorX));
+        geometry.push_back(zigzag(point.y - cursorY));
+        cursorX = point.x;
+        cursorY = point.y;
+    }
+
+    std::vector<uint32_t>& geometry;
+    const GeometryType type;
+    const FillRule fillRule;
+
+    // The last point written, on which the next delta is based.
+    int32_t cursorX, cursorY;
+
+    // The sign of the area of the first ring of the feature, or 0 before it.
+    int reference;
+
+    // The current subpath: where its commands start, the cursor before it, its first point, the
+    // point before the last one, the number of LineTo points so far, twice its signed area up to
+    // the last point, and its bounding box.
+    std::size_t moveIndex = 0;
+    std::size_t lineHeader = 0;
+    int32_t moveCursorX = 0, moveCursorY = 0;
+    int32_t startX = 0, startY = 0;
+    int32_t previousX = 0, previousY = 0;
+    uint32_t lines = 0;
+    int64_t area = 0;
+    int32_t minX = 0, minY = 0, maxX = 0, maxY = 0;
+    bool open;
+    bool closed;
+
+    // For the even-odd rule: the rings of the feature, where the feature starts in the buffer
+    // and the cursor there, and scratch space for the nesting.
+    std::vector<Ring> rings;
+    std::size_t featureStart;
+    int32_t featureX, featureY;
+    std::vector<uint32_t> scratch;
+    std::vector<Point> points;
+    std::vector<std::size_t> byLeft, byPoint, active;
+};
+
+} // namespace svg
+} // namespace mapbox
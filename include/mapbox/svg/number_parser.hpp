@@ -0,0 +1,476 @@
+#pragma once
+
+#include <mapbox/svg/char_scan.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace mapbox {
+namespace svg {
+
+// Stands in for a coordinate whose value is never needed: PathParser checks the grammar of the
+// number without converting it. See PathParser for receivers that declare it for some arguments.
+struct UnconvertedNumber {};
+
+namespace detail {
+
+// Returns 10^exponent for 0 <= exponent <= 22, the range in which powers of ten are exact doubles.
+inline double exactPowerOfTen(const int64_t exponent) {
+    static constexpr double powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    return powers[exponent];
+}
+
+// Returns 10^exponent for 0 <= exponent <= 16.
+inline uint64_t integerPowerOfTen(const unsigned exponent) {
+    static constexpr uint64_t powers[] = {
+        1ull,           10ull,           100ull,           1000ull,           10000ull,
+        100000ull,      1000000ull,      10000000ull,      100000000ull,      1000000000ull,
+        10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+        1000000000000000ull, 10000000000000000ull,
+    };
+    return powers[exponent];
+}
+
+constexpr uint64_t maxExactMantissa = uint64_t(1) << 53;
+
+// Returns 10^exponent for 0 <= exponent <= 10, the range in which powers of ten are exact floats.
+inline float exactPowerOfTenFloat(const int64_t exponent) {
+    static constexpr float powers[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+    };
+    return powers[exponent];
+}
+
+constexpr uint64_t maxExactFloatMantissa = uint64_t(1) << 24;
+
+// The slow path rewrites the number as "<digits>e<exponent>" and hands it to strtod. Without a
+// decimal point the conversion does not depend on LC_NUMERIC. 768 significant digits are enough
+// to round any double correctly; further digits only matter as a sticky bit.
+constexpr int maxSlowPathDigits = 780;
+
+inline void convertDigits(const char* str, double& value) {
+    value = std::strtod(str, nullptr);
+}
+
+inline void convertDigits(const char* str, float& value) {
+    value = std::strtof(str, nullptr);
+}
+
+template <typename Float = double>
+Float parseDecimalSlow(const char* first, const char* last, int64_t exponent) {
+    char buffer[maxSlowPathDigits + 32];
+    int length = 0;
+    bool sticky = false;
+    for (const char* it = first; it != last; ++it) {
+        if (!isDigit(*it) || (length == 0 && *it == '0')) {
+            continue;
+        }
+        if (length < maxSlowPathDigits) {
+            buffer[length++] = *it;
+        } else {
+            ++exponent;
+            sticky = sticky || *it != '0';
+        }
+    }
+    if (length == 0) {
+        return 0;
+    }
+    if (sticky) {
+        buffer[length++] = '1';
+        --exponent;
+    }
+    if (exponent < -100000) {
+        exponent = -100000;
+    } else if (exponent > 100000) {
+        exponent = 100000;
+    }
+
+    buffer[length++] = 'e';
+    if (exponent < 0) {
+        buffer[length++] = '-';
+        exponent = -exponent;
+    }
+    char digits[8];
+    int count = 0;
+    do {
+        digits[count++] = char('0' + exponent % 10);
+        exponent /= 10;
+    } while (exponent);
+    while (count) {
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+    Float value;
+    convertDigits(buffer, value);
+    return value;
+}
+
+// Scans `digits ("." digits?)? | "." digits` at `cursor`. Up to 19 significant digits are
+// accumulated into the mantissa; `scale` is the power of ten it has to be multiplied with, not
+// counting the explicit exponent. Returns false if there are no digits.
+inline bool scanDecimal(const char*& cursor,
+                        const char* const last,
+                        uint64_t& mantissa,
+                        int64_t& scale,
+                        int64_t& fractionDigits,
+                        bool& truncated) {
+    int significantDigits = 0;
+    bool hasDigits = false;
+    while (cursor != last && *cursor == '0') {
+        ++cursor;
+        hasDigits = true;
+    }
+    while (cursor != last && isDigit(*cursor)) {
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + uint64_t(*cursor - '0');
+            ++significantDigits;
+        } else {
+            ++scale;
+            truncated = truncated || *cursor != '0';
+        }
+        ++cursor;
+        hasDigits = true;
+    }
+    if (cursor != last && *cursor == '.') {
+        ++cursor;
+        while (cursor != last && isDigit(*cursor)) {
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + uint64_t(*cursor - '0');
+                significantDigits += mantissa != 0;
+                --scale;
+            } else {
+                truncated = truncated || *cursor != '0';
+            }
+            ++fractionDigits;
+            ++cursor;
+            hasDigits = true;
+        }
+    }
+    return hasDigits;
+}
+
+#if defined(MAPBOX_SVG_VECTOR)
+// Value of the `count` (at most 8) digits at `window + offset`, where offset + count <= 16. Only
+// reads the 16 bytes of the window.
+inline uint64_t parseWindowDigits8(const char* window, const unsigned offset, const unsigned count) {
+    return offset <= 8 ? parseDigits8(window + offset, count)
+                       : parseDigits8Before(window + offset + count, count);
+}
+
+inline uint64_t parseWindowDigits(const char* window, const unsigned offset, const unsigned count) {
+    if (count <= 8) {
+        return parseWindowDigits8(window, offset, count);
+    }
+    return parseWindowDigits8(window, offset, count - 8) * 100000000 +
+           parseWindowDigits8(window, offset + count - 8, 8);
+}
+
+// Same as scanDecimal for the common case of a number whose digits end within the 16 readable
+// bytes at `cursor`: one vector comparison finds both digit runs, so there is no branch per
+// digit. Such a number has at most 15 digits, which always fit the mantissa exactly. Returns
+// false without consuming anything if the number doesn't fit or has no digits.
+inline bool scanShortDecimal(const char*& cursor,
+                             uint64_t& mantissa,
+                             int64_t& scale,
+                             int64_t& fractionDigits) {
+    const uint32_t mask = digitMask16(cursor);
+    const unsigned integerDigits = countTrailingZeros(~mask);
+    if (integerDigits == 16) {
+        return false;
+    }
+    if (cursor[integerDigits] != '.') {
+        if (integerDigits == 0) {
+            return false;
+        }
+        mantissa = parseWindowDigits(cursor, 0, integerDigits);
+        cursor += integerDigits;
+        return true;
+    }
+    const unsigned fractionBegin = integerDigits + 1;
+    const unsigned fraction = countTrailingZeros(~(mask >> fractionBegin));
+    if (fractionBegin + fraction >= 16 || integerDigits + fraction == 0) {
+        return false;
+    }
+    mantissa = parseWindowDigits(cursor, 0, integerDigits) * integerPowerOfTen(fraction) +
+               parseWindowDigits(cursor, fractionBegin, fraction);
+    scale = -int64_t(fraction);
+    fractionDigits = fraction;
+    cursor += fractionBegin + fraction;
+    return true;
+}
+#endif
+
+// A scanned number before its conversion: `mantissa` * 10^`power`, unless more than 19
+// significant digits were `truncated`. The digits between `digitsBegin` and `digitsEnd`, read as
+// one integer, times 10^`digitsExponent` are always the exact magnitude.
+struct DecimalNumber {
+    uint64_t mantissa;
+    int64_t power;
+    int64_t digitsExponent;
+    const char* digitsBegin;
+    const char* digitsEnd;
+    bool negative;
+    bool truncated;
+};
+
+// Scans a number following the SVG path grammar:
+//
+//     number: sign? (digits ("." digits?)? | "." digits) (("e" | "E") sign? digits)?
+//
+// Returns a pointer past the last consumed character, or `first` if no number starts there. Never
+// reads at or past `last`.
+inline const char* scanNumber(const char* first, const char* last, DecimalNumber& number) {
+    const char* cursor = first;
+    if (cursor == last) {
+        return first;
+    }
+    number.negative = *cursor == '-';
+    if (*cursor == '-' || *cursor == '+') {
+        ++cursor;
+    }
+
+    number.digitsBegin = cursor;
+    number.mantissa = 0;
+    number.truncated = false;
+    int64_t scale = 0;
+    int64_t fractionDigits = 0;
+    bool hasDigits = false;
+#if defined(MAPBOX_SVG_VECTOR)
+    if (last - cursor >= 16) {
+        hasDigits = scanShortDecimal(cursor, number.mantissa, scale, fractionDigits);
+    }
+#endif
+    if (!hasDigits &&
+        !scanDecimal(cursor, last, number.mantissa, scale, fractionDigits, number.truncated)) {
+        return first;
+    }
+    number.digitsEnd = cursor;
+
+    int64_t exponent = 0;
+    if (cursor != last && (*cursor == 'e' || *cursor == 'E')) {
+        const char* exponentCursor = cursor + 1;
+        const bool negativeExponent = exponentCursor != last && *exponentCursor == '-';
+        if (exponentCursor != last && (*exponentCursor == '-' || *exponentCursor == '+')) {
+            ++exponentCursor;
+        }
+        if (exponentCursor != last && isDigit(*exponentCursor)) {
+            while (exponentCursor != last && isDigit(*exponentCursor)) {
+                if (exponent < 100000) {
+                    exponent = exponent * 10 + (*exponentCursor - '0');
+                }
+                ++exponentCursor;
+            }
+            if (negativeExponent) {
+                exponent = -exponent;
+            }
+            cursor = exponentCursor;
+        }
+    }
+    number.power = exponent + scale;
+    number.digitsExponent = exponent - fractionDigits;
+    return cursor;
+}
+
+// Correctly rounded magnitude of a scanned number.
+inline double decimalToDouble(const DecimalNumber& number) {
+    const uint64_t mantissa = number.mantissa;
+    const int64_t power = number.power;
+    if (mantissa == 0 && !number.truncated) {
+        return 0;
+    } else if (number.truncated || mantissa > maxExactMantissa) {
+        return parseDecimalSlow(number.digitsBegin, number.digitsEnd, number.digitsExponent);
+    } else if (power >= -22 && power <= 22) {
+        // Both operands are exact, so IEEE 754 guarantees a correctly rounded result.
+        return power < 0 ? double(mantissa) / exactPowerOfTen(-power)
+                         : double(mantissa) * exactPowerOfTen(power);
+    } else if (power > 22 && power <= 22 + 15 &&
+               mantissa <= maxExactMantissa / uint64_t(exactPowerOfTen(power - 22))) {
+        return double(mantissa * uint64_t(exactPowerOfTen(power - 22))) * 1e22;
+    }
+    return parseDecimalSlow(number.digitsBegin, number.digitsEnd, number.digitsExponent);
+}
+
+// Correctly rounded magnitude of a scanned number as a float. Rounding the double result again
+// can only go wrong if it lands exactly halfway between two floats; those rare inputs take the
+// slow path.
+inline float decimalToFloat(const DecimalNumber& number) {
+    const uint64_t mantissa = number.mantissa;
+    const int64_t power = number.power;
+    if (!number.truncated && mantissa <= maxExactFloatMantissa && power >= -10 && power <= 10) {
+        return power < 0 ? float(mantissa) / exactPowerOfTenFloat(-power)
+                         : float(mantissa) * exactPowerOfTenFloat(power);
+    }
+    const double exact = decimalToDouble(number);
+    const float result = float(exact);
+
+    // In the range of normal floats, a double is halfway between two floats exactly if the 29
+    // mantissa bits that a float doesn't have are 1000...0.
+    uint64_t bits;
+    std::memcpy(&bits, &exact, sizeof(bits));
+    const uint64_t biasedExponent = (bits >> 52) & 0x7FF;
+    if (biasedExponent >= 1023 - 126 && biasedExponent <= 1023 + 127 &&
+        (bits & 0x1FFFFFFF) != 0x10000000) {
+        return result;
+    }
+    if (double(result) != exact && !std::isinf(exact)) {
+        const double neighbour =
+            std::isinf(result)
+                ? std::ldexp(1.0, 128)
+                : double(std::nextafter(result, exact > result ? std::numeric_limits<float>::max()
+                                                               : 0.0f));
+        const double bound = std::isinf(result) ? double(std::numeric_limits<float>::max()) : result;
+        if ((bound + neighbour) / 2 == exact) {
+            return parseDecimalSlow<float>(number.digitsBegin, number.digitsEnd,
+                                           number.digitsExponent);
+        }
+    }
+    return result;
+}
+
+// Scans a number (see scanNumber). The result is correctly rounded and independent of the current
+// locale. Values that overflow are reported as infinity.
+inline const char* parseNumber(const char* first, const char* last, double& value) {
+    DecimalNumber number;
+    const char* next = scanNumber(first, last, number);
+    if (next != first) {
+        const double result = decimalToDouble(number);
+        value = number.negative ? -result : result;
+    }
+    return next;
+}
+
+inline const char* parseNumber(const char* first, const char* last, float& value) {
+    DecimalNumber number;
+    const char* next = scanNumber(first, last, number);
+    if (next != first) {
+        const float result = decimalToFloat(number);
+        value = number.negative ? -result : result;
+    }
+    return next;
+}
+
+// How PathParser scans coordinates of type T: `parse` returns `first` if there is no number, and
+// `isOverflow` tells whether a parsed value is out of range. Specialized for types that aren't
+// floating point.
+template <typename T>
+struct CoordinateTraits {
+    static const char* parse(const char* first, const char* last, T& value) {
+        return parseNumber(first, last, value);
+    }
+
+    static bool isOverflow(const T value) {
+        return std::isinf(value);
+    }
+};
+
+// Skips the number at `first` following the grammar of scanNumber, without accumulating its
+// digits. Only the decimal exponent of its leading digit is tracked, to reject numbers that would
+// overflow a double as a full parse does. Returns `first` if there is no number or it overflows.
+inline const char* skipNumber(const char* first, const char* last) {
+    const char* cursor = first;
+    if (cursor != last && (*cursor == '-' || *cursor == '+')) {
+        ++cursor;
+    }
+#if defined(MAPBOX_SVG_VECTOR)
+    // As in scanShortDecimal, find both digit runs at once. Without an exponent, a number that
+    // ends within the window can't overflow.
+    if (last - cursor >= 16) {
+        const uint32_t mask = digitMask16(cursor);
+        const unsigned integerDigits = countTrailingZeros(~mask);
+        unsigned length = integerDigits;
+        bool hasDigits = integerDigits != 0;
+        if (integerDigits < 16 && cursor[integerDigits] == '.') {
+            const unsigned fraction = countTrailingZeros(~(mask >> (integerDigits + 1)));
+            length = integerDigits + 1 + fraction;
+            hasDigits = hasDigits || fraction != 0;
+        }
+        if (length < 16 && hasDigits && cursor[length] != 'e' && cursor[length] != 'E') {
+            return cursor + length;
+        }
+    }
+#endif
+    const char* const digitsBegin = cursor;
+    while (cursor != last && *cursor == '0') {
+        ++cursor;
+    }
+    const char* const significantBegin = cursor;
+    while (cursor != last && isDigit(*cursor)) {
+        ++cursor;
+    }
+    // Exponent of the leading non-zero digit, before the explicit exponent.
+    int64_t magnitude = cursor - significantBegin - 1;
+    bool hasDigits = cursor != digitsBegin;
+    bool isZero = cursor == significantBegin;
+    if (cursor != last && *cursor == '.') {
+        ++cursor;
+        const char* const fractionBegin = cursor;
+        if (isZero) {
+            while (cursor != last && *cursor == '0') {
+                ++cursor;
+            }
+            magnitude = fractionBegin - cursor - 1;
+            isZero = cursor == last || !isDigit(*cursor);
+        }
+        while (cursor != last && isDigit(*cursor)) {
+            ++cursor;
+        }
+        hasDigits = hasDigits || cursor != fractionBegin;
+    }
+    if (!hasDigits) {
+        return first;
+    }
+
+    if (cursor != last && (*cursor == 'e' || *cursor == 'E')) {
+        const char* exponentCursor = cursor + 1;
+        const bool negativeExponent = exponentCursor != last && *exponentCursor == '-';
+        if (exponentCursor != last && (*exponentCursor == '-' || *exponentCursor == '+')) {
+            ++exponentCursor;
+        }
+        if (exponentCursor != last && isDigit(*exponentCursor)) {
+            int64_t exponent = 0;
+            while (exponentCursor != last && isDigit(*exponentCursor)) {
+                if (exponent < 100000) {
+                    exponent = exponent * 10 + (*exponentCursor - '0');
+                }
+                ++exponentCursor;
+            }
+            magnitude += negativeExponent ? -exponent : exponent;
+            cursor = exponentCursor;
+        }
+    }
+
+    if (!isZero && magnitude >= 308) {
+        if (magnitude > 308) {
+            return first;
+        }
+        // Only numbers between 10^308 and 10^309 need to be converted to tell.
+        double value = 0;
+        parseNumber(first, cursor, value);
+        if (std::isinf(value)) {
+            return first;
+        }
+    }
+    return cursor;
+}
+
+// Checks the grammar of a number without converting it.
+template <>
+struct CoordinateTraits<UnconvertedNumber> {
+    static const char* parse(const char* first, const char* last, UnconvertedNumber&) {
+        return skipNumber(first, last);
+    }
+
+    static bool isOverflow(const UnconvertedNumber&) {
+        return false;
+    }
+};
+
+} // namespace detail
+} // namespace svg
+} // namespace mapbox
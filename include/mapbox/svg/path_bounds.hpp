@@ -0,0 +1,291 @@
+#pragma once
+
+#include <mapbox/svg/elliptical_arc.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mapbox {
+namespace svg {
+
+struct BoundingBox {
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = std::numeric_limits<double>::infinity();
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+
+    // True until the first point is added.
+    bool empty() const {
+        return minX > maxX;
+    }
+
+    void extend(const double x, const double y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    bool contains(const double x, const double y) const {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY;
+    }
+};
+
+// NormalizedReceiver (see PathNormalizer) that computes the exact bounds of a path: the end
+// points of all segments, and the extrema of curves and arcs between them. Points of moveto
+// commands are included even if nothing is drawn from them.
+//
+// Usage:
+//
+// mapbox::svg::BoundsReceiver bounds;
+// mapbox::svg::PathNormalizer<mapbox::svg::BoundsReceiver> normalizer(bounds);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// const mapbox::svg::BoundingBox& box = bounds.bounds();
+//
+// Extrema come from the roots of the derivative of each coordinate, and are only computed when a
+// control point, or for arcs the whole ellipse, lies outside the bounds so far.
+
+class BoundsReceiver {
+public:
+    BoundsReceiver() {
+        reset();
+    }
+
+    void reset() {
+        box = BoundingBox();
+        x = y = 0;
+        startX = startY = 0;
+    }
+
+    const BoundingBox& bounds() const {
+        return box;
+    }
+
+    void moveTo(double x_, double y_) {
+        x = startX = x_;
+        y = startY = y_;
+        box.extend(x, y);
+    }
+
+    void closePath() {
+        x = startX;
+        y = startY;
+    }
+
+    void lineTo(double x_, double y_) {
+        x = x_;
+        y = y_;
+        box.extend(x, y);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x_, double y_) {
+        box.extend(x_, y_);
+        if (!box.contains(x1, y1) || !box.contains(x2, y2)) {
+            cubicExtrema(x, x1, x2, x_, box.minX, box.maxX);
+            cubicExtrema(y, y1, y2, y_, box.minY, box.maxY);
+        }
+        x = x_;
+        y = y_;
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x_, double y_) {
+        box.extend(x_, y_);
+        if (!box.contains(x1, y1)) {
+            quadraticExtremum(x, x1, x_, box.minX, box.maxX);
+            quadraticExtremum(y, y1, y_, box.minY, box.maxY);
+        }
+        x = x_;
+        y = y_;
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x_,
+             double y_) {
+        const double x0 = x, y0 = y;
+        lineTo(x_, y_);
+        EllipticalArc e;
+        if (!EllipticalArc::centerFromEndpoints(x0, y0, rx, ry, xAxisRotation, largeArcFlag,
+                                                sweepFlag, x_, y_, e)) {
+            return;
+        }
+
+        // The ellipse touches its bounding box at cx +- extentX, cy +- offsetY and at
+        // cx +- offsetX, cy +- extentY.
+        const double rxCos = e.rx * e.cosPhi, rxSin = e.rx * e.sinPhi;
+        const double ryCos = e.ry * e.cosPhi, rySin = e.ry * e.sinPhi;
+        const double extentX = std::sqrt(rxCos * rxCos + rySin * rySin);
+        const double extentY = std::sqrt(rxSin * rxSin + ryCos * ryCos);
+        if (box.contains(e.cx - extentX, e.cy - extentY) &&
+            box.contains(e.cx + extentX, e.cy + extentY)) {
+            return;
+        }
+        const double shear = rxCos * rxSin - ryCos * rySin;
+        const double offsetY = extentX > 0 ? shear / extentX : 0;
+        const double offsetX = extentY > 0 ? shear / extentY : 0;
+
+        // The center parameterization maps the unit circle with a positive determinant, so the
+        // points of the ellipse on the arc are those on one side of the chord: the right side
+        // (in a y-up frame) for a positive sweep.
+        const double chordX = x_ - x0, chordY = y_ - y0;
+        const double side = sweepFlag ? -1 : 1;
+        const auto onArc = [&](const double px, const double py) {
+            return side * (chordX * (py - y0) - chordY * (px - x0)) >= 0;
+        };
+        if (onArc(e.cx + extentX, e.cy + offsetY)) {
+            box.maxX = std::max(box.maxX, e.cx + extentX);
+        }
+        if (onArc(e.cx - extentX, e.cy - offsetY)) {
+            box.minX = std::min(box.minX, e.cx - extentX);
+        }
+        if (onArc(e.cx + offsetX, e.cy + extentY)) {
+            box.maxY = std::max(box.maxY, e.cy + extentY);
+        }
+        if (onArc(e.cx - offsetX, e.cy - extentY)) {
+            box.minY = std::min(box.minY, e.cy - extentY);
+        }
+    }
+
+private:
+    // Widens [min, max] by the extrema of one coordinate of a cubic Bézier: the roots of its
+    // derivative. The curve stays within the range of its control points, so there is nothing to
+    // do if they are already within [min, max]. Any other parameter in [0, 1] gives a point on the
+    // curve, so instead of branching on the roots, those outside the interval are clamped into it,
+    // and a negative discriminant is treated as zero.
+    static void cubicExtrema(double p0, double p1, double p2, double p3, double& min, double& max) {
+        if (p1 >= min && p1 <= max && p2 >= min && p2 <= max) {
+            return;
+        }
+        // Roots of a * t^2 + b * t + c, the derivative divided by 3, with the numerically stable
+        // form of the quadratic formula. It also covers a = 0, where q / a is infinite.
+        const double a = p3 - 3 * p2 + 3 * p1 - p0;
+        const double b = 2 * (p2 - 2 * p1 + p0);
+        const double c = p1 - p0;
+        const double discriminant = std::max(0.0, b * b - 4 * a * c);
+        const double q = -(b + std::copysign(std::sqrt(discriminant), b)) / 2;
+        const double v1 = cubicPoint(p0, p1, p2, p3, clamp(q / a));
+        const double v2 = cubicPoint(p0, p1, p2, p3, clamp(c / q));
+        min = std::min(min, std::min(v1, v2));
+        max = std::max(max, std::max(v1, v2));
+    }
+
+    static void quadraticExtremum(double p0, double p1, double p2, double& min, double& max) {
+        if (p1 >= min && p1 <= max) {
+            return;
+        }
+        const double t = clamp((p0 - p1) / (p0 - 2 * p1 + p2));
+        const double r = 1 - t;
+        const double v = r * r * p0 + 2 * r * t * p1 + t * t * p2;
+        min = std::min(min, v);
+        max = std::max(max, v);
+    }
+
+    static double cubicPoint(double p0, double p1, double p2, double p3, const double t) {
+        const double r = 1 - t;
+        return r * r * (r * p0 + 3 * t * p1) + t * t * (3 * r * p2 + t * p3);
+    }
+
+    // Clamps to [0, 1], mapping NaN to 0.
+    static double clamp(const double t) {
+        return std::min(1.0, std::max(0.0, t));
+    }
+
+private:
+    BoundingBox box;
+    double x, y;
+    double startX, startY;
+};
+
+// VertexReceiver that computes the exact bounds of a path as it is parsed, without allocating.
+//
+// Usage:
+//
+// mapbox::svg::PathBounds bounds;
+// mapbox::svg::PathParser<mapbox::svg::PathBounds> parser(bounds);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// const mapbox::svg::BoundingBox& box = bounds.bounds();
+//
+// Call `reset()` before reusing it for another path.
+
+class PathBounds {
+public:
+    PathBounds() : normalizer(receiver) {
+    }
+    PathBounds(const PathBounds&) = delete;
+    PathBounds(PathBounds&&) = delete;
+
+    void reset() {
+        receiver.reset();
+        normalizer.reset();
+    }
+
+    const BoundingBox& bounds() const {
+        return receiver.bounds();
+    }
+
+    // VertexReceiver interface.
+
+    void moveTo(double x, double y, bool relative) {
+        normalizer.moveTo(x, y, relative);
+    }
+
+    void implicitLineTo(double x, double y, bool relative) {
+        normalizer.implicitLineTo(x, y, relative);
+    }
+
+    void closePath() {
+        normalizer.closePath();
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        normalizer.lineTo(x, y, relative);
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        normalizer.horizontalLineTo(x, relative);
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        normalizer.verticalLineTo(y, relative);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        normalizer.curveTo(x1, y1, x2, y2, x, y, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        normalizer.smoothCurveTo(x2, y2, x, y, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        normalizer.quadraticCurveTo(x1, y1, x, y, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        normalizer.smoothQuadraticCurveTo(x, y, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        normalizer.arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative);
+    }
+
+private:
+    BoundsReceiver receiver;
+    PathNormalizer<BoundsReceiver> normalizer;
+};
+
+} // namespace svg
+} // namespace mapbox
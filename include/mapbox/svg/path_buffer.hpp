@@ -0,0 +1,344 @@
+#pragma once
+
+#include <mapbox/svg/path_parser.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+enum class PathVerb : uint8_t {
+    MoveTo,
+    ClosePath,
+    LineTo,
+    HorizontalLineTo,
+    VerticalLineTo,
+    CurveTo,
+    SmoothCurveTo,
+    QuadraticCurveTo,
+    SmoothQuadraticCurveTo,
+    Arc,
+};
+
+// Number of coordinates stored for each verb. The arc flags are kept in the verb byte.
+inline std::size_t coordinateCount(const PathVerb verb) {
+    static constexpr uint8_t counts[] = { 2, 0, 2, 1, 1, 6, 4, 4, 2, 5 };
+    return counts[static_cast<uint8_t>(verb)];
+}
+
+// Compact VertexReceiver that stores a parsed path as a stream of one-byte verbs next to a single
+// array with only the coordinates each verb needs, e.g. 1 byte for a closepath and 1 + 2 * 8
+// bytes for a lineto. With `T = float`, coordinates take half the space.
+//
+// Usage:
+//
+// mapbox::svg::PathBuffer buffer;
+// mapbox::svg::PathParser<mapbox::svg::PathBuffer> parser(buffer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// buffer.replay(receiver);
+//
+// `clear()` keeps the allocated memory, so one buffer can be reused for many parses. Storage can
+// come from an arena through `Allocator`.
+
+template <typename T, typename Allocator = std::allocator<T>>
+class BasicPathBuffer {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+private:
+    using VerbAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>;
+
+    static constexpr uint8_t verbMask = 0x0F;
+    static constexpr uint8_t relativeBit = 0x10;
+    static constexpr uint8_t largeArcBit = 0x20;
+    static constexpr uint8_t sweepBit = 0x40;
+    static constexpr uint8_t implicitBit = 0x80;
+
+public:
+    // A view of one command in the buffer.
+    class Command {
+    public:
+        PathVerb verb() const {
+            return static_cast<PathVerb>(code & verbMask);
+        }
+
+        bool relative() const {
+            return code & relativeBit;
+        }
+
+        bool largeArcFlag() const {
+            return code & largeArcBit;
+        }
+
+        bool sweepFlag() const {
+            return code & sweepBit;
+        }
+
+        // Whether a MoveTo holds a pair after the first one of a moveto, an implicit lineto.
+        bool implicit() const {
+            return code & implicitBit;
+        }
+
+        // The arguments in the order of the corresponding VertexReceiver call, without flags.
+        const T* coordinates() const {
+            return args;
+        }
+
+    private:
+        friend class BasicPathBuffer;
+        Command(uint8_t code_, const T* args_) : code(code_), args(args_) {
+        }
+
+        uint8_t code;
+        const T* args;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Command;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Command*;
+        using reference = Command;
+
+        Command operator*() const {
+            return { *verb, args };
+        }
+
+        const_iterator& operator++() {
+            args += coordinateCount(static_cast<PathVerb>(*verb & verbMask));
+            ++verb;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return verb == other.verb;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return verb != other.verb;
+        }
+
+    private:
+        friend class BasicPathBuffer;
+        const_iterator(const uint8_t* verb_, const T* args_) : verb(verb_), args(args_) {
+        }
+
+        const uint8_t* verb;
+        const T* args;
+    };
+
+    BasicPathBuffer() = default;
+    explicit BasicPathBuffer(const Allocator& allocator)
+        : verbs(VerbAllocator(allocator)), coords(allocator) {
+    }
+
+    void reserve(std::size_t commandCount, std::size_t coordinateCount) {
+        verbs.reserve(commandCount);
+        coords.reserve(coordinateCount);
+    }
+
+    // Removes all commands but keeps the allocated memory.
+    void clear() {
+        verbs.clear();
+        coords.clear();
+    }
+
+    void shrink_to_fit() {
+        verbs.shrink_to_fit();
+        coords.shrink_to_fit();
+    }
+
+    bool empty() const {
+        return verbs.empty();
+    }
+
+    // Number of commands.
+    std::size_t size() const {
+        return verbs.size();
+    }
+
+    // Number of bytes held, including unused capacity.
+    std::size_t memoryUsage() const {
+        return verbs.capacity() + coords.capacity() * sizeof(T);
+    }
+
+    const uint8_t* verbData() const {
+        return verbs.data();
+    }
+
+    const T* coordinateData() const {
+        return coords.data();
+    }
+
+    std::size_t coordinateSize() const {
+        return coords.size();
+    }
+
+    const_iterator begin() const {
+        return { verbs.data(), coords.data() };
+    }
+
+    const_iterator end() const {
+        return { verbs.data() + verbs.size(), coords.data() + coords.size() };
+    }
+
+    // Sends the stored commands to a VertexReceiver, as PathParser would, so that it may have only
+    // some of the methods.
+    template <typename VertexReceiver>
+    void replay(VertexReceiver& t) const {
+        using D = detail::Dispatch<VertexReceiver, T>;
+        const T* a = coords.data();
+        for (const uint8_t code : verbs) {
+            const bool relative = code & relativeBit;
+            switch (static_cast<PathVerb>(code & verbMask)) {
+                case PathVerb::MoveTo:
+                    if (code & implicitBit) {
+                        D::implicitLineTo(t, a[0], a[1], relative);
+                    } else {
+                        D::moveTo(t, a[0], a[1], relative);
+                    }
+                    a += 2;
+                    break;
+                case PathVerb::ClosePath:
+                    D::closePath(t);
+                    break;
+                case PathVerb::LineTo:
+                    D::lineTo(t, a[0], a[1], relative);
+                    a += 2;
+                    break;
+                case PathVerb::HorizontalLineTo:
+                    D::horizontalLineTo(t, a[0], relative);
+                    a += 1;
+                    break;
+                case PathVerb::VerticalLineTo:
+                    D::verticalLineTo(t, a[0], relative);
+                    a += 1;
+                    break;
+                case PathVerb::CurveTo:
+                    D::curveTo(t, a[0], a[1], a[2], a[3], a[4], a[5], relative);
+                    a += 6;
+                    break;
+                case PathVerb::SmoothCurveTo:
+                    D::smoothCurveTo(t, a[0], a[1], a[2], a[3], relative);
+                    a += 4;
+                    break;
+                case PathVerb::QuadraticCurveTo:
+                    D::quadraticCurveTo(t, a[0], a[1], a[2], a[3], relative);
+                    a += 4;
+                    break;
+                case PathVerb::SmoothQuadraticCurveTo:
+                    D::smoothQuadraticCurveTo(t, a[0], a[1], relative);
+                    a += 2;
+                    break;
+                case PathVerb::Arc:
+                    D::arc(t, a[0], a[1], a[2], code & largeArcBit, code & sweepBit, a[3], a[4],
+                           relative);
+                    a += 5;
+                    break;
+            }
+        }
+    }
+
+    // VertexReceiver interface.
+
+    void moveTo(double x, double y, bool relative) {
+        push(PathVerb::MoveTo, relative);
+        coords.insert(coords.end(), { T(x), T(y) });
+    }
+
+    void implicitLineTo(double x, double y, bool relative) {
+        verbs.push_back(static_cast<uint8_t>(PathVerb::MoveTo) | (relative ? relativeBit : 0) |
+                        implicitBit);
+        coords.insert(coords.end(), { T(x), T(y) });
+    }
+
+    void closePath() {
+        push(PathVerb::ClosePath, false);
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        push(PathVerb::LineTo, relative);
+        coords.insert(coords.end(), { T(x), T(y) });
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        push(PathVerb::HorizontalLineTo, relative);
+        coords.push_back(T(x));
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        push(PathVerb::VerticalLineTo, relative);
+        coords.push_back(T(y));
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        push(PathVerb::CurveTo, relative);
+        coords.insert(coords.end(), { T(x1), T(y1), T(x2), T(y2), T(x), T(y) });
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        push(PathVerb::SmoothCurveTo, relative);
+        coords.insert(coords.end(), { T(x2), T(y2), T(x), T(y) });
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        push(PathVerb::QuadraticCurveTo, relative);
+        coords.insert(coords.end(), { T(x1), T(y1), T(x), T(y) });
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        push(PathVerb::SmoothQuadraticCurveTo, relative);
+        coords.insert(coords.end(), { T(x), T(y) });
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        verbs.push_back(static_cast<uint8_t>(PathVerb::Arc) | (relative ? relativeBit : 0) |
+                        (largeArcFlag ? largeArcBit : 0) | (sweepFlag ? sweepBit : 0));
+        coords.insert(coords.end(), { T(rx), T(ry), T(xAxisRotation), T(x), T(y) });
+    }
+
+private:
+    void push(const PathVerb verb, const bool relative) {
+        verbs.push_back(static_cast<uint8_t>(verb) | (relative ? relativeBit : 0));
+    }
+
+private:
+    std::vector<uint8_t, VerbAllocator> verbs;
+    std::vector<T, Allocator> coords;
+};
+
+template <typename T, typename Allocator>
+constexpr uint8_t BasicPathBuffer<T, Allocator>::verbMask;
+template <typename T, typename Allocator>
+constexpr uint8_t BasicPathBuffer<T, Allocator>::relativeBit;
+template <typename T, typename Allocator>
+constexpr uint8_t BasicPathBuffer<T, Allocator>::largeArcBit;
+template <typename T, typename Allocator>
+constexpr uint8_t BasicPathBuffer<T, Allocator>::sweepBit;
+template <typename T, typename Allocator>
+constexpr uint8_t BasicPathBuffer<T, Allocator>::implicitBit;
+
+using PathBuffer = BasicPathBuffer<double>;
+using FloatPathBuffer = BasicPathBuffer<float>;
+
+} // namespace svg
+} // namespace mapbox
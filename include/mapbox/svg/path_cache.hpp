@@ -0,0 +1,251 @@
+#pragma once
+
+#include <mapbox/svg/batch_parser.hpp>
+#include <mapbox/svg/path_buffer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mapbox {
+namespace svg {
+namespace detail {
+
+// Hashes eight bytes at a time, then mixes the state with the finalizer of MurmurHash3.
+inline uint64_t hashBytes(const char* data, const std::size_t size) {
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = size * multiplier;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = ((hash << 5 | hash >> 59) ^ word) * multiplier;
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, size - i);
+        hash = ((hash << 5 | hash >> 59) ^ word) * multiplier;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    return hash ^ (hash >> 33);
+}
+
+} // namespace detail
+
+struct PathCacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t memoryUsage = 0;
+};
+
+// Thread-safe cache of parsed paths, keyed by a hash of the path string. Entries are immutable
+// PathBuffers that replay into any VertexReceiver as if the string had been parsed again.
+//
+// Usage:
+//
+// mapbox::svg::PathCache cache(16 << 20);
+// VertexReceiver receiver;
+// cache.replay("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z", receiver);
+//
+// The cache is split into shards that each have a lock, a least recently used list and an equal
+// part of the memory budget, so threads looking up different paths rarely wait for each other.
+// Misses are parsed outside of the lock. An entry keeps a copy of the string, which catches hash
+// collisions, and its memory usage counts towards the budget along with a fixed overhead for the
+// bookkeeping. Entries that wouldn't fit into a shard on their own aren't kept.
+//
+// Invalid paths are cached too: their entry replays the commands before the error, and keeps
+// the result of the parse.
+
+template <typename T = double>
+class BasicPathCache {
+public:
+    class Entry {
+    public:
+        const BasicPathBuffer<T>& path() const {
+            return buffer;
+        }
+
+        const PathParseResult& result() const {
+            return parseResult;
+        }
+
+        // Sends the stored commands to a VertexReceiver, as PathParser would.
+        template <typename VertexReceiver>
+        void replay(VertexReceiver& t) const {
+            buffer.replay(t);
+        }
+
+        // Number of bytes held, including the cache's bookkeeping.
+        std::size_t memoryUsage() const {
+            return sizeof(Entry) + buffer.memoryUsage() + source.capacity() + entryOverhead;
+        }
+
+    private:
+        friend class BasicPathCache;
+
+        BasicPathBuffer<T> buffer;
+        PathParseResult parseResult;
+        std::string source;
+    };
+
+    // Estimated bytes for the list and index nodes and the shared pointer of an entry.
+    static constexpr std::size_t entryOverhead = 128;
+
+    explicit BasicPathCache(const std::size_t memoryBudget, const unsigned shardCount = 16)
+        : count(std::max(1u, shardCount)),
+          shardBudget(memoryBudget / count),
+          shards(new Shard[count]) {
+    }
+    BasicPathCache(const BasicPathCache&) = delete;
+    BasicPathCache(BasicPathCache&&) = delete;
+
+    // Returns the entry for the path, parsing it on a miss. The entry stays valid after it is
+    // evicted, for as long as the pointer is held.
+    std::shared_ptr<const Entry> get(const char* data, const std::size_t size) {
+        const uint64_t hash = detail::hashBytes(data, size);
+        Shard& shard = shards[(hash >> 32) % count];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto found = shard.index.find(hash);
+            if (found != shard.index.end() && matches(*found->second->second, data, size)) {
+                shard.order.splice(shard.order.begin(), shard.order, found->second);
+                ++shard.hits;
+                return found->second->second;
+            }
+            ++shard.misses;
+        }
+
+        std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+        PathParser<BasicPathBuffer<T>, T> parser(entry->buffer);
+        PathParseResult& result = entry->parseResult;
+        result.success = parser(data, size);
+        result.error = parser.errorType();
+        result.errorOffset = result.success ? 0 : parser.errorOffset();
+        entry->buffer.shrink_to_fit();
+        entry->source.assign(data, size);
+        const std::size_t cost = entry->memoryUsage();
+        if (cost > shardBudget) {
+            return entry;
+        }
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.index.find(hash);
+        if (found != shard.index.end()) {
+            // Another thread parsed the same path in the meantime, or the hash collides.
+            if (matches(*found->second->second, data, size)) {
+                return found->second->second;
+            }
+            shard.memory -= found->second->second->memoryUsage();
+            shard.order.erase(found->second);
+            shard.index.erase(found);
+            ++shard.evictions;
+        }
+        shard.order.emplace_front(hash, entry);
+        shard.index.emplace(hash, shard.order.begin());
+        shard.memory += cost;
+        while (shard.memory > shardBudget) {
+            const auto& last = shard.order.back();
+            shard.memory -= last.second->memoryUsage();
+            shard.index.erase(last.first);
+            shard.order.pop_back();
+            ++shard.evictions;
+        }
+        return entry;
+    }
+
+    std::shared_ptr<const Entry> get(const char* str) {
+        return get(str, std::strlen(str));
+    }
+
+    template <typename String>
+    std::shared_ptr<const Entry> get(const String& str) {
+        return get(str.data(), str.size());
+    }
+
+    // Sends the commands of the path to a VertexReceiver, from the cache if possible. Returns
+    // whether the path is valid, like PathParser.
+    template <typename VertexReceiver>
+    bool replay(const char* data, const std::size_t size, VertexReceiver& t) {
+        const std::shared_ptr<const Entry> entry = get(data, size);
+        entry->replay(t);
+        return entry->result().success;
+    }
+
+    template <typename VertexReceiver>
+    bool replay(const char* str, VertexReceiver& t) {
+        return replay(str, std::strlen(str), t);
+    }
+
+    template <typename String, typename VertexReceiver>
+    bool replay(const String& str, VertexReceiver& t) {
+        return replay(str.data(), str.size(), t);
+    }
+
+    // Totals over all shards. The counters keep running across `clear()`.
+    PathCacheStatistics statistics() const {
+        PathCacheStatistics statistics;
+        for (unsigned i = 0; i < count; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            statistics.hits += shards[i].hits;
+            statistics.misses += shards[i].misses;
+            statistics.evictions += shards[i].evictions;
+            statistics.entries += shards[i].index.size();
+            statistics.memoryUsage += shards[i].memory;
+        }
+        return statistics;
+    }
+
+    // Removes all entries. Entries still held by callers stay valid.
+    void clear() {
+        for (unsigned i = 0; i < count; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].index.clear();
+            shards[i].order.clear();
+            shards[i].memory = 0;
+        }
+    }
+
+private:
+    using Order = std::list<std::pair<uint64_t, std::shared_ptr<const Entry>>>;
+
+    // Padded so that two shards' locks don't share a cache line.
+    struct Shard {
+        mutable std::mutex mutex;
+        Order order;
+        std::unordered_map<uint64_t, typename Order::iterator> index;
+        std::size_t memory = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        char padding[64];
+    };
+
+    static bool matches(const Entry& entry, const char* data, const std::size_t size) {
+        return entry.source.size() == size && std::memcmp(entry.source.data(), data, size) == 0;
+    }
+
+    const unsigned count;
+    const std::size_t shardBudget;
+    std::unique_ptr<Shard[]> shards;
+};
+
+template <typename T>
+constexpr std::size_t BasicPathCache<T>::entryOverhead;
+
+using PathCache = BasicPathCache<double>;
+using FloatPathCache = BasicPathCache<float>;
+
+} // namespace svg
+} // namespace mapbox
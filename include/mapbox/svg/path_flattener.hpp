@@ -0,0 +1,193 @@
+#pragma once
+
+#include <mapbox/svg/elliptical_arc.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mapbox {
+namespace svg {
+
+// Turns the curves and arcs of a normalized path (see PathNormalizer) into line segments that stay
+// within `tolerance` of the exact shape.
+//
+// Interface:
+//
+// struct LineReceiver {
+//     void moveTo(double x, double y);
+//     void closePath();
+//     void lineTo(double x, double y);
+// };
+//
+//
+// Usage:
+//
+// LineReceiver receiver;
+// mapbox::svg::PathFlattener<LineReceiver> flattener(receiver, 0.25);
+// mapbox::svg::PathNormalizer<mapbox::svg::PathFlattener<LineReceiver>> normalizer(flattener);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+//
+// The number of segments for each curve is computed upfront from the tolerance, and the points
+// are evaluated in fixed-size batches that the compiler can vectorize.
+
+template <typename LineReceiver>
+class PathFlattener {
+public:
+    PathFlattener(LineReceiver& t_, double tolerance_ = 0.25) : t(t_), tolerance(tolerance_) {
+        x = y = 0;
+        startX = startY = 0;
+    }
+    PathFlattener(const PathFlattener&) = delete;
+    PathFlattener(PathFlattener&&) = delete;
+
+    void moveTo(double x_, double y_) {
+        x = startX = x_;
+        y = startY = y_;
+        t.moveTo(x, y);
+    }
+
+    void closePath() {
+        x = startX;
+        y = startY;
+        t.closePath();
+    }
+
+    void lineTo(double x_, double y_) {
+        x = x_;
+        y = y_;
+        t.lineTo(x, y);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x_, double y_) {
+        // Wang's formula: n segments keep a curve of degree d within the tolerance if
+        // n^2 >= d * (d - 1) / 8 * max |P[i] - 2 P[i + 1] + P[i + 2]| / tolerance.
+        const double ddx = std::max(std::abs(x - 2 * x1 + x2), std::abs(x1 - 2 * x2 + x_));
+        const double ddy = std::max(std::abs(y - 2 * y1 + y2), std::abs(y1 - 2 * y2 + y_));
+        const int n = segments(std::sqrt(0.75 * std::sqrt(ddx * ddx + ddy * ddy) / tolerance));
+
+        // Power basis: P(t) = ((a * t + b) * t + c) * t + P0.
+        const double ax = -x + 3 * (x1 - x2) + x_;
+        const double ay = -y + 3 * (y1 - y2) + y_;
+        const double bx = 3 * (x - 2 * x1 + x2);
+        const double by = 3 * (y - 2 * y1 + y2);
+        const double cx = 3 * (x1 - x);
+        const double cy = 3 * (y1 - y);
+        const double x0 = x;
+        const double y0 = y;
+        const double dt = 1.0 / n;
+
+        double px[batchSize], py[batchSize];
+        for (int i = 1; i < n; i += batchSize) {
+            for (int k = 0; k < batchSize; ++k) {
+                const double s = (i + k) * dt;
+                px[k] = ((ax * s + bx) * s + cx) * s + x0;
+                py[k] = ((ay * s + by) * s + cy) * s + y0;
+            }
+            emit(px, py, std::min(batchSize, n - i));
+        }
+        lineTo(x_, y_);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x_, double y_) {
+        const double ddx = x - 2 * x1 + x_;
+        const double ddy = y - 2 * y1 + y_;
+        const int n = segments(std::sqrt(0.25 * std::sqrt(ddx * ddx + ddy * ddy) / tolerance));
+
+        // Power basis: P(t) = (a * t + b) * t + P0.
+        const double bx = 2 * (x1 - x);
+        const double by = 2 * (y1 - y);
+        const double x0 = x;
+        const double y0 = y;
+        const double dt = 1.0 / n;
+
+        double px[batchSize], py[batchSize];
+        for (int i = 1; i < n; i += batchSize) {
+            for (int k = 0; k < batchSize; ++k) {
+                const double s = (i + k) * dt;
+                px[k] = (ddx * s + bx) * s + x0;
+                py[k] = (ddy * s + by) * s + y0;
+            }
+            emit(px, py, std::min(batchSize, n - i));
+        }
+        lineTo(x_, y_);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x_,
+             double y_) {
+        EllipticalArc e;
+        if (!EllipticalArc::fromEndpoints(x, y, rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x_,
+                                          y_, e)) {
+            if (x_ != x || y_ != y) {
+                lineTo(x_, y_);
+            }
+            return;
+        }
+
+        // A chord spanning an angle of a on a circle of radius r deviates from it by
+        // r * (1 - cos(a / 2)).
+        const double r = std::max(e.rx, e.ry);
+        const double maxAngle = tolerance < r ? 2 * std::acos(1 - tolerance / r) : 3.14159265;
+        const int n = segments(std::abs(e.deltaTheta) / maxAngle);
+        const double step = e.deltaTheta / n;
+
+        // Rotate the unit vector by `step` for every point instead of calling cos and sin, and
+        // resynchronize at the start of every batch to keep the error from accumulating.
+        const double cosStep = std::cos(step);
+        const double sinStep = std::sin(step);
+        const double xx = e.rx * e.cosPhi, xy = -e.ry * e.sinPhi;
+        const double yx = e.rx * e.sinPhi, yy = e.ry * e.cosPhi;
+
+        double cosTheta[batchSize], sinTheta[batchSize];
+        double px[batchSize], py[batchSize];
+        for (int i = 1; i < n; i += batchSize) {
+            const double theta = e.theta1 + i * step;
+            cosTheta[0] = std::cos(theta);
+            sinTheta[0] = std::sin(theta);
+            for (int k = 1; k < batchSize; ++k) {
+                cosTheta[k] = cosTheta[k - 1] * cosStep - sinTheta[k - 1] * sinStep;
+                sinTheta[k] = sinTheta[k - 1] * cosStep + cosTheta[k - 1] * sinStep;
+            }
+            for (int k = 0; k < batchSize; ++k) {
+                px[k] = e.cx + xx * cosTheta[k] + xy * sinTheta[k];
+                py[k] = e.cy + yx * cosTheta[k] + yy * sinTheta[k];
+            }
+            emit(px, py, std::min(batchSize, n - i));
+        }
+        lineTo(x_, y_);
+    }
+
+private:
+    static constexpr int batchSize = 8;
+
+    // Caps the segment count so that a degenerate tolerance can't stall the flattener.
+    static int segments(const double n) {
+        if (!(n > 1)) {
+            return 1;
+        }
+        return n < 65536 ? int(std::ceil(n)) : 65536;
+    }
+
+    void emit(const double* px, const double* py, const int count) {
+        for (int k = 0; k < count; ++k) {
+            t.lineTo(px[k], py[k]);
+        }
+    }
+
+private:
+    LineReceiver& t;
+    const double tolerance;
+    double x, y;
+    double startX, startY;
+};
+
+template <typename LineReceiver>
+constexpr int PathFlattener<LineReceiver>::batchSize;
+
+} // namespace svg
+} // namespace mapbox
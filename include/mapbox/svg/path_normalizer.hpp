@@ -0,0 +1,173 @@
+#pragma once
+
+namespace mapbox {
+namespace svg {
+
+// Adapter between PathParser and a receiver that only deals with absolute coordinates and a
+// reduced set of commands. It resolves relative coordinates, turns horizontal and vertical lines
+// into lines, and reflects the control points of smooth curves.
+//
+// Interface:
+//
+// struct NormalizedReceiver {
+//     void moveTo(double x, double y);
+//     void closePath();
+//     void lineTo(double x, double y);
+//     void curveTo(double x1, double y1, double x2, double y2, double x, double y);
+//     void quadraticCurveTo(double x1, double y1, double x, double y);
+//     void arc(double rx, double ry, double xAxisRotation, bool largeArcFlag, bool sweepFlag, double x, double y);
+// };
+//
+//
+// Usage:
+//
+// NormalizedReceiver receiver;
+// mapbox::svg::PathNormalizer<NormalizedReceiver> normalizer(receiver);
+// mapbox::svg::PathParser<mapbox::svg::PathNormalizer<NormalizedReceiver>> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+//
+// The coordinate pairs after the first one of a moveto are passed on as lines, as SVG defines.
+
+template <typename NormalizedReceiver>
+class PathNormalizer {
+public:
+    PathNormalizer(NormalizedReceiver& t_) : t(t_) {
+        reset();
+    }
+    PathNormalizer(const PathNormalizer&) = delete;
+    PathNormalizer(PathNormalizer&&) = delete;
+
+    // Forgets the current point before parsing another path.
+    void reset() {
+        x = y = 0;
+        startX = startY = 0;
+        controlX = controlY = 0;
+        previous = Previous::None;
+    }
+
+    void moveTo(double x_, double y_, bool relative) {
+        resolve(x_, y_, relative);
+        x = startX = x_;
+        y = startY = y_;
+        previous = Previous::None;
+        t.moveTo(x, y);
+    }
+
+    void implicitLineTo(double x_, double y_, bool relative) {
+        lineTo(x_, y_, relative);
+    }
+
+    void closePath() {
+        x = startX;
+        y = startY;
+        previous = Previous::None;
+        t.closePath();
+    }
+
+    void lineTo(double x_, double y_, bool relative) {
+        resolve(x_, y_, relative);
+        line(x_, y_);
+    }
+
+    void horizontalLineTo(double x_, bool relative) {
+        line(relative ? x + x_ : x_, y);
+    }
+
+    void verticalLineTo(double y_, bool relative) {
+        line(x, relative ? y + y_ : y_);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x_, double y_, bool relative) {
+        resolve(x1, y1, relative);
+        resolve(x2, y2, relative);
+        resolve(x_, y_, relative);
+        cubic(x1, y1, x2, y2, x_, y_);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x_, double y_, bool relative) {
+        resolve(x2, y2, relative);
+        resolve(x_, y_, relative);
+        if (previous == Previous::Cubic) {
+            cubic(2 * x - controlX, 2 * y - controlY, x2, y2, x_, y_);
+        } else {
+            cubic(x, y, x2, y2, x_, y_);
+        }
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x_, double y_, bool relative) {
+        resolve(x1, y1, relative);
+        resolve(x_, y_, relative);
+        quadratic(x1, y1, x_, y_);
+    }
+
+    void smoothQuadraticCurveTo(double x_, double y_, bool relative) {
+        resolve(x_, y_, relative);
+        if (previous == Previous::Quadratic) {
+            quadratic(2 * x - controlX, 2 * y - controlY, x_, y_);
+        } else {
+            quadratic(x, y, x_, y_);
+        }
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x_,
+             double y_,
+             bool relative) {
+        resolve(x_, y_, relative);
+        x = x_;
+        y = y_;
+        previous = Previous::None;
+        t.arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y);
+    }
+
+private:
+    void resolve(double& px, double& py, const bool relative) const {
+        if (relative) {
+            px += x;
+            py += y;
+        }
+    }
+
+    void line(const double x_, const double y_) {
+        x = x_;
+        y = y_;
+        previous = Previous::None;
+        t.lineTo(x, y);
+    }
+
+    void cubic(double x1, double y1, double x2, double y2, double x_, double y_) {
+        x = x_;
+        y = y_;
+        controlX = x2;
+        controlY = y2;
+        previous = Previous::Cubic;
+        t.curveTo(x1, y1, x2, y2, x, y);
+    }
+
+    void quadratic(double x1, double y1, double x_, double y_) {
+        x = x_;
+        y = y_;
+        controlX = x1;
+        controlY = y1;
+        previous = Previous::Quadratic;
+        t.quadraticCurveTo(x1, y1, x, y);
+    }
+
+private:
+    NormalizedReceiver& t;
+
+    // The current point and the start of the current subpath.
+    double x, y;
+    double startX, startY;
+
+    // The last control point of the previous command, if it was a curve of the given kind.
+    double controlX, controlY;
+    enum class Previous { None, Cubic, Quadratic } previous;
+};
+
+} // namespace svg
+} // namespace mapbox
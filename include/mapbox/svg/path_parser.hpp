@@ -1,8 +1,13 @@
 #pragma once
 
-#include <cstdlib>
-#include <cctype>
-#include <cmath>
+#include <mapbox/svg/fixed_point.hpp>
+#include <mapbox/svg/number_parser.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace mapbox {
 namespace svg {
@@ -14,10 +19,416 @@ enum class PathParseErrorType {
     CommandParsing,
 };
 
+namespace detail {
+
+// Converts to any parameter type, to ask whether a receiver has a method whatever types it takes.
+struct AnyArgument {
+    template <typename T>
+    operator T() const;
+};
+
+// Accepted only by parameters that take any type, such as those of a template.
+struct UnrelatedArgument {};
+
+template <typename...>
+struct MakeVoid {
+    using type = void;
+};
+
+// The receiver methods, as types that call them and that name them in a class `P`.
+struct MoveToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.moveTo(args...)) {
+        return r.moveTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::moveTo);
+};
+
+struct ImplicitLineToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.implicitLineTo(args...)) {
+        return r.implicitLineTo(args...);
+    }
+};
+
+struct ClosePathMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.closePath(args...)) {
+        return r.closePath(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::closePath);
+};
+
+struct LineToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.lineTo(args...)) {
+        return r.lineTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::lineTo);
+};
+
+struct HorizontalLineToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.horizontalLineTo(args...)) {
+        return r.horizontalLineTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::horizontalLineTo);
+};
+
+struct VerticalLineToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.verticalLineTo(args...)) {
+        return r.verticalLineTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::verticalLineTo);
+};
+
+struct CurveToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.curveTo(args...)) {
+        return r.curveTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::curveTo);
+};
+
+struct SmoothCurveToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.smoothCurveTo(args...)) {
+        return r.smoothCurveTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::smoothCurveTo);
+};
+
+struct QuadraticCurveToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.quadraticCurveTo(args...)) {
+        return r.quadraticCurveTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::quadraticCurveTo);
+};
+
+struct SmoothQuadraticCurveToMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.smoothQuadraticCurveTo(args...)) {
+        return r.smoothQuadraticCurveTo(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::smoothQuadraticCurveTo);
+};
+
+struct ArcMethod {
+    template <typename R, typename... Args>
+    static auto call(R& r, const Args&... args) -> decltype(r.arc(args...)) {
+        return r.arc(args...);
+    }
+
+    template <typename P>
+    static auto name(int) -> decltype(&P::arc);
+};
+
+template <typename Method, typename Receiver, typename Arguments, typename = void>
+struct IsCallable : std::false_type {};
+
+template <typename Method, typename Receiver, typename... Arguments>
+struct IsCallable<Method,
+                  Receiver,
+                  std::tuple<Arguments...>,
+                  typename MakeVoid<decltype(Method::call(std::declval<Receiver&>(),
+                                                          std::declval<Arguments>()...))>::type>
+    : std::true_type {};
+
+// Has every member name of the receiver methods, so that in a class that derives from this and a
+// receiver, those that the receiver has too are ambiguous.
+struct MethodNames {
+    int moveTo, implicitLineTo, closePath, lineTo, horizontalLineTo, verticalLineTo, curveTo,
+        smoothCurveTo, quadraticCurveTo, smoothQuadraticCurveTo, arc;
+};
+
+template <typename Receiver>
+struct NameProbe : Receiver, MethodNames {};
+
+template <typename Method, typename Probe, typename = void>
+struct IsAmbiguous : std::true_type {};
+
+template <typename Method, typename Probe>
+struct IsAmbiguous<Method,
+                   Probe,
+                   typename MakeVoid<decltype(Method::template name<Probe>(0))>::type>
+    : std::false_type {};
+
+// Whether the receiver has a member with the name of `Method`, whatever it is: overloads and
+// templates included. Final classes can't be probed, and count as having none.
+template <typename Method, typename Receiver>
+using HasName = IsAmbiguous<
+    Method,
+    typename std::conditional<std::is_class<Receiver>::value && !std::is_final<Receiver>::value,
+                              NameProbe<Receiver>,
+                              MethodNames>::type>;
+
+template <std::size_t Index, typename T, typename Other, std::size_t... I>
+std::tuple<typename std::conditional<I == Index, T, Other>::type...> argumentList(
+    std::index_sequence<I...>);
+
+// `Arity` arguments of type `Other`, but for the one at `Index`, of type `T`.
+template <std::size_t Arity, std::size_t Index, typename T, typename Other = AnyArgument>
+using ArgumentList = decltype(argumentList<Index, T, Other>(std::make_index_sequence<Arity>()));
+
+// How PathParser passes a command with `Arity` arguments, the relative flag included, to a
+// receiver: to `Method` if the receiver has it, or else, if `Fallback` is set, as a lineTo to the
+// endpoint, or else not at all. Arguments that the receiver declares as UnconvertedNumber, and
+// those that are not passed on, are only checked against the grammar.
+template <typename Receiver,
+          typename Coordinate,
+          typename Method,
+          std::size_t Arity,
+          bool Fallback = true>
+struct Route {
+    template <typename M, std::size_t N>
+    using Has = std::integral_constant<
+        bool,
+        IsCallable<M, Receiver, ArgumentList<N, N, AnyArgument>>::value ||
+            IsCallable<M, Receiver, ArgumentList<N, N, AnyArgument, Coordinate>>::value>;
+
+    // Only a parameter of type UnconvertedNumber is left unconverted, not one that takes
+    // anything.
+    template <typename M, std::size_t N, std::size_t Index>
+    using Converted = typename std::conditional<
+        IsCallable<M, Receiver, ArgumentList<N, Index, UnconvertedNumber>>::value &&
+            !IsCallable<M, Receiver, ArgumentList<N, Index, UnrelatedArgument>>::value,
+        UnconvertedNumber,
+        Coordinate>::type;
+
+    static constexpr bool direct = Has<Method, Arity>::value;
+    static constexpr bool line = !direct && Fallback && Has<LineToMethod, 3>::value;
+
+    // The type to parse the argument at `Index` into; `LineIndex` is its position in a lineTo,
+    // for the endpoint.
+    template <std::size_t Index, std::size_t LineIndex = 2>
+    using Argument = typename std::conditional<
+        direct,
+        Converted<Method, Arity, Index>,
+        typename std::conditional<line && LineIndex < 2,
+                                  Converted<LineToMethod, 3, LineIndex < 2 ? LineIndex : 0>,
+                                  UnconvertedNumber>::type>::type;
+
+    template <typename X, typename Y, typename... Arguments>
+    static void send(Receiver& r, const X& x, const Y& y, const Arguments&... arguments) {
+        send(std::integral_constant<int, direct ? 0 : line ? 1 : 2>(), r, x, y, arguments...);
+    }
+
+private:
+    template <typename X, typename Y, typename... Arguments>
+    static void send(std::integral_constant<int, 0>,
+                     Receiver& r,
+                     const X&,
+                     const Y&,
+                     const Arguments&... arguments) {
+        Method::call(r, arguments...);
+    }
+
+    template <typename X, typename Y, typename... Arguments>
+    static void send(std::integral_constant<int, 1>,
+                     Receiver& r,
+                     const X& x,
+                     const Y& y,
+                     const Arguments&... arguments) {
+        // The relative flag comes last.
+        LineToMethod::call(r, x, y, std::get<sizeof...(Arguments) - 1>(std::tie(arguments...)));
+    }
+
+    template <typename X, typename Y, typename... Arguments>
+    static void send(std::integral_constant<int, 2>, Receiver&, const X&, const Y&,
+                     const Arguments&...) {
+    }
+};
+
+// Whether the receiver's members with the name of `Method`, if any, take its `Arity` arguments.
+template <typename Receiver, typename Coordinate, typename Method, std::size_t Arity>
+using MatchesName =
+    std::integral_constant<bool,
+                           !HasName<Method, Receiver>::value ||
+                               Route<Receiver, Coordinate, Method, Arity>::direct>;
+
+// Whether every member of the receiver that is named like a receiver method can be called as one.
+// Otherwise, the commands of a method with the wrong parameters would silently become lines or be
+// dropped. `implicitLineTo` isn't checked: filters such as PathTransform declare it as a template
+// that only works when the next receiver has it too.
+template <typename Receiver, typename Coordinate>
+struct HasMatchingMethods
+    : std::integral_constant<
+          bool,
+          MatchesName<Receiver, Coordinate, MoveToMethod, 3>::value &&
+              MatchesName<Receiver, Coordinate, ClosePathMethod, 0>::value &&
+              MatchesName<Receiver, Coordinate, LineToMethod, 3>::value &&
+              MatchesName<Receiver, Coordinate, HorizontalLineToMethod, 2>::value &&
+              MatchesName<Receiver, Coordinate, VerticalLineToMethod, 2>::value &&
+              MatchesName<Receiver, Coordinate, CurveToMethod, 7>::value &&
+              MatchesName<Receiver, Coordinate, SmoothCurveToMethod, 5>::value &&
+              MatchesName<Receiver, Coordinate, QuadraticCurveToMethod, 5>::value &&
+              MatchesName<Receiver, Coordinate, SmoothQuadraticCurveToMethod, 3>::value &&
+              MatchesName<Receiver, Coordinate, ArcMethod, 8>::value> {};
+
+// Passes on an argument that is already converted, or an UnconvertedNumber if that is what the
+// receiver takes.
+template <typename Argument>
+struct Pass {
+    template <typename T>
+    static const T& value(const T& v) {
+        return v;
+    }
+};
+
+template <>
+struct Pass<UnconvertedNumber> {
+    template <typename T>
+    static UnconvertedNumber value(const T&) {
+        return {};
+    }
+};
+
+// Sends commands with arguments that are already converted to `Coordinate`, such as stored or
+// incrementally parsed ones, on the same routes as PathParser.
+template <typename Receiver, typename Coordinate>
+struct Dispatch {
+    template <typename Method, std::size_t Arity, bool Fallback = true>
+    using R = Route<Receiver, Coordinate, Method, Arity, Fallback>;
+
+    template <typename Q, std::size_t Index, std::size_t LineIndex = 2>
+    using P = Pass<typename Q::template Argument<Index, LineIndex>>;
+
+    using MoveTo = R<MoveToMethod, 3, false>;
+    // The coordinate pairs after the first one of a moveto.
+    using ImplicitLineTo =
+        typename std::conditional<R<ImplicitLineToMethod, 3, false>::direct,
+                                  R<ImplicitLineToMethod, 3, false>,
+                                  MoveTo>::type;
+
+    static_assert(MoveTo::direct, "VertexReceiver needs moveTo(x, y, relative)");
+    static_assert(HasMatchingMethods<Receiver, Coordinate>::value,
+                  "A VertexReceiver method has parameters that don't match its name");
+    static_assert(!R<LineToMethod, 3>::direct || (R<HorizontalLineToMethod, 2>::direct &&
+                                                  R<VerticalLineToMethod, 2>::direct),
+                  "A VertexReceiver with lineTo needs horizontalLineTo and verticalLineTo");
+
+    static void moveTo(Receiver& r, const Coordinate& x, const Coordinate& y, const bool relative) {
+        pair<MoveTo>(r, x, y, relative);
+    }
+
+    static void implicitLineTo(Receiver& r,
+                               const Coordinate& x,
+                               const Coordinate& y,
+                               const bool relative) {
+        pair<ImplicitLineTo>(r, x, y, relative);
+    }
+
+    static void closePath(Receiver& r) {
+        R<ClosePathMethod, 0, false>::send(r, UnconvertedNumber(), UnconvertedNumber());
+    }
+
+    static void lineTo(Receiver& r, const Coordinate& x, const Coordinate& y, const bool relative) {
+        pair<R<LineToMethod, 3>>(r, x, y, relative);
+    }
+
+    static void horizontalLineTo(Receiver& r, const Coordinate& x, const bool relative) {
+        using Q = R<HorizontalLineToMethod, 2, false>;
+        Q::send(r, x, x, P<Q, 0>::value(x), relative);
+    }
+
+    static void verticalLineTo(Receiver& r, const Coordinate& y, const bool relative) {
+        using Q = R<VerticalLineToMethod, 2, false>;
+        Q::send(r, y, y, P<Q, 0>::value(y), relative);
+    }
+
+    static void curveTo(Receiver& r,
+                        const Coordinate& x1,
+                        const Coordinate& y1,
+                        const Coordinate& x2,
+                        const Coordinate& y2,
+                        const Coordinate& x,
+                        const Coordinate& y,
+                        const bool relative) {
+        using Q = R<CurveToMethod, 7>;
+        Q::send(r, P<Q, 4, 0>::value(x), P<Q, 5, 1>::value(y), P<Q, 0>::value(x1),
+                P<Q, 1>::value(y1), P<Q, 2>::value(x2), P<Q, 3>::value(y2), P<Q, 4, 0>::value(x),
+                P<Q, 5, 1>::value(y), relative);
+    }
+
+    static void smoothCurveTo(Receiver& r,
+                              const Coordinate& x2,
+                              const Coordinate& y2,
+                              const Coordinate& x,
+                              const Coordinate& y,
+                              const bool relative) {
+        using Q = R<SmoothCurveToMethod, 5>;
+        Q::send(r, P<Q, 2, 0>::value(x), P<Q, 3, 1>::value(y), P<Q, 0>::value(x2),
+                P<Q, 1>::value(y2), P<Q, 2, 0>::value(x), P<Q, 3, 1>::value(y), relative);
+    }
+
+    static void quadraticCurveTo(Receiver& r,
+                                 const Coordinate& x1,
+                                 const Coordinate& y1,
+                                 const Coordinate& x,
+                                 const Coordinate& y,
+                                 const bool relative) {
+        using Q = R<QuadraticCurveToMethod, 5>;
+        Q::send(r, P<Q, 2, 0>::value(x), P<Q, 3, 1>::value(y), P<Q, 0>::value(x1),
+                P<Q, 1>::value(y1), P<Q, 2, 0>::value(x), P<Q, 3, 1>::value(y), relative);
+    }
+
+    static void smoothQuadraticCurveTo(Receiver& r,
+                                       const Coordinate& x,
+                                       const Coordinate& y,
+                                       const bool relative) {
+        pair<R<SmoothQuadraticCurveToMethod, 3>>(r, x, y, relative);
+    }
+
+    static void arc(Receiver& r,
+                    const Coordinate& rx,
+                    const Coordinate& ry,
+                    const Coordinate& xAxisRotation,
+                    const bool largeArcFlag,
+                    const bool sweepFlag,
+                    const Coordinate& x,
+                    const Coordinate& y,
+                    const bool relative) {
+        using Q = R<ArcMethod, 8>;
+        Q::send(r, P<Q, 5, 0>::value(x), P<Q, 6, 1>::value(y), P<Q, 0>::value(rx),
+                P<Q, 1>::value(ry), P<Q, 2>::value(xAxisRotation), largeArcFlag, sweepFlag,
+                P<Q, 5, 0>::value(x), P<Q, 6, 1>::value(y), relative);
+    }
+
+private:
+    template <typename Q>
+    static void pair(Receiver& r, const Coordinate& x, const Coordinate& y, const bool relative) {
+        Q::send(r, P<Q, 0, 0>::value(x), P<Q, 1, 1>::value(y), P<Q, 0, 0>::value(x),
+                P<Q, 1, 1>::value(y), relative);
+    }
+};
+
+} // namespace detail
+
 // Interface:
 // 
 // struct VertexReceiver {
 //     void moveTo(double x, double y, bool relative);
+//     void implicitLineTo(double x, double y, bool relative);
 //     void closePath();
 //     void lineTo(double x, double y, bool relative);
 //     void horizontalLineTo(double x, bool relative);
@@ -29,14 +440,46 @@ enum class PathParseErrorType {
 //     void arc(double rx, double ry, double xAxisRotation, bool largeArcFlag, bool sweepFlag, double x, double y, bool relative);
 // };
 //
+// The coordinate pairs after the first one of a moveto are implicit linetos. They go to
+// `implicitLineTo` if the receiver has it, and otherwise to `moveTo`, as they are written; any
+// receiver that deals with geometry rather than syntax wants `implicitLineTo`.
+//
+// Only `moveTo` is required; the parser finds out at compile time which of the others a receiver
+// has. Curves and arcs that a receiver has no method for become a `lineTo` to their endpoint, and
+// the other commands it has no method for are dropped. A member with the name of one of these
+// methods but `implicitLineTo` that can't be called with its arguments, e.g. one with a parameter
+// missing, fails a static_assert; a method with a misspelled name counts as missing, so its
+// curves become lines. A receiver with `lineTo` needs `horizontalLineTo` and `verticalLineTo` too,
+// since those can't become a `lineTo` without the current point. Arguments declared as
+// `UnconvertedNumber`, and those of commands that aren't passed on, are checked against the
+// grammar but never converted; template parameters get coordinates:
+//
+// struct EndpointReceiver {
+//     void moveTo(double x, double y, bool relative);
+//     void lineTo(double x, double y, bool relative);
+//     void horizontalLineTo(double x, bool relative);
+//     void verticalLineTo(double y, bool relative);
+//     void curveTo(UnconvertedNumber, UnconvertedNumber, UnconvertedNumber, UnconvertedNumber,
+//                  double x, double y, bool relative);
+// };
+//
 //
 // Usage:
 // 
 // VertexReceiver receiver;
 // mapbox::svg::PathParser<VertexReceiver> parser(receiver);
 // parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+//
+// The input doesn't have to be NUL-terminated: `parser(data, length)` (or any string type with
+// `data()` and `size()`) never reads past `data + length`, and `errorOffset()` is relative to
+// `data`.
+//
+// Coordinates are `double` by default. `PathParser<VertexReceiver, float>` and
+// `PathParser<VertexReceiver, FixedPoint<8>>` pass `float` or fixed-point values to the receiver
+// instead, converted directly from the text: floats are correctly rounded, not rounded twice via
+// double, and fixed-point numbers never go through floating point.
 
-template <typename VertexReceiver>
+template <typename VertexReceiver, typename Coordinate = double>
 class PathParser {
 public:
     PathParser(VertexReceiver& t_) : t(t_) {
@@ -45,94 +488,147 @@ public:
     PathParser(PathParser&&) = delete;
 
     bool operator()(const char* str) {
+        return (*this)(str, std::strlen(str));
+    }
+
+    template <typename String>
+    auto operator()(const String& str) -> decltype(str.data(), str.size(), bool()) {
+        return (*this)(str.data(), str.size());
+    }
+
+    bool operator()(const char* str, std::size_t length) {
         begin = str;
         cursor = str;
+        end = str + length;
         error = PathParseErrorType::None;
-        next = nullptr;
 
         char command;
-        double x, y, x1, y1, x2, y2, xAxisRotation;
-        bool relative, largeArcFlag, sweepFlag;
+        bool relative, implicit;
 
         skipWhitespace();
-        while (*cursor) {
+        while (cursor != end) {
             command = *cursor++;
             relative = command >= 'a';
+            implicit = false;
             skipWhitespace();
 
             if (command == 'Z' || command == 'z') { // closepath
                 skipWhitespace();
-                t.closePath();
+                Route<detail::ClosePathMethod, 0, false>::send(t, UnconvertedNumber(),
+                                                                UnconvertedNumber());
                 continue;
             }
 
             do {
                 switch (command) {
-                    case '\0':
+                    case 'M': case 'm': // moveto, then implicit linetos
+                        if (!(implicit ? parsePair<ImplicitLineTo>(relative)
+                                       : parsePair<MoveTo>(relative))) {
+                            return false;
+                        }
+                        implicit = true;
                         break;
-                    case 'M': case 'm': // moveto
+                    case 'L': case 'l': { // lineto
+                        using R = Route<detail::LineToMethod, 3>;
+                        Argument<R, 0, 0> x;
+                        Argument<R, 1, 1> y;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.moveTo(x, y, relative);
+                        R::send(t, x, y, x, y, relative);
                         break;
-                    case 'L': case 'l': // lineto
+                    }
+                    case 'H': case 'h': { // horizontal lineto
+                        using R = Route<detail::HorizontalLineToMethod, 2, false>;
+                        Argument<R, 0> x;
                         if (!parseNumber(x)) return false;
-                        if (!parseNumber(y)) return false;
-                        t.lineTo(x, y, relative);
+                        R::send(t, x, x, x, relative);
                         break;
-                    case 'H': case 'h': // horizontal lineto
-                        if (!parseNumber(x)) return false;
-                        t.horizontalLineTo(x, relative);
-                        break;
-                    case 'V': case 'v': // vertical lineto
+                    }
+                    case 'V': case 'v': { // vertical lineto
+                        using R = Route<detail::VerticalLineToMethod, 2, false>;
+                        Argument<R, 0> y;
                         if (!parseNumber(y)) return false;
-                        t.verticalLineTo(y, relative);
+                        R::send(t, y, y, y, relative);
                         break;
-                    case 'C': case 'c': // curveto
+                    }
+                    case 'C': case 'c': { // curveto
+                        using R = Route<detail::CurveToMethod, 7>;
+                        Argument<R, 0> x1;
+                        Argument<R, 1> y1;
+                        Argument<R, 2> x2;
+                        Argument<R, 3> y2;
+                        Argument<R, 4, 0> x;
+                        Argument<R, 5, 1> y;
                         if (!parseNumber(x1)) return false;
                         if (!parseNumber(y1)) return false;
                         if (!parseNumber(x2)) return false;
                         if (!parseNumber(y2)) return false;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.curveTo(x1, y1, x2, y2, x, y, relative);
+                        R::send(t, x, y, x1, y1, x2, y2, x, y, relative);
                         break;
-                    case 'S': case 's': // smooth curveto
+                    }
+                    case 'S': case 's': { // smooth curveto
+                        using R = Route<detail::SmoothCurveToMethod, 5>;
+                        Argument<R, 0> x2;
+                        Argument<R, 1> y2;
+                        Argument<R, 2, 0> x;
+                        Argument<R, 3, 1> y;
                         if (!parseNumber(x2)) return false;
                         if (!parseNumber(y2)) return false;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.smoothCurveTo(x2, y2, x, y, relative);
+                        R::send(t, x, y, x2, y2, x, y, relative);
                         break;
-                    case 'Q': case 'q': // quadratic bezier curveto
+                    }
+                    case 'Q': case 'q': { // quadratic bezier curveto
+                        using R = Route<detail::QuadraticCurveToMethod, 5>;
+                        Argument<R, 0> x1;
+                        Argument<R, 1> y1;
+                        Argument<R, 2, 0> x;
+                        Argument<R, 3, 1> y;
                         if (!parseNumber(x1)) return false;
                         if (!parseNumber(y1)) return false;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.quadraticCurveTo(x1, y1, x, y, relative);
+                        R::send(t, x, y, x1, y1, x, y, relative);
                         break;
-                    case 'T': case 't': // smooth quadratic bezier curveto
+                    }
+                    case 'T': case 't': { // smooth quadratic bezier curveto
+                        using R = Route<detail::SmoothQuadraticCurveToMethod, 3>;
+                        Argument<R, 0, 0> x;
+                        Argument<R, 1, 1> y;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.smoothQuadraticCurveTo(x, y, relative);
+                        R::send(t, x, y, x, y, relative);
                         break;
-                    case 'A': case 'a': // elliptical arc
-                        if (!parseNumber(x1)) return false;
-                        if (!parseNumber(y1)) return false;
+                    }
+                    case 'A': case 'a': { // elliptical arc
+                        using R = Route<detail::ArcMethod, 8>;
+                        Argument<R, 0> rx;
+                        Argument<R, 1> ry;
+                        Argument<R, 2> xAxisRotation;
+                        bool largeArcFlag, sweepFlag;
+                        Argument<R, 5, 0> x;
+                        Argument<R, 6, 1> y;
+                        if (!parseNumber(rx)) return false;
+                        if (!parseNumber(ry)) return false;
                         if (!parseNumber(xAxisRotation)) return false;
                         if (!parseFlag(largeArcFlag)) return false;
                         if (!parseFlag(sweepFlag)) return false;
                         if (!parseNumber(x)) return false;
                         if (!parseNumber(y)) return false;
-                        t.arc(x1, y1, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative);
+                        R::send(t, x, y, rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y,
+                                relative);
                         break;
+                    }
                     default:
                         error = PathParseErrorType::CommandParsing;
                         return false;
 
                 }
                 // parse another instance of this command if there are more numbers
-            } while ((*cursor >= '0' && *cursor <= '9') || *cursor == '.' || *cursor == '-');
+            } while (cursor != end && detail::isNumberStart(*cursor));
         }
         return true;
     }
@@ -150,23 +646,42 @@ public:
     }
 
 private:
-    bool parseNumber(double& value) {
-        if (*cursor) {
-            value = strtod(cursor, &next);
-            if (cursor != next && value != HUGE_VAL) {
-                cursor = next;
-                skipSeparator();
-                return true;
-            }
+    template <typename Method, std::size_t Arity, bool Fallback = true>
+    using Route = detail::Route<VertexReceiver, Coordinate, Method, Arity, Fallback>;
+
+    template <typename R, std::size_t Index, std::size_t LineIndex = 2>
+    using Argument = typename R::template Argument<Index, LineIndex>;
+
+    // Dispatch also checks that the receiver has the methods it needs.
+    using MoveTo = typename detail::Dispatch<VertexReceiver, Coordinate>::MoveTo;
+    using ImplicitLineTo = typename detail::Dispatch<VertexReceiver, Coordinate>::ImplicitLineTo;
+
+    template <typename R>
+    bool parsePair(const bool relative) {
+        Argument<R, 0, 0> x;
+        Argument<R, 1, 1> y;
+        if (!parseNumber(x)) return false;
+        if (!parseNumber(y)) return false;
+        R::send(t, x, y, x, y, relative);
+        return true;
+    }
+
+    template <typename Number>
+    bool parseNumber(Number& value) {
+        const char* next = detail::CoordinateTraits<Number>::parse(cursor, end, value);
+        if (next != cursor && !detail::CoordinateTraits<Number>::isOverflow(value)) {
+            cursor = next;
+            skipSeparator();
+            return true;
         }
         error = PathParseErrorType::NumberParsing;
         return false;
     }
 
     bool parseFlag(bool& value) {
-        if (*cursor == '0') {
+        if (cursor != end && *cursor == '0') {
             value = false;
-        } else if (*cursor == '1') {
+        } else if (cursor != end && *cursor == '1') {
             value = true;
         } else {
             error = PathParseErrorType::FlagParsing;
@@ -178,12 +693,18 @@ private:
     }
 
     void skipWhitespace() {
-        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') ++cursor;
+        // Most separators are a single character; only longer runs go to the vector scanner.
+        if (cursor != end && detail::isWhitespace(*cursor)) {
+            ++cursor;
+            if (cursor != end && detail::isWhitespace(*cursor)) {
+                cursor = detail::skipWhitespace(cursor + 1, end);
+            }
+        }
     }
 
     void skipSeparator() {
         skipWhitespace();
-        if (*cursor == ',') ++cursor;
+        if (cursor != end && *cursor == ',') ++cursor;
         skipWhitespace();
     }
 
@@ -191,7 +712,7 @@ private:
     VertexReceiver& t;
     const char* begin;
     const char* cursor;
-    char* next;
+    const char* end;
     PathParseErrorType error;
 };
 
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <mapbox/svg/char_scan.hpp>
+#include <mapbox/svg/fill_rule.hpp>
+#include <mapbox/svg/worker_threads.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+struct RasterOptions {
+    FillRule fillRule = FillRule::NonZero;
+
+    // Size of the square tiles that the canvas is split into. Each tile is rendered on its own,
+    // with a scratch buffer that stays in cache.
+    unsigned tileSize = 64;
+
+    // Number of threads for the tiles, or 0 for the number of cores.
+    unsigned threads = 0;
+};
+
+namespace detail {
+
+struct RasterLine {
+    double x0, y0, x1, y1;
+};
+
+// Adds the signed area that a line covers to the right of it, in every pixel row of `rows` rows
+// of `stride` floats. The line is within 0 <= x <= width, and writes up to column width + 1.
+inline void accumulateLine(float* const cells,
+                           const std::size_t stride,
+                           const unsigned rows,
+                           const float width,
+                           float x0,
+                           float y0,
+                           float x1,
+                           float y1) {
+    if (y0 == y1) {
+        return;
+    }
+    float direction = 1;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        direction = -1;
+    }
+    const float top = std::max(y0, 0.0f), bottom = std::min(y1, float(rows));
+    // Also skips lines with a NaN coordinate, which have no row to start at.
+    if (!(top < bottom)) {
+        return;
+    }
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    float x = std::min(width, std::max(0.0f, x0 + (top - y0) * dxdy));
+    for (unsigned row = unsigned(top); row < bottom; ++row) {
+        const float rowBottom = std::min(float(row + 1), bottom);
+        const float d = (rowBottom - std::max(float(row), top)) * direction;
+        const float next = std::min(width, std::max(0.0f, x0 + (rowBottom - y0) * dxdy));
+        float* const line = cells + row * stride;
+        const float left = std::min(x, next), right = std::max(x, next);
+        const float leftFloor = std::floor(left);
+        const int first = int(leftFloor), last = int(std::ceil(right));
+        if (last <= first + 1) {
+            // Within one pixel: the part to the right of the line's middle.
+            const float middle = 0.5f * (x + next) - leftFloor;
+            line[first] += d - d * middle;
+            line[first + 1] += d * middle;
+        } else {
+            // Across pixels: a triangle in the first and last, and equal steps in between.
+            const float step = 1 / (right - left);
+            const float leftFraction = left - leftFloor;
+            const float a0 = 0.5f * step * (1 - leftFraction) * (1 - leftFraction);
+            const float rightFraction = right - float(last) + 1;
+            const float am = 0.5f * step * rightFraction * rightFraction;
+            line[first] += d * a0;
+            if (last == first + 2) {
+                line[first + 1] += d * (1 - a0 - am);
+            } else {
+                const float a1 = step * (1.5f - leftFraction);
+                line[first + 1] += d * (a1 - a0);
+                for (int i = first + 2; i < last - 1; ++i) {
+                    line[i] += d * step;
+                }
+                const float a2 = a1 + float(last - first - 3) * step;
+                line[last - 1] += d * (1 - a2 - am);
+            }
+            line[last] += d * am;
+        }
+        x = next;
+    }
+}
+
+// Adds the signed height that a line left of a tile covers in each of its `rows` rows.
+inline void accumulateCover(float* const cover, const unsigned rows, float y0, float y1) {
+    float direction = 1;
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        direction = -1;
+    }
+    const float top = std::max(y0, 0.0f), bottom = std::min(y1, float(rows));
+    if (!(top < bottom)) {
+        return;
+    }
+    for (unsigned row = unsigned(top); row < bottom; ++row) {
+        cover[row] += (std::min(float(row + 1), bottom) - std::max(float(row), top)) * direction;
+    }
+}
+
+inline float coverage(float area, const FillRule rule) {
+    area = std::abs(area);
+    if (rule == FillRule::EvenOdd) {
+        area -= 2 * std::floor(area * 0.5f);
+        return std::min(area, 2 - area);
+    }
+    return std::min(area, 1.0f);
+}
+
+// Sums a row of areas from the left into coverage, and writes it as `count` alpha bytes.
+inline void accumulateRow(const float* cells,
+                          uint8_t* alpha,
+                          const std::size_t count,
+                          const FillRule rule) {
+    std::size_t i = 0;
+    float sum = 0;
+#if defined(MAPBOX_SVG_AVX2) || defined(MAPBOX_SVG_SSE2)
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1), two = _mm_set1_ps(2), half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_set1_ps(255);
+    __m128 offset = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(cells + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_shuffle_ps(_mm_setzero_ps(), x, 0x40));
+        x = _mm_add_ps(x, offset);
+        offset = _mm_shuffle_ps(x, x, 0xFF);
+        __m128 y = _mm_andnot_ps(sign, x);
+        if (rule == FillRule::EvenOdd) {
+            // Truncation is the floor for the non-negative values.
+            const __m128 pairs = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(y, half)));
+            y = _mm_sub_ps(y, _mm_mul_ps(two, pairs));
+            y = _mm_min_ps(y, _mm_sub_ps(two, y));
+        } else {
+            y = _mm_min_ps(y, one);
+        }
+        const __m128i values = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y, scale), half));
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(values, values), values);
+        const int32_t packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(alpha + i, &packed, 4);
+    }
+    sum = _mm_cvtss_f32(offset);
+#elif defined(MAPBOX_SVG_NEON)
+    const float32x4_t zero = vdupq_n_f32(0);
+    float32x4_t offset = zero;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(cells + i);
+        x = vaddq_f32(x, vextq_f32(zero, x, 3));
+        x = vaddq_f32(x, vextq_f32(zero, x, 2));
+        x = vaddq_f32(x, offset);
+        offset = vdupq_laneq_f32(x, 3);
+        float32x4_t y = vabsq_f32(x);
+        if (rule == FillRule::EvenOdd) {
+            const float32x4_t pairs = vcvtq_f32_s32(vcvtq_s32_f32(vmulq_n_f32(y, 0.5f)));
+            y = vsubq_f32(y, vmulq_n_f32(pairs, 2));
+            y = vminq_f32(y, vsubq_f32(vdupq_n_f32(2), y));
+        } else {
+            y = vminq_f32(y, vdupq_n_f32(1));
+        }
+        const uint32x4_t values = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(y, 255), vdupq_n_f32(0.5f)));
+        const uint16x4_t shorts = vmovn_u32(values);
+        const uint8x8_t bytes = vmovn_u16(vcombine_u16(shorts, shorts));
+        const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+        std::memcpy(alpha + i, &packed, 4);
+    }
+    sum = vgetq_lane_f32(offset, 0);
+#endif
+    for (; i < count; ++i) {
+        sum += cells[i];
+        alpha[i] = uint8_t(coverage(sum, rule) * 255 + 0.5f);
+    }
+}
+
+} // namespace detail
+
+// LineReceiver (see PathFlattener) that collects a flattened path and renders its fill with
+// anti-aliasing into an 8-bit alpha buffer.
+//
+// Usage:
+//
+// mapbox::svg::PathRasterizer rasterizer;
+// mapbox::svg::PathFlattener<mapbox::svg::PathRasterizer> flattener(rasterizer, 0.1);
+// mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// std::vector<uint8_t> alpha(24 * 24);
+// rasterizer.rasterize(mapbox::svg::RasterOptions(), alpha.data(), 24, 24, 24);
+//
+// Coordinates are in pixels, so put a PathTransform in front to scale the path to the canvas.
+// Every subpath is closed for filling, as SVG does. Each pixel gets the area of it that the fill
+// covers: every line adds the signed area it covers in each row to the cell it crosses and
+// subtracts it after, so that the sums of a row from the left are the winding numbers, with
+// fractions at the edges. The sums are vectorized where the target allows.
+//
+// The canvas is rendered in tiles, each from the lines that pass through it. Lines left of a tile
+// still count, as vertical lines at its left side: their heights in each row are summed once per
+// row of tiles. Tiles are shared between threads.
+
+class PathRasterizer {
+public:
+    PathRasterizer() {
+        reset();
+    }
+    PathRasterizer(const PathRasterizer&) = delete;
+    PathRasterizer(PathRasterizer&&) = delete;
+
+    // Removes the path, keeping the allocated memory.
+    void reset() {
+        lines.clear();
+        x = y = startX = startY = 0;
+    }
+
+    // Number of lines collected, including the ones that close subpaths. Horizontal lines are
+    // left out.
+    std::size_t size() const {
+        return lines.size() + (y != startY);
+    }
+
+    void moveTo(double x_, double y_) {
+        close();
+        x = startX = x_;
+        y = startY = y_;
+    }
+
+    void closePath() {
+        close();
+    }
+
+    void lineTo(double x_, double y_) {
+        // Horizontal lines cover nothing.
+        if (y_ != y) {
+            lines.push_back({ x, y, x_, y_ });
+        }
+        x = x_;
+        y = y_;
+    }
+
+    // Writes the coverage of the `width` x `height` canvas at the origin into `alpha`, with
+    // `stride` bytes from one row to the next.
+    void rasterize(const RasterOptions& options,
+                   uint8_t* const alpha,
+                   const unsigned width,
+                   const unsigned height,
+                   const std::size_t stride) const {
+        const unsigned tileSize = std::max(1u, options.tileSize);
+        const unsigned columns = (width + tileSize - 1) / tileSize;
+        const unsigned bands = (height + tileSize - 1) / tileSize;
+        if (columns == 0 || bands == 0) {
+            return;
+        }
+
+        std::vector<detail::RasterLine> all(lines);
+        if (y != startY) {
+            all.push_back({ x, y, startX, startY });
+        }
+        if (columns * bands == 1) {
+            // A canvas of one tile needs neither the bins nor the heights of lines left of it.
+            std::vector<float> cells;
+            rasterizeTile(all, nullptr, all.size(), nullptr, options.fillRule, 0, 0, width, height,
+                          alpha, stride, cells);
+            return;
+        }
+
+        // Lines by the tiles they pass through, in compressed form: tile `t` holds
+        // `items[offsets[t]] .. items[offsets[t + 1] - 1]`. Where a line is left of the tiles of
+        // a band, `add` gets the first tile column to its right instead.
+        // Clamped before the conversion, which is undefined for huge and non-finite values.
+        const auto clampTile = [](const double v, const unsigned count) {
+            return !(v > 0) ? 0u : v < double(count) ? unsigned(v) : count;
+        };
+        const auto visitTiles = [&](const detail::RasterLine& l, auto add) {
+            const double minY = std::min(l.y0, l.y1), maxY = std::max(l.y0, l.y1);
+            if (!(maxY > 0 && minY < height && std::min(l.x0, l.x1) < width)) {
+                return;
+            }
+            const unsigned first = clampTile(minY / tileSize, bands - 1);
+            const unsigned last = clampTile(maxY / tileSize, bands - 1);
+            const double slope = (l.x1 - l.x0) / (l.y1 - l.y0);
+            // Keeps rounding from missing a tile that the line only touches.
+            const double margin = 1e-6 * tileSize;
+            for (unsigned band = first; band <= last; ++band) {
+                const double top = std::max(minY, double(band * tileSize));
+                const double bottom = std::min(maxY, double((band + 1) * tileSize));
+                const double xa = l.x0 + (top - l.y0) * slope, xb = l.x0 + (bottom - l.y0) * slope;
+                const double left = std::min(xa, xb) - margin, right = std::max(xa, xb) + margin;
+                const unsigned cover = clampTile(right / tileSize + 1, columns);
+                const unsigned column = clampTile(left / tileSize, columns);
+                for (unsigned c = column; c < cover; ++c) {
+                    add(band, c, false);
+                }
+                if (cover < columns) {
+                    add(band, cover, true);
+                }
+            }
+        };
+
+        std::vector<uint32_t> offsets(bands * columns + 1, 0);
+        std::vector<float> covers(std::size_t(bands) * columns * tileSize, 0.0f);
+        for (const detail::RasterLine& l : all) {
+            visitTiles(l, [&](const unsigned band, const unsigned column, const bool cover) {
+                if (cover) {
+                    detail::accumulateCover(
+                        covers.data() + (std::size_t(band) * columns + column) * tileSize,
+                        tileSize, float(l.y0 - band * tileSize), float(l.y1 - band * tileSize));
+                } else {
+                    ++offsets[band * columns + column + 1];
+                }
+            });
+        }
+        for (unsigned t = 0; t < bands * columns; ++t) {
+            offsets[t + 1] += offsets[t];
+        }
+        std::vector<uint32_t> items(offsets.back());
+        std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            visitTiles(all[i], [&](const unsigned band, const unsigned column, const bool cover) {
+                if (!cover) {
+                    items[next[band * columns + column]++] = uint32_t(i);
+                }
+            });
+        }
+        // The lines left of a tile add up over the tiles of a band.
+        for (unsigned band = 0; band < bands; ++band) {
+            float* const cover = covers.data() + std::size_t(band) * columns * tileSize;
+            for (std::size_t i = tileSize; i < std::size_t(columns) * tileSize; ++i) {
+                cover[i] += cover[i - tileSize];
+            }
+        }
+
+        std::atomic<unsigned> tiles(0);
+        const auto work = [&] {
+            std::vector<float> cells;
+            for (unsigned tile; (tile = tiles++) < columns * bands;) {
+                const unsigned left = tile % columns * tileSize, top = tile / columns * tileSize;
+                rasterizeTile(all, items.data() + offsets[tile], offsets[tile + 1] - offsets[tile],
+                              covers.data() + std::size_t(tile) * tileSize, options.fillRule,
+                              left, top, std::min(tileSize, width - left),
+                              std::min(tileSize, height - top), alpha + top * stride + left,
+                              stride, cells);
+            }
+        };
+
+        unsigned threads = options.threads;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, columns * bands);
+        const auto worker = [&](unsigned) { work(); };
+        detail::runOnThreads(threads, worker);
+    }
+
+private:
+    void close() {
+        if (y != startY) {
+            lines.push_back({ x, y, startX, startY });
+        }
+        x = startX;
+        y = startY;
+    }
+
+    // Renders the lines at `indices`, or all of them if it is null, and the heights in `cover`
+    // of the lines left of the tile, if any.
+    static void rasterizeTile(const std::vector<detail::RasterLine>& all,
+                              const uint32_t* const indices,
+                              const std::size_t count,
+                              const float* const cover,
+                              const FillRule rule,
+                              const unsigned left,
+                              const unsigned top,
+                              const unsigned width,
+                              const unsigned height,
+                              uint8_t* const alpha,
+                              const std::size_t stride,
+                              std::vector<float>& cells) {
+        const std::size_t cellStride = width + 2;
+        cells.assign(cellStride * height, 0.0f);
+        for (unsigned row = 0; cover && row < height; ++row) {
+            cells[row * cellStride] = cover[row];
+        }
+        const float right = float(width);
+        for (std::size_t k = 0; k < count; ++k) {
+            const detail::RasterLine& l = all[indices ? indices[k] : k];
+            const float x0 = float(l.x0 - left), y0 = float(l.y0 - top);
+            const float x1 = float(l.x1 - left), y1 = float(l.y1 - top);
+            if (std::max(l.x0, l.x1) <= left) {
+                detail::accumulateLine(cells.data(), cellStride, height, right, 0, y0, 0, y1);
+                continue;
+            }
+            // Split where the line crosses the sides of the tile, so that the parts outside can
+            // be clamped to the sides.
+            float ts[4] = { 0, 0, 0, 1 };
+            std::size_t splits = 1;
+            for (const float side : { 0.0f, right }) {
+                if ((x0 < side) != (x1 < side)) {
+                    ts[splits++] = (side - x0) / (x1 - x0);
+                }
+            }
+            ts[splits++] = 1;
+            if (splits == 4 && ts[2] < ts[1]) {
+                std::swap(ts[1], ts[2]);
+            }
+            float px = x0, py = y0;
+            for (std::size_t i = 1; i < splits; ++i) {
+                const float nx = i + 1 == splits ? x1 : x0 + ts[i] * (x1 - x0);
+                const float ny = i + 1 == splits ? y1 : y0 + ts[i] * (y1 - y0);
+                detail::accumulateLine(cells.data(), cellStride, height, right,
+                                       std::min(right, std::max(0.0f, px)), py,
+                                       std::min(right, std::max(0.0f, nx)), ny);
+                px = nx;
+                py = ny;
+            }
+        }
+        for (unsigned row = 0; row < height; ++row) {
+            detail::accumulateRow(cells.data() + row * cellStride, alpha + row * stride, width,
+                                  rule);
+        }
+    }
+
+    std::vector<detail::RasterLine> lines;
+    double x, y;
+    double startX, startY;
+};
+
+} // namespace svg
+} // namespace mapbox
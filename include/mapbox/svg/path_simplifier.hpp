@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+// LineReceiver (see PathFlattener) that drops the points of a flattened path that lie within
+// `tolerance` of the simplified line, by Douglas-Peucker, and passes the rest on to another
+// LineReceiver.
+//
+// Usage:
+//
+// LineReceiver receiver;
+// mapbox::svg::PathSimplifier<LineReceiver> simplifier(receiver, 2.0);
+// mapbox::svg::PathFlattener<decltype(simplifier)> flattener(simplifier, 0.5);
+// mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// simplifier.finish();
+//
+// Points are held in a window of at most `capacity` points, which is simplified and passed on
+// when `moveTo` or `closePath` ends the subpath, or when it fills up. A full window keeps its last
+// point, which starts the next one, so long subpaths need no more memory than short ones. Closed
+// subpaths keep at least three points, unless they had fewer.
+//
+// With `preserveWindowTopology`, segments of a window that would cross each other get back the
+// points that were dropped between their ends until they don't. Segments are only checked against
+// those of the same window: a subpath that fits into one window doesn't come to cross itself, but
+// a longer one still may where the parts of two windows meet.
+//
+// Call `finish()` after the last path, which passes on a trailing open subpath.
+
+template <typename LineReceiver>
+class PathSimplifier {
+public:
+    PathSimplifier(LineReceiver& t_,
+                   double tolerance_ = 0.25,
+                   bool preserveWindowTopology_ = false,
+                   std::size_t capacity_ = 1024)
+        : t(t_),
+          threshold(tolerance_ * tolerance_),
+          preserveWindowTopology(preserveWindowTopology_),
+          capacity(std::max<std::size_t>(capacity_, 3)) {
+        points.reserve(capacity + 1);
+        keep.reserve(capacity + 1);
+        reset();
+    }
+    PathSimplifier(const PathSimplifier&) = delete;
+    PathSimplifier(PathSimplifier&&) = delete;
+
+    // Discards a pending subpath.
+    void reset() {
+        points.clear();
+        startX = startY = 0;
+        flushed = false;
+    }
+
+    void finish() {
+        endSubpath();
+    }
+
+    void moveTo(double x, double y) {
+        endSubpath();
+        startX = x;
+        startY = y;
+        points.push_back({ x, y });
+        t.moveTo(x, y);
+    }
+
+    void closePath() {
+        if (points.size() > 1) {
+            if (points.back().x != startX || points.back().y != startY) {
+                points.push_back({ startX, startY });
+            }
+            simplify(!flushed);
+            // The ring closes on its own, so the last point isn't passed on.
+            emit(points.size() - 1);
+        }
+        t.closePath();
+        // Drawing after a closepath starts at the start of the closed subpath.
+        points.clear();
+        points.push_back({ startX, startY });
+        flushed = false;
+    }
+
+    void lineTo(double x, double y) {
+        if (points.empty()) {
+            points.push_back({ startX, startY });
+        }
+        if (points.back().x == x && points.back().y == y) {
+            return;
+        }
+        points.push_back({ x, y });
+        if (points.size() == capacity) {
+            simplify(false);
+            emit(points.size());
+            const Point last = points.back();
+            points.clear();
+            points.push_back(last);
+            flushed = true;
+        }
+    }
+
+private:
+    struct Point {
+        double x, y;
+    };
+
+    struct Segment {
+        std::size_t first, last;
+        double minX, maxX;
+        std::size_t order;
+    };
+
+    void endSubpath() {
+        if (points.size() > 1) {
+            simplify(false);
+            emit(points.size());
+        }
+        points.clear();
+        flushed = false;
+    }
+
+    // Passes on the kept points after the first one, up to `end`.
+    void emit(const std::size_t end) {
+        for (std::size_t i = 1; i < end; ++i) {
+            if (keep[i]) {
+                t.lineTo(points[i].x, points[i].y);
+            }
+        }
+    }
+
+    // Marks the points of the window to keep. `ring` is set when the window holds a whole closed
+    // subpath, ending on its first point.
+    void simplify(const bool ring) {
+        const std::size_t n = points.size();
+        keep.assign(n, 0);
+        keep[0] = keep[n - 1] = 1;
+        ranges.clear();
+        ranges.push_back({ 0, n - 1 });
+        split();
+        if (ring) {
+            // The point farthest from the others, twice, so that the ring keeps an area.
+            for (std::size_t kept = std::count(keep.begin(), keep.end(), 1); kept < 4; ++kept) {
+                std::size_t first = 0, last = 0;
+                double best = 0;
+                for (std::size_t i = 0, j = 1; j < n; ++j) {
+                    if (keep[j]) {
+                        std::size_t index;
+                        const double distance = farthest(i, j, index);
+                        if (distance > best) {
+                            best = distance;
+                            first = i;
+                            last = j;
+                        }
+                        i = j;
+                    }
+                }
+                if (!refine(first, last)) {
+                    break;
+                }
+            }
+        }
+        if (preserveWindowTopology) {
+            untangle(ring);
+        }
+    }
+
+    // Douglas-Peucker: keeps the point of each pending range farthest from its segment, and
+    // splits the range there, while that point is beyond the tolerance.
+    void split() {
+        while (!ranges.empty()) {
+            const std::pair<std::size_t, std::size_t> range = ranges.back();
+            ranges.pop_back();
+            std::size_t index;
+            if (farthest(range.first, range.second, index) > threshold) {
+                keep[index] = 1;
+                ranges.push_back({ range.first, index });
+                ranges.push_back({ index, range.second });
+            }
+        }
+    }
+
+    // Keeps the point between two kept points that is farthest from their segment, even within
+    // the tolerance, and goes on splitting from there so that the points stay within it.
+    bool refine(const std::size_t first, const std::size_t last) {
+        std::size_t index;
+        if (farthest(first, last, index) == 0 || keep[index]) {
+            return false;
+        }
+        keep[index] = 1;
+        ranges.push_back({ first, index });
+        ranges.push_back({ index, last });
+        split();
+        return true;
+    }
+
+    // Returns the squared distance of the point between `first` and `last` that is farthest from
+    // the segment between them, and its index; 0 if there is none.
+    double farthest(const std::size_t first, const std::size_t last, std::size_t& index) const {
+        const Point& a = points[first];
+        const Point& b = points[last];
+        const double dx = b.x - a.x, dy = b.y - a.y;
+        const double lengthSquared = dx * dx + dy * dy;
+        const double inverse = lengthSquared > 0 ? 1 / lengthSquared : 0;
+        double best = 0;
+        index = first;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            const Point& p = points[i];
+            const double along = ((p.x - a.x) * dx + (p.y - a.y) * dy) * inverse;
+            const double u = std::min(1.0, std::max(0.0, along));
+            const double ex = a.x + u * dx - p.x, ey = a.y + u * dy - p.y;
+            const double distance = ex * ex + ey * ey;
+            if (distance > best) {
+                best = distance;
+                index = i;
+            }
+        }
+        return best;
+    }
+
+    static double cross(const Point& a, const Point& b, const Point& c) {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    // Whether `p`, on the line through `a` and `b`, lies within their bounding box.
+    static bool within(const Point& a, const Point& b, const Point& p) {
+        return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+               std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+    }
+
+    // Whether two segments share a point, touching included.
+    static bool intersects(const Point& a, const Point& b, const Point& c, const Point& d) {
+        if (std::max(a.x, b.x) < std::min(c.x, d.x) || std::max(c.x, d.x) < std::min(a.x, b.x) ||
+            std::max(a.y, b.y) < std::min(c.y, d.y) || std::max(c.y, d.y) < std::min(a.y, b.y)) {
+            return false;
+        }
+        const double d1 = cross(a, b, c), d2 = cross(a, b, d);
+        const double d3 = cross(c, d, a), d4 = cross(c, d, b);
+        if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+            ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+            return true;
+        }
+        return (d1 == 0 && within(a, b, c)) || (d2 == 0 && within(a, b, d)) ||
+               (d3 == 0 && within(c, d, a)) || (d4 == 0 && within(c, d, b));
+    }
+
+    // Keeps dropped points back until no two kept segments that aren't neighbors intersect.
+    // Each pass sweeps the segments by their left end, and refines both segments of every
+    // crossing it finds.
+    void untangle(const bool ring) {
+        for (bool changed = true; changed;) {
+            changed = false;
+            segments.clear();
+            for (std::size_t i = 0, j = 1; j < points.size(); ++j) {
+                if (keep[j]) {
+                    segments.push_back({ i, j, std::min(points[i].x, points[j].x),
+                                         std::max(points[i].x, points[j].x), segments.size() });
+                    i = j;
+                }
+            }
+            const std::size_t count = segments.size();
+            std::sort(segments.begin(), segments.end(),
+                      [](const Segment& a, const Segment& b) { return a.minX < b.minX; });
+            for (std::size_t k = 0; k < count; ++k) {
+                const Segment& s = segments[k];
+                for (std::size_t l = k + 1; l < count && segments[l].minX <= s.maxX; ++l) {
+                    const Segment& u = segments[l];
+                    const std::size_t apart = s.order > u.order ? s.order - u.order
+                                                                : u.order - s.order;
+                    // The first and the last segment of a ring meet at its start.
+                    if (apart < 2 || (ring && apart == count - 1)) {
+                        continue;
+                    }
+                    if (intersects(points[s.first], points[s.last], points[u.first],
+                                   points[u.last])) {
+                        changed |= refine(s.first, s.last);
+                        changed |= refine(u.first, u.last);
+                    }
+                }
+            }
+        }
+    }
+
+    LineReceiver& t;
+    const double threshold;
+    const bool preserveWindowTopology;
+    const std::size_t capacity;
+
+    std::vector<Point> points;
+    std::vector<uint8_t> keep;
+    std::vector<Segment> segments;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    double startX, startY;
+    bool flushed;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mapbox {
+namespace svg {
+
+// A path string that isn't necessarily NUL-terminated.
+struct PathSlice {
+    const char* data;
+    std::size_t size;
+};
+
+} // namespace svg
+} // namespace mapbox
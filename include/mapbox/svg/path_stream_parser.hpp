@@ -0,0 +1,342 @@
+#pragma once
+
+#include <mapbox/svg/number_parser.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace mapbox {
+namespace svg {
+
+// Incremental variant of PathParser for input that arrives in chunks. Chunks may end anywhere,
+// including in the middle of a number, flag or command; each command is sent to the receiver as
+// soon as it is complete. Only a number that a chunk ends in is buffered, so memory use doesn't
+// depend on the size of the path.
+//
+// Usage:
+//
+// VertexReceiver receiver;
+// mapbox::svg::PathStreamParser<VertexReceiver> parser(receiver);
+// parser("M6,12,4,4a2 2 0 1", 17);
+// parser(" 1-2 2A2 2 0 0 1 6 12Z", 22);
+// parser.finish();
+//
+// Accepts exactly the same input as PathParser, and reports the same errors with `errorOffset()`
+// relative to the start of the stream. Commands go to the receiver as PathParser sends them too,
+// including `implicitLineTo` and the lines that stand in for missing methods.
+
+template <typename VertexReceiver>
+class PathStreamParser {
+public:
+    PathStreamParser(VertexReceiver& t_) : t(t_) {
+        reset();
+    }
+    PathStreamParser(const PathStreamParser&) = delete;
+    PathStreamParser(PathStreamParser&&) = delete;
+
+    // Prepares the parser for a new path.
+    void reset() {
+        streamOffset = 0;
+        carry.clear();
+        error = PathParseErrorType::None;
+        errorPosition = 0;
+        command = '\0';
+        relative = false;
+        index = 0;
+        implicit = false;
+        pending = false;
+        afterArgument = false;
+        afterComma = false;
+        invalidCommand = false;
+    }
+
+    bool operator()(const char* chunk, std::size_t length) {
+        if (hasError()) {
+            return false;
+        }
+        const char* cursor = chunk;
+        const char* const end = chunk + length;
+
+        if (!carry.empty()) {
+            // Complete the number carried over from the previous chunk first.
+            const char* runEnd = cursor;
+            while (runEnd != end && isRunCharacter(*runEnd)) {
+                ++runEnd;
+            }
+            carry.append(cursor, runEnd);
+            cursor = runEnd;
+            if (!parseCarry(runEnd != end)) {
+                return false;
+            }
+            if (runEnd == end) {
+                return true;
+            }
+        }
+
+        const char* rest;
+        if (!parse(cursor, end, false, rest)) {
+            return false;
+        }
+        streamOffset += std::size_t(rest - cursor);
+        carry.assign(rest, end);
+        return true;
+    }
+
+    template <typename String>
+    auto operator()(const String& str) -> decltype(str.data(), str.size(), bool()) {
+        return (*this)(str.data(), str.size());
+    }
+
+    // Signals the end of the path. Returns false if the path is invalid or ends in the middle of
+    // a command.
+    bool finish() {
+        if (hasError()) {
+            return false;
+        }
+        if (!carry.empty() && !parseCarry(true)) {
+            return false;
+        }
+        if (invalidCommand) {
+            return fail(PathParseErrorType::CommandParsing, 0);
+        }
+        if (pending) {
+            return fail(isFlagIndex() ? PathParseErrorType::FlagParsing
+                                      : PathParseErrorType::NumberParsing,
+                        0);
+        }
+        return true;
+    }
+
+    bool hasError() const {
+        return error != PathParseErrorType::None;
+    }
+
+    PathParseErrorType errorType() const {
+        return error;
+    }
+
+    std::ptrdiff_t errorOffset() const {
+        return std::ptrdiff_t(errorPosition);
+    }
+
+private:
+    static bool isRunCharacter(const char c) {
+        return detail::isDigit(c) || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E';
+    }
+
+    static bool isWhitespace(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static std::size_t arity(const char c) {
+        switch (c) {
+            case 'M': case 'm': case 'L': case 'l': case 'T': case 't': return 2;
+            case 'H': case 'h': case 'V': case 'v': return 1;
+            case 'C': case 'c': return 6;
+            case 'S': case 's': case 'Q': case 'q': return 4;
+            case 'A': case 'a': return 7;
+            default: return 0;
+        }
+    }
+
+    bool isFlagIndex() const {
+        return (command == 'A' || command == 'a') && (index == 3 || index == 4);
+    }
+
+    // Parses the carried characters, up to the last number that may go on in the next chunk unless
+    // the carry is `complete`.
+    bool parseCarry(const bool complete) {
+        const char* first = carry.data();
+        const char* rest;
+        if (!parse(first, first + carry.size(), complete, rest)) {
+            return false;
+        }
+        streamOffset += std::size_t(rest - first);
+        carry.erase(0, std::size_t(rest - first));
+        return true;
+    }
+
+    // Whether the number that starts at `cursor`, and was read up to `next`, could be longer or
+    // only become valid with more input after `last`.
+    static bool isUnfinished(const char* cursor, const char* next, const char* const last) {
+        if (next == cursor) {
+            while (cursor != last && isRunCharacter(*cursor)) {
+                ++cursor;
+            }
+            return cursor == last;
+        }
+        // An exponent without digits isn't part of the number yet.
+        if (next != last && (*next == 'e' || *next == 'E')) {
+            ++next;
+            if (next != last && (*next == '-' || *next == '+')) {
+                ++next;
+            }
+        }
+        return next == last;
+    }
+
+    bool fail(const PathParseErrorType type, const std::size_t offset) {
+        error = type;
+        errorPosition = streamOffset + offset;
+        return false;
+    }
+
+    // Parses a segment. Unless the segment is `complete`, it stops at a number that may be cut off
+    // at the end, and `rest` points to its start.
+    bool parse(const char* const first,
+               const char* const last,
+               const bool complete,
+               const char*& rest) {
+        const char* cursor = first;
+        while (cursor != last) {
+            const char c = *cursor;
+            if (isWhitespace(c)) {
+                ++cursor;
+                continue;
+            }
+            const std::size_t offset = std::size_t(cursor - first);
+            if (invalidCommand) {
+                // Like PathParser, report the error after the whitespace following the command.
+                return fail(PathParseErrorType::CommandParsing, offset);
+            }
+
+            if (isFlagIndex()) {
+                if (c == ',' && afterArgument && !afterComma) {
+                    afterComma = true;
+                    ++cursor;
+                } else if (c == '0' || c == '1') {
+                    args[index] = c == '1';
+                    ++cursor;
+                    argumentParsed();
+                } else {
+                    return fail(PathParseErrorType::FlagParsing, offset);
+                }
+                continue;
+            }
+
+            if (c == ',') {
+                if (afterArgument && !afterComma) {
+                    afterComma = true;
+                    ++cursor;
+                    continue;
+                }
+                if (pending) {
+                    return fail(PathParseErrorType::NumberParsing, offset);
+                }
+                invalidCommand = true;
+                ++cursor;
+                continue;
+            }
+
+            const bool numberStart = detail::isDigit(c) || c == '.' || c == '-' || c == '+';
+            if (pending || (numberStart && arity(command) && afterArgument)) {
+                double value = 0;
+                const char* next = detail::parseNumber(cursor, last, value);
+                if (!complete && isUnfinished(cursor, next, last)) {
+                    rest = cursor;
+                    return true;
+                }
+                if (next == cursor || std::isinf(value)) {
+                    return fail(PathParseErrorType::NumberParsing, offset);
+                }
+                args[index] = value;
+                cursor = next;
+                argumentParsed();
+                continue;
+            }
+
+            // Anything else starts a new command.
+            ++cursor;
+            command = c;
+            relative = c >= 'a';
+            afterArgument = false;
+            afterComma = false;
+            index = 0;
+            implicit = false;
+            if (c == 'Z' || c == 'z') {
+                detail::Dispatch<VertexReceiver, double>::closePath(t);
+            } else if (arity(c)) {
+                pending = true;
+            } else {
+                invalidCommand = true;
+            }
+        }
+        rest = last;
+        return true;
+    }
+
+    void argumentParsed() {
+        afterArgument = true;
+        afterComma = false;
+        if (++index < arity(command)) {
+            pending = true;
+            return;
+        }
+        index = 0;
+        pending = false;
+        using D = detail::Dispatch<VertexReceiver, double>;
+        switch (command) {
+            case 'M': case 'm':
+                if (implicit) {
+                    D::implicitLineTo(t, args[0], args[1], relative);
+                } else {
+                    D::moveTo(t, args[0], args[1], relative);
+                }
+                implicit = true;
+                break;
+            case 'L': case 'l':
+                D::lineTo(t, args[0], args[1], relative);
+                break;
+            case 'H': case 'h':
+                D::horizontalLineTo(t, args[0], relative);
+                break;
+            case 'V': case 'v':
+                D::verticalLineTo(t, args[0], relative);
+                break;
+            case 'C': case 'c':
+                D::curveTo(t, args[0], args[1], args[2], args[3], args[4], args[5], relative);
+                break;
+            case 'S': case 's':
+                D::smoothCurveTo(t, args[0], args[1], args[2], args[3], relative);
+                break;
+            case 'Q': case 'q':
+                D::quadraticCurveTo(t, args[0], args[1], args[2], args[3], relative);
+                break;
+            case 'T': case 't':
+                D::smoothQuadraticCurveTo(t, args[0], args[1], relative);
+                break;
+            case 'A': case 'a':
+                D::arc(t, args[0], args[1], args[2], args[3] != 0, args[4] != 0, args[5], args[6],
+                       relative);
+                break;
+        }
+    }
+
+private:
+    VertexReceiver& t;
+
+    // Offset of the next unparsed byte (the start of `carry`, if any) in the stream.
+    std::size_t streamOffset;
+    std::string carry;
+    PathParseErrorType error;
+    std::size_t errorPosition;
+
+    // The command being parsed and how many of its arguments have been read.
+    char command;
+    bool relative;
+    std::size_t index;
+    double args[7];
+    // The next pair of a moveto is an implicit lineto.
+    bool implicit;
+    // Another argument is required before the next command.
+    bool pending;
+    // A separating comma may follow.
+    bool afterArgument;
+    bool afterComma;
+    bool invalidCommand;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,850 @@
+#pragma once
+
+#include <mapbox/svg/fill_rule.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+namespace detail {
+
+// Ear clipping of a polygon with holes, after earcut: the rings are linked lists of vertices,
+// holes are bridged into the outer ring, and ears are cut off until only a triangle remains.
+// Large polygons sort their vertices along a z-order curve, so that the points that might lie in
+// an ear are found without visiting the whole ring.
+class Earcut {
+public:
+    struct Node {
+        uint32_t i;
+        double x, y;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        int32_t z = 0;
+        Node* prevZ = nullptr;
+        Node* nextZ = nullptr;
+        bool steiner = false;
+
+        Node(uint32_t i_, double x_, double y_) : i(i_), x(x_), y(y_) {
+        }
+    };
+
+    // Triangulates the ring of `count` vertices at `first` in `vertices` (x, y pairs) with the
+    // given holes, calling `emit(a, b, c)` with the vertex indices of each triangle.
+    template <typename Ring, typename Emit>
+    void operator()(const float* vertices,
+                    const Ring& outer,
+                    const Ring* holes,
+                    const std::size_t holeCount,
+                    Emit emit) {
+        nodes.clear();
+        Node* outerNode = linkedList(vertices, outer, true);
+        if (!outerNode || outerNode->prev == outerNode->next) {
+            return;
+        }
+        std::size_t total = outer.count;
+        for (std::size_t h = 0; h < holeCount; ++h) {
+            total += holes[h].count;
+        }
+        if (holeCount) {
+            outerNode = eliminateHoles(vertices, holes, holeCount, outerNode);
+        }
+
+        hashing = total > 80;
+        if (hashing) {
+            minX = maxX = vertices[2 * outer.first];
+            minY = maxY = vertices[2 * outer.first + 1];
+            for (std::size_t k = 1; k < outer.count; ++k) {
+                const double x = vertices[2 * (outer.first + k)];
+                const double y = vertices[2 * (outer.first + k) + 1];
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+            const double size = std::max(maxX - minX, maxY - minY);
+            inverseSize = size != 0 ? 32767 / size : 0;
+        }
+        earcutLinked(outerNode, emit, 0);
+    }
+
+private:
+    template <typename Ring>
+    Node* linkedList(const float* vertices, const Ring& ring, const bool clockwise) {
+        double sum = 0;
+        for (std::size_t k = 0, j = ring.count - 1; k < ring.count; j = k++) {
+            const float* p1 = vertices + 2 * (ring.first + k);
+            const float* p2 = vertices + 2 * (ring.first + j);
+            sum += (double(p2[0]) - p1[0]) * (double(p1[1]) + p2[1]);
+        }
+        Node* last = nullptr;
+        if (clockwise == (sum > 0)) {
+            for (std::size_t k = 0; k < ring.count; ++k) {
+                last = insertNode(uint32_t(ring.first + k), vertices, last);
+            }
+        } else {
+            for (std::size_t k = ring.count; k-- > 0;) {
+                last = insertNode(uint32_t(ring.first + k), vertices, last);
+            }
+        }
+        if (last && equals(last, last->next)) {
+            removeNode(last);
+            last = last->next;
+        }
+        return last;
+    }
+
+    Node* filterPoints(Node* start, Node* end = nullptr) {
+        if (!end) {
+            end = start;
+        }
+        Node* p = start;
+        bool again;
+        do {
+            again = false;
+            if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0)) {
+                removeNode(p);
+                p = end = p->prev;
+                if (p == p->next) {
+                    break;
+                }
+                again = true;
+            } else {
+                p = p->next;
+            }
+        } while (again || p != end);
+        return end;
+    }
+
+    template <typename Emit>
+    void earcutLinked(Node* ear, Emit& emit, const int pass) {
+        if (!ear) {
+            return;
+        }
+        if (!pass && hashing) {
+            indexCurve(ear);
+        }
+        Node* stop = ear;
+        while (ear->prev != ear->next) {
+            Node* prev = ear->prev;
+            Node* next = ear->next;
+            if (hashing ? isEarHashed(ear) : isEar(ear)) {
+                emit(prev->i, ear->i, next->i);
+                removeNode(ear);
+                // Skipping the next vertex leads to fewer sliver triangles.
+                ear = next->next;
+                stop = next->next;
+                continue;
+            }
+            ear = next;
+            if (ear == stop) {
+                // No ears left: filter points and try again, then cure small self-intersections,
+                // then split the rest in two.
+                if (!pass) {
+                    earcutLinked(filterPoints(ear), emit, 1);
+                } else if (pass == 1) {
+                    ear = cureLocalIntersections(filterPoints(ear), emit);
+                    earcutLinked(ear, emit, 2);
+                } else if (pass == 2) {
+                    splitEarcut(ear, emit);
+                }
+                break;
+            }
+        }
+    }
+
+    bool isEar(Node* ear) {
+        const Node* a = ear->prev;
+        const Node* b = ear;
+        const Node* c = ear->next;
+        if (area(a, b, c) >= 0) {
+            return false;
+        }
+        for (const Node* p = ear->next->next; p != ear->prev; p = p->next) {
+            if (pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                area(p->prev, p, p->next) >= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isEarHashed(Node* ear) {
+        const Node* a = ear->prev;
+        const Node* b = ear;
+        const Node* c = ear->next;
+        if (area(a, b, c) >= 0) {
+            return false;
+        }
+        const int32_t minZ = zOrder(std::min(std::min(a->x, b->x), c->x),
+                                    std::min(std::min(a->y, b->y), c->y));
+        const int32_t maxZ = zOrder(std::max(std::max(a->x, b->x), c->x),
+                                    std::max(std::max(a->y, b->y), c->y));
+        for (const Node* p = ear->nextZ; p && p->z <= maxZ; p = p->nextZ) {
+            if (p != ear->prev && p != ear->next &&
+                pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                area(p->prev, p, p->next) >= 0) {
+                return false;
+            }
+        }
+        for (const Node* p = ear->prevZ; p && p->z >= minZ; p = p->prevZ) {
+            if (p != ear->prev && p != ear->next &&
+                pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                area(p->prev, p, p->next) >= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Emit>
+    Node* cureLocalIntersections(Node* start, Emit& emit) {
+        Node* p = start;
+        do {
+            Node* a = p->prev;
+            Node* b = p->next->next;
+            if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) &&
+                locallyInside(b, a)) {
+                emit(a->i, p->i, b->i);
+                removeNode(p);
+                removeNode(p->next);
+                p = start = b;
+            }
+            p = p->next;
+        } while (p != start);
+        return filterPoints(p);
+    }
+
+    template <typename Emit>
+    void splitEarcut(Node* start, Emit& emit) {
+        Node* a = start;
+        do {
+            for (Node* b = a->next->next; b != a->prev; b = b->next) {
+                if (a->i != b->i && isValidDiagonal(a, b)) {
+                    Node* c = splitPolygon(a, b);
+                    a = filterPoints(a, a->next);
+                    c = filterPoints(c, c->next);
+                    earcutLinked(a, emit, 0);
+                    earcutLinked(c, emit, 0);
+                    return;
+                }
+            }
+            a = a->next;
+        } while (a != start);
+    }
+
+    template <typename Ring>
+    Node* eliminateHoles(const float* vertices,
+                         const Ring* holes,
+                         const std::size_t holeCount,
+                         Node* outerNode) {
+        queue.clear();
+        for (std::size_t h = 0; h < holeCount; ++h) {
+            Node* list = linkedList(vertices, holes[h], false);
+            if (list) {
+                if (list == list->next) {
+                    list->steiner = true;
+                }
+                queue.push_back(getLeftmost(list));
+            }
+        }
+        std::sort(queue.begin(), queue.end(), [](const Node* a, const Node* b) {
+            return a->x < b->x || (a->x == b->x && a->y < b->y);
+        });
+        // Holes are bridged from left to right.
+        for (Node* hole : queue) {
+            outerNode = eliminateHole(hole, outerNode);
+        }
+        return outerNode;
+    }
+
+    Node* eliminateHole(Node* hole, Node* outerNode) {
+        Node* bridge = findHoleBridge(hole, outerNode);
+        if (!bridge) {
+            return outerNode;
+        }
+        Node* bridgeReverse = splitPolygon(bridge, hole);
+        filterPoints(bridgeReverse, bridgeReverse->next);
+        return filterPoints(bridge, bridge->next);
+    }
+
+    // Finds a vertex of the outer ring that the leftmost vertex of a hole can be linked to.
+    Node* findHoleBridge(Node* hole, Node* outerNode) {
+        Node* p = outerNode;
+        const double hx = hole->x, hy = hole->y;
+        double qx = -std::numeric_limits<double>::infinity();
+        Node* m = nullptr;
+
+        // A ray from the hole to the left hits a segment, whose endpoint with the lesser x is a
+        // candidate.
+        do {
+            if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+                const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+                if (x <= hx && x > qx) {
+                    qx = x;
+                    m = p->x < p->next->x ? p : p->next;
+                    if (x == hx) {
+                        return m;
+                    }
+                }
+            }
+            p = p->next;
+        } while (p != outerNode);
+        if (!m) {
+            return nullptr;
+        }
+
+        // Points inside the triangle of the hole vertex, the intersection and the candidate
+        // block the bridge: take the one at the smallest angle to the ray instead.
+        const Node* stop = m;
+        const double mx = m->x, my = m->y;
+        double tanMin = std::numeric_limits<double>::infinity();
+        p = m;
+        do {
+            if (hx >= p->x && p->x >= mx && hx != p->x &&
+                pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+                const double tanCur = std::abs(hy - p->y) / (hx - p->x);
+                if (locallyInside(p, hole) &&
+                    (tanCur < tanMin ||
+                     (tanCur == tanMin &&
+                      (p->x > m->x || (p->x == m->x && sectorContainsSector(m, p)))))) {
+                    m = p;
+                    tanMin = tanCur;
+                }
+            }
+            p = p->next;
+        } while (p != stop);
+        return m;
+    }
+
+    static bool sectorContainsSector(const Node* m, const Node* p) {
+        return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+    }
+
+    void indexCurve(Node* start) {
+        Node* p = start;
+        do {
+            p->z = p->z ? p->z : zOrder(p->x, p->y);
+            p->prevZ = p->prev;
+            p->nextZ = p->next;
+            p = p->next;
+        } while (p != start);
+        p->prevZ->nextZ = nullptr;
+        p->prevZ = nullptr;
+        sortLinked(p);
+    }
+
+    // Merge sort of the z-order links.
+    static Node* sortLinked(Node* list) {
+        for (std::size_t inSize = 1;; inSize *= 2) {
+            Node* p = list;
+            list = nullptr;
+            Node* tail = nullptr;
+            std::size_t merges = 0;
+            while (p) {
+                ++merges;
+                Node* q = p;
+                std::size_t pSize = 0;
+                for (std::size_t k = 0; k < inSize && q; ++k) {
+                    ++pSize;
+                    q = q->nextZ;
+                }
+                std::size_t qSize = inSize;
+                while (pSize > 0 || (qSize > 0 && q)) {
+                    Node* e;
+                    if (pSize == 0) {
+                        e = q;
+                        q = q->nextZ;
+                        --qSize;
+                    } else if (qSize == 0 || !q || p->z <= q->z) {
+                        e = p;
+                        p = p->nextZ;
+                        --pSize;
+                    } else {
+                        e = q;
+                        q = q->nextZ;
+                        --qSize;
+                    }
+                    if (tail) {
+                        tail->nextZ = e;
+                    } else {
+                        list = e;
+                    }
+                    e->prevZ = tail;
+                    tail = e;
+                }
+                p = q;
+            }
+            tail->nextZ = nullptr;
+            if (merges <= 1) {
+                return list;
+            }
+        }
+    }
+
+    // Interleaves the bits of the coordinates, scaled to 15 bits within the outer ring's bounds.
+    int32_t zOrder(const double x_, const double y_) const {
+        int32_t x = int32_t((x_ - minX) * inverseSize);
+        int32_t y = int32_t((y_ - minY) * inverseSize);
+        x = (x | (x << 8)) & 0x00FF00FF;
+        x = (x | (x << 4)) & 0x0F0F0F0F;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        y = (y | (y << 8)) & 0x00FF00FF;
+        y = (y | (y << 4)) & 0x0F0F0F0F;
+        y = (y | (y << 2)) & 0x33333333;
+        y = (y | (y << 1)) & 0x55555555;
+        return x | (y << 1);
+    }
+
+    static Node* getLeftmost(Node* start) {
+        Node* p = start;
+        Node* leftmost = start;
+        do {
+            if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) {
+                leftmost = p;
+            }
+            p = p->next;
+        } while (p != start);
+        return leftmost;
+    }
+
+    static bool pointInTriangle(const double ax, const double ay, const double bx,
+                                const double by, const double cx, const double cy,
+                                const double px, const double py) {
+        return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+               (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+               (bx - px) * (cy - py) >= (cx - px) * (by - py);
+    }
+
+    // Whether a diagonal from a to b lies inside the polygon and crosses none of its edges.
+    static bool isValidDiagonal(Node* a, Node* b) {
+        return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b) &&
+               ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+                 (area(a->prev, a, b->prev) != 0 || area(a, b->prev, b) != 0)) ||
+                (equals(a, b) && area(a->prev, a, a->next) > 0 &&
+                 area(b->prev, b, b->next) > 0));
+    }
+
+    static double area(const Node* p, const Node* q, const Node* r) {
+        return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+    }
+
+    static bool equals(const Node* a, const Node* b) {
+        return a->x == b->x && a->y == b->y;
+    }
+
+    static int sign(const double v) {
+        return (0 < v) - (v < 0);
+    }
+
+    static bool onSegment(const Node* p, const Node* q, const Node* r) {
+        return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) &&
+               q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+    }
+
+    static bool intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2) {
+        const int o1 = sign(area(p1, q1, p2));
+        const int o2 = sign(area(p1, q1, q2));
+        const int o3 = sign(area(p2, q2, p1));
+        const int o4 = sign(area(p2, q2, q1));
+        return (o1 != o2 && o3 != o4) || (o1 == 0 && onSegment(p1, p2, q1)) ||
+               (o2 == 0 && onSegment(p1, q2, q1)) || (o3 == 0 && onSegment(p2, p1, q2)) ||
+               (o4 == 0 && onSegment(p2, q1, q2));
+    }
+
+    static bool intersectsPolygon(const Node* a, const Node* b) {
+        const Node* p = a;
+        do {
+            if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i &&
+                intersects(p, p->next, a, b)) {
+                return true;
+            }
+            p = p->next;
+        } while (p != a);
+        return false;
+    }
+
+    static bool locallyInside(const Node* a, const Node* b) {
+        return area(a->prev, a, a->next) < 0
+                   ? area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0
+                   : area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+    }
+
+    static bool middleInside(const Node* a, const Node* b) {
+        const Node* p = a;
+        bool inside = false;
+        const double px = (a->x + b->x) / 2, py = (a->y + b->y) / 2;
+        do {
+            if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+                (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+                inside = !inside;
+            }
+            p = p->next;
+        } while (p != a);
+        return inside;
+    }
+
+    // Links a to b with a bridge: the ring is split in two if they are on the same ring, or
+    // merged if they are on different ones. Returns the copy of b.
+    Node* splitPolygon(Node* a, Node* b) {
+        nodes.emplace_back(a->i, a->x, a->y);
+        Node* a2 = &nodes.back();
+        nodes.emplace_back(b->i, b->x, b->y);
+        Node* b2 = &nodes.back();
+        Node* an = a->next;
+        Node* bp = b->prev;
+        a->next = b;
+        b->prev = a;
+        a2->next = an;
+        an->prev = a2;
+        b2->next = a2;
+        a2->prev = b2;
+        bp->next = b2;
+        b2->prev = bp;
+        return b2;
+    }
+
+    Node* insertNode(const uint32_t i, const float* vertices, Node* last) {
+        nodes.emplace_back(i, vertices[2 * i], vertices[2 * i + 1]);
+        Node* p = &nodes.back();
+        if (!last) {
+            p->prev = p;
+            p->next = p;
+        } else {
+            p->next = last->next;
+            p->prev = last;
+            last->next->prev = p;
+            last->next = p;
+        }
+        return p;
+    }
+
+    static void removeNode(Node* p) {
+        p->next->prev = p->prev;
+        p->prev->next = p->next;
+        if (p->prevZ) {
+            p->prevZ->nextZ = p->nextZ;
+        }
+        if (p->nextZ) {
+            p->nextZ->prevZ = p->prevZ;
+        }
+    }
+
+    // A deque keeps the nodes in place as it grows.
+    std::deque<Node> nodes;
+    std::vector<Node*> queue;
+    bool hashing = false;
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+    double inverseSize = 0;
+};
+
+} // namespace detail
+
+// LineReceiver (see PathFlattener) that triangulates the fill of a flattened path into
+// preallocated vertex and index buffers, ready for upload to the GPU.
+//
+// Usage:
+//
+// std::vector<float> vertices(2 * 1024);
+// std::vector<uint16_t> indices(3 * 1024);
+// mapbox::svg::BasicPathTessellator<uint16_t> tessellator(vertices.data(), 1024,
+//                                                          indices.data(), indices.size());
+// mapbox::svg::PathFlattener<decltype(tessellator)> flattener(tessellator, 0.1);
+// mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// if (tessellator.tessellate(mapbox::svg::FillRule::NonZero)) {
+//     upload(vertices.data(), tessellator.vertexCount(), indices.data(),
+//            tessellator.indexCount());
+// }
+//
+// Points go into the vertex buffer as x, y pairs as they arrive, and a ring is recorded as a
+// range of it when `moveTo` or `closePath` ends it. `tessellate` decides for each ring whether
+// it bounds the fill from the outside or is a hole: the winding numbers on both sides of a ring
+// follow from the rings around it, and rings with the fill on both sides or on neither are left
+// out. Each outer ring is then ear-clipped with the holes directly inside of it. Rings are
+// expected not to cross each other; crossings within a ring are handled as earcut does.
+//
+// When a buffer is too small, or the vertices don't fit the index type, the tessellator fails
+// and writes no more. Call `reset()` before reusing it for another path.
+
+template <typename Index>
+class BasicPathTessellator {
+public:
+    BasicPathTessellator(float* vertices_,
+                         std::size_t vertexCapacity_,
+                         Index* indices_,
+                         std::size_t indexCapacity_)
+        : vertices(vertices_),
+          vertexCapacity(std::min<std::size_t>(
+              vertexCapacity_, std::size_t(std::numeric_limits<Index>::max()) + 1)),
+          indices(indices_),
+          indexCapacity(indexCapacity_) {
+        reset();
+    }
+    BasicPathTessellator(const BasicPathTessellator&) = delete;
+    BasicPathTessellator(BasicPathTessellator&&) = delete;
+
+    void reset() {
+        rings.clear();
+        vertexCount_ = indexCount_ = 0;
+        ringStart = 0;
+        open = false;
+        overflow = false;
+        x = y = 0;
+    }
+
+    void moveTo(double x_, double y_) {
+        endRing();
+        x = x_;
+        y = y_;
+        startRing();
+    }
+
+    void closePath() {
+        endRing();
+    }
+
+    void lineTo(double x_, double y_) {
+        if (!open) {
+            startRing();
+        }
+        x = x_;
+        y = y_;
+        addVertex();
+    }
+
+    // Triangulates the rings so far into the index buffer, replacing earlier results. Returns
+    // false if a buffer was too small.
+    bool tessellate(const FillRule rule = FillRule::NonZero) {
+        endRing();
+        indexCount_ = 0;
+        if (overflow) {
+            return false;
+        }
+        classify(rule);
+
+        std::vector<Ring> holes;
+        for (std::size_t r = 0; r < rings.size(); ++r) {
+            if (rings[r].role != Role::Outer) {
+                continue;
+            }
+            holes.clear();
+            for (const Ring& ring : rings) {
+                if (ring.role == Role::Hole && ring.parent == r) {
+                    holes.push_back(ring);
+                }
+            }
+            earcut(vertices, rings[r], holes.data(), holes.size(),
+                   [&](const uint32_t a, const uint32_t b, const uint32_t c) {
+                       if (indexCount_ + 3 > indexCapacity) {
+                           overflow = true;
+                           return;
+                       }
+                       indices[indexCount_++] = Index(a);
+                       indices[indexCount_++] = Index(b);
+                       indices[indexCount_++] = Index(c);
+                   });
+        }
+        return !overflow;
+    }
+
+    // Number of vertices (x, y pairs) written.
+    std::size_t vertexCount() const {
+        return vertexCount_;
+    }
+
+    // Number of indices written by the last `tessellate`, three per triangle.
+    std::size_t indexCount() const {
+        return indexCount_;
+    }
+
+    bool failed() const {
+        return overflow;
+    }
+
+private:
+    enum class Role : uint8_t {
+        Outer,
+        Hole,
+        Ignored,
+    };
+
+    struct Ring {
+        std::size_t first;
+        std::size_t count;
+        double minX, minY, maxX, maxY;
+        // Twice the signed area.
+        double area;
+        Role role;
+        std::size_t parent;
+        // The sum of the directions of the rings around it.
+        int winding;
+    };
+
+    void startRing() {
+        ringStart = vertexCount_;
+        open = true;
+        addVertex();
+    }
+
+    void addVertex() {
+        const float fx = float(x), fy = float(y);
+        if (vertexCount_ > ringStart && vertices[2 * vertexCount_ - 2] == fx &&
+            vertices[2 * vertexCount_ - 1] == fy) {
+            return;
+        }
+        if (vertexCount_ == vertexCapacity) {
+            overflow = true;
+            return;
+        }
+        vertices[2 * vertexCount_] = fx;
+        vertices[2 * vertexCount_ + 1] = fy;
+        ++vertexCount_;
+    }
+
+    void endRing() {
+        if (!open) {
+            return;
+        }
+        open = false;
+        // The flattener ends closed rings on their first point.
+        if (vertexCount_ - ringStart > 1) {
+            const float* last = vertices + 2 * (vertexCount_ - 1);
+            const float* first = vertices + 2 * ringStart;
+            if (last[0] == first[0] && last[1] == first[1]) {
+                --vertexCount_;
+            }
+        }
+        if (vertexCount_ - ringStart < 3) {
+            vertexCount_ = ringStart;
+            return;
+        }
+        Ring ring = { ringStart, vertexCount_ - ringStart, 0, 0, 0, 0, 0, Role::Ignored, 0, 0 };
+        ring.minX = ring.maxX = vertices[2 * ringStart];
+        ring.minY = ring.maxY = vertices[2 * ringStart + 1];
+        for (std::size_t k = ringStart, j = vertexCount_ - 1; k < vertexCount_; j = k++) {
+            const double px = vertices[2 * k], py = vertices[2 * k + 1];
+            ring.minX = std::min(ring.minX, px);
+            ring.minY = std::min(ring.minY, py);
+            ring.maxX = std::max(ring.maxX, px);
+            ring.maxY = std::max(ring.maxY, py);
+            ring.area += (double(vertices[2 * j]) - px) * (double(vertices[2 * j + 1]) + py);
+        }
+        rings.push_back(ring);
+    }
+
+    // Whether the first vertex of `inner` is inside of `outer`, by the crossings of a ray.
+    bool contains(const Ring& outer, const Ring& inner) const {
+        const double px = vertices[2 * inner.first], py = vertices[2 * inner.first + 1];
+        if (px < outer.minX || px > outer.maxX || py < outer.minY || py > outer.maxY) {
+            return false;
+        }
+        bool inside = false;
+        const std::size_t end = outer.first + outer.count;
+        for (std::size_t k = outer.first, j = end - 1; k < end; j = k++) {
+            const double ax = vertices[2 * j], ay = vertices[2 * j + 1];
+            const double bx = vertices[2 * k], by = vertices[2 * k + 1];
+            if ((ay > py) != (by > py) && px < ax + (py - ay) * (bx - ax) / (by - ay)) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    // Sets the role of every ring from the winding numbers on both sides of it, and the parent
+    // of every hole: the smallest outer ring around it.
+    //
+    // The rings are swept in the order of the x of their first vertex, and each is only tested
+    // against the rings whose bounds span that x. That keeps the cost near linear for rings side
+    // by side, such as glyphs or icons; rings that all overlap in x, such as concentric ones,
+    // still test every pair.
+    void classify(const FillRule rule) {
+        byLeft.resize(rings.size());
+        byPoint.resize(rings.size());
+        for (std::size_t r = 0; r < rings.size(); ++r) {
+            byLeft[r] = byPoint[r] = r;
+            rings[r].winding = 0;
+        }
+        std::sort(byLeft.begin(), byLeft.end(), [&](const std::size_t a, const std::size_t b) {
+            return rings[a].minX < rings[b].minX;
+        });
+        std::sort(byPoint.begin(), byPoint.end(), [&](const std::size_t a, const std::size_t b) {
+            return vertices[2 * rings[a].first] < vertices[2 * rings[b].first];
+        });
+        active.clear();
+        containers.clear();
+        std::size_t next = 0;
+        for (const std::size_t r : byPoint) {
+            const double px = vertices[2 * rings[r].first];
+            for (; next < byLeft.size() && rings[byLeft[next]].minX <= px; ++next) {
+                active.push_back(byLeft[next]);
+            }
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [&](const std::size_t o) { return rings[o].maxX < px; }),
+                         active.end());
+            for (const std::size_t o : active) {
+                if (o != r && contains(rings[o], rings[r])) {
+                    containers.emplace_back(r, o);
+                    rings[r].winding += direction(rings[o]);
+                }
+            }
+        }
+        for (Ring& ring : rings) {
+            const bool outside = isInside(rule, ring.winding);
+            const bool inside = isInside(rule, ring.winding + direction(ring));
+            ring.role = inside == outside ? Role::Ignored : inside ? Role::Outer : Role::Hole;
+            ring.parent = rings.size();
+        }
+        for (const auto& pair : containers) {
+            Ring& hole = rings[pair.first];
+            if (hole.role == Role::Hole && rings[pair.second].role == Role::Outer &&
+                (hole.parent == rings.size() ||
+                 std::abs(rings[pair.second].area) < std::abs(rings[hole.parent].area))) {
+                hole.parent = pair.second;
+            }
+        }
+        for (Ring& ring : rings) {
+            if (ring.role == Role::Hole && ring.parent == rings.size()) {
+                ring.role = Role::Ignored;
+            }
+        }
+    }
+
+    // The winding number that a ring adds inside of it, counted as PathRasterizer does.
+    static int direction(const Ring& ring) {
+        return ring.area > 0 ? -1 : 1;
+    }
+
+    float* const vertices;
+    const std::size_t vertexCapacity;
+    Index* const indices;
+    const std::size_t indexCapacity;
+
+    std::size_t vertexCount_;
+    std::size_t indexCount_;
+    std::size_t ringStart;
+    bool open;
+    bool overflow;
+    double x, y;
+
+    std::vector<Ring> rings;
+    // Scratch space for `classify`: rings by their left bound and by their first vertex, those
+    // that span the current one, and pairs of a ring and a ring around it.
+    std::vector<std::size_t> byLeft, byPoint, active;
+    std::vector<std::pair<std::size_t, std::size_t>> containers;
+    detail::Earcut earcut;
+};
+
+using PathTessellator = BasicPathTessellator<uint32_t>;
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+namespace mapbox {
+namespace svg {
+
+// Transforms for PathTransform, from the cheapest to the most general. Points map to
+// (a * x + c * y + e, b * x + d * y + f), in the order of the SVG `matrix(a b c d e f)`.
+
+struct IdentityTransform {};
+
+struct TranslateTransform {
+    double tx = 0, ty = 0;
+};
+
+// Scales around the origin, then translates, as for a viewBox or a change of resolution.
+struct ScaleTransform {
+    double sx = 1, sy = 1;
+    double tx = 0, ty = 0;
+};
+
+struct AffineTransform {
+    double a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+
+    AffineTransform() = default;
+    AffineTransform(double a_, double b_, double c_, double d_, double e_, double f_)
+        : a(a_), b(b_), c(c_), d(d_), e(e_), f(f_) {
+    }
+    AffineTransform(const TranslateTransform& t) : e(t.tx), f(t.ty) {
+    }
+    AffineTransform(const ScaleTransform& t) : a(t.sx), d(t.sy), e(t.tx), f(t.ty) {
+    }
+
+    double determinant() const {
+        return a * d - b * c;
+    }
+
+    void transformPoint(double& x, double& y) const {
+        const double x_ = a * x + c * y + e;
+        y = b * x + d * y + f;
+        x = x_;
+    }
+
+    // Applies the linear part only, as for relative coordinates.
+    void transformVector(double& x, double& y) const {
+        const double x_ = a * x + c * y;
+        y = b * x + d * y;
+        x = x_;
+    }
+
+    // The transform that applies `other` first, then this one, like `transform="this other"`.
+    AffineTransform operator*(const AffineTransform& other) const {
+        return { a * other.a + c * other.b,     b * other.a + d * other.b,
+                 a * other.c + c * other.d,     b * other.c + d * other.d,
+                 a * other.e + c * other.f + e, b * other.e + d * other.f + f };
+    }
+};
+
+namespace detail {
+
+// Radii and rotation of the ellipse (rx, ry, xAxisRotation) after the linear map
+// [a c; b d]: the singular values of the map applied to the ellipse axes, and the direction of
+// the larger one. Returns false if the ellipse collapses to a line, so the arc is one too.
+inline bool transformEllipse(const double a,
+                             const double b,
+                             const double c,
+                             const double d,
+                             double& rx,
+                             double& ry,
+                             double& xAxisRotation) {
+    const double pi = 3.14159265358979323846;
+    const double determinant = a * d - b * c;
+    if (rx == 0 || ry == 0 || determinant == 0) {
+        return false;
+    }
+    const double phi = xAxisRotation * pi / 180;
+    const double cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+    // The images of the two semi-axes.
+    const double ux = rx * (a * cosPhi + c * sinPhi), uy = rx * (b * cosPhi + d * sinPhi);
+    const double vx = ry * (c * cosPhi - a * sinPhi), vy = ry * (d * cosPhi - b * sinPhi);
+
+    // Eigenvalues of N * N^T, where N has the columns u and v.
+    const double p = ux * ux + vx * vx;
+    const double r = uy * uy + vy * vy;
+    const double q = ux * uy + vx * vy;
+    const double half = (p - r) / 2;
+    const double spread = std::sqrt(half * half + q * q);
+    const double major = std::sqrt((p + r) / 2 + spread);
+    // The product of the radii is |det N|, which is more accurate than the smaller eigenvalue.
+    const double minor = std::abs(determinant * rx * ry) / major;
+
+    xAxisRotation = spread > 0 ? std::atan2(q, half) / 2 * 180 / pi : 0;
+    rx = major;
+    ry = minor;
+    return true;
+}
+
+} // namespace detail
+
+// Adapter between PathParser and any VertexReceiver that applies a 2x3 matrix to the commands as
+// they stream through, without materializing the path.
+//
+// Usage:
+//
+// VertexReceiver receiver;
+// mapbox::svg::AffineTransform matrix(2, 0, 0, 2, 10, 10);
+// mapbox::svg::PathTransform<VertexReceiver> transform(receiver, matrix);
+// mapbox::svg::PathParser<mapbox::svg::PathTransform<VertexReceiver>> parser(transform);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+//
+// Relative commands stay relative, with only the linear part applied, and smooth curves stay
+// smooth, since reflecting a control point commutes with the transform. Arcs get the radii and
+// rotation of the transformed ellipse, and the sweep flips if the transform mirrors. Horizontal
+// and vertical lines stay so where the transform allows it, and become lines otherwise.
+//
+// The Transform is one of IdentityTransform, TranslateTransform, ScaleTransform or
+// AffineTransform, and each has its own specialization, so that the common cases cost next to
+// nothing. Call `reset()` before reusing a PathTransform for another path.
+
+template <typename VertexReceiver, typename Transform = AffineTransform>
+class PathTransform;
+
+template <typename VertexReceiver>
+class PathTransform<VertexReceiver, IdentityTransform> {
+public:
+    PathTransform(VertexReceiver& t_, const IdentityTransform& = {}) : t(t_) {
+    }
+    PathTransform(const PathTransform&) = delete;
+    PathTransform(PathTransform&&) = delete;
+
+    void reset() {
+    }
+
+    void moveTo(double x, double y, bool relative) {
+        t.moveTo(x, y, relative);
+    }
+
+    void closePath() {
+        t.closePath();
+    }
+
+    // Only there if VertexReceiver takes implicit linetos too, so that both agree on where the
+    // subpath starts.
+    template <typename R = VertexReceiver>
+    auto implicitLineTo(double x, double y, bool relative)
+        -> decltype(std::declval<R&>().implicitLineTo(x, y, relative)) {
+        return t.implicitLineTo(x, y, relative);
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        t.lineTo(x, y, relative);
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        t.horizontalLineTo(x, relative);
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        t.verticalLineTo(y, relative);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        t.curveTo(x1, y1, x2, y2, x, y, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        t.smoothCurveTo(x2, y2, x, y, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        t.quadraticCurveTo(x1, y1, x, y, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        t.smoothQuadraticCurveTo(x, y, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        t.arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative);
+    }
+
+private:
+    VertexReceiver& t;
+};
+
+template <typename VertexReceiver>
+class PathTransform<VertexReceiver, TranslateTransform> {
+public:
+    PathTransform(VertexReceiver& t_, const TranslateTransform& transform_)
+        : t(t_), transform(transform_) {
+    }
+    PathTransform(const PathTransform&) = delete;
+    PathTransform(PathTransform&&) = delete;
+
+    void reset() {
+        started = false;
+    }
+
+    // A relative moveto at the start of a path is relative to the origin, which moves.
+    void moveTo(double x, double y, bool relative) {
+        if (!started) {
+            relative = false;
+            started = true;
+        }
+        point(x, y, relative);
+        t.moveTo(x, y, relative);
+    }
+
+    void closePath() {
+        t.closePath();
+    }
+
+    template <typename R = VertexReceiver>
+    auto implicitLineTo(double x, double y, bool relative)
+        -> decltype(std::declval<R&>().implicitLineTo(x, y, relative)) {
+        point(x, y, relative);
+        return t.implicitLineTo(x, y, relative);
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        point(x, y, relative);
+        t.lineTo(x, y, relative);
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        t.horizontalLineTo(relative ? x : x + transform.tx, relative);
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        t.verticalLineTo(relative ? y : y + transform.ty, relative);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        point(x1, y1, relative);
+        point(x2, y2, relative);
+        point(x, y, relative);
+        t.curveTo(x1, y1, x2, y2, x, y, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        point(x2, y2, relative);
+        point(x, y, relative);
+        t.smoothCurveTo(x2, y2, x, y, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        point(x1, y1, relative);
+        point(x, y, relative);
+        t.quadraticCurveTo(x1, y1, x, y, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        point(x, y, relative);
+        t.smoothQuadraticCurveTo(x, y, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        point(x, y, relative);
+        t.arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative);
+    }
+
+private:
+    void point(double& x, double& y, const bool relative) const {
+        if (!relative) {
+            x += transform.tx;
+            y += transform.ty;
+        }
+    }
+
+    VertexReceiver& t;
+    const TranslateTransform transform;
+    bool started = false;
+};
+
+template <typename VertexReceiver>
+class PathTransform<VertexReceiver, ScaleTransform> {
+public:
+    PathTransform(VertexReceiver& t_, const ScaleTransform& transform_)
+        : t(t_), transform(transform_) {
+    }
+    PathTransform(const PathTransform&) = delete;
+    PathTransform(PathTransform&&) = delete;
+
+    void reset() {
+        started = false;
+    }
+
+    // A relative moveto at the start of a path is relative to the origin, which moves.
+    void moveTo(double x, double y, bool relative) {
+        if (!started) {
+            relative = false;
+            started = true;
+        }
+        point(x, y, relative);
+        t.moveTo(x, y, relative);
+    }
+
+    void closePath() {
+        t.closePath();
+    }
+
+    template <typename R = VertexReceiver>
+    auto implicitLineTo(double x, double y, bool relative)
+        -> decltype(std::declval<R&>().implicitLineTo(x, y, relative)) {
+        point(x, y, relative);
+        return t.implicitLineTo(x, y, relative);
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        point(x, y, relative);
+        t.lineTo(x, y, relative);
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        t.horizontalLineTo(transform.sx * x + (relative ? 0 : transform.tx), relative);
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        t.verticalLineTo(transform.sy * y + (relative ? 0 : transform.ty), relative);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        point(x1, y1, relative);
+        point(x2, y2, relative);
+        point(x, y, relative);
+        t.curveTo(x1, y1, x2, y2, x, y, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        point(x2, y2, relative);
+        point(x, y, relative);
+        t.smoothCurveTo(x2, y2, x, y, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        point(x1, y1, relative);
+        point(x, y, relative);
+        t.quadraticCurveTo(x1, y1, x, y, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        point(x, y, relative);
+        t.smoothQuadraticCurveTo(x, y, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        point(x, y, relative);
+        const double sx = transform.sx, sy = transform.sy;
+        if (xAxisRotation == 0 || sx == sy) {
+            // The axes stay aligned with the ellipse axes.
+            rx *= std::abs(sx);
+            ry *= std::abs(sy);
+        } else if (sx == -sy) {
+            rx *= std::abs(sx);
+            ry *= std::abs(sy);
+            xAxisRotation = -xAxisRotation;
+        } else if (!detail::transformEllipse(sx, 0, 0, sy, rx, ry, xAxisRotation)) {
+            t.lineTo(x, y, relative);
+            return;
+        }
+        t.arc(rx, ry, xAxisRotation, largeArcFlag, (sx * sy < 0) != sweepFlag, x, y, relative);
+    }
+
+private:
+    void point(double& x, double& y, const bool relative) const {
+        x *= transform.sx;
+        y *= transform.sy;
+        if (!relative) {
+            x += transform.tx;
+            y += transform.ty;
+        }
+    }
+
+    VertexReceiver& t;
+    const ScaleTransform transform;
+    bool started = false;
+};
+
+// The general case. Horizontal and vertical lines stay so if the transform has no rotation or
+// skew, and otherwise need the current point, which is tracked in the untransformed space.
+template <typename VertexReceiver>
+class PathTransform<VertexReceiver, AffineTransform> {
+public:
+    PathTransform(VertexReceiver& t_, const AffineTransform& transform_)
+        : t(t_), transform(transform_), axisAligned(transform.b == 0 && transform.c == 0) {
+    }
+    PathTransform(const PathTransform&) = delete;
+    PathTransform(PathTransform&&) = delete;
+
+    void reset() {
+        x = y = 0;
+        startX = startY = 0;
+        started = false;
+    }
+
+    // A relative moveto at the start of a path is relative to the origin, which moves.
+    void moveTo(double x_, double y_, bool relative) {
+        if (!started) {
+            relative = false;
+            started = true;
+        }
+        advance(x_, y_, relative);
+        startX = x;
+        startY = y;
+        point(x_, y_, relative);
+        t.moveTo(x_, y_, relative);
+    }
+
+    void closePath() {
+        x = startX;
+        y = startY;
+        t.closePath();
+    }
+
+    template <typename R = VertexReceiver>
+    auto implicitLineTo(double x_, double y_, bool relative)
+        -> decltype(std::declval<R&>().implicitLineTo(x_, y_, relative)) {
+        advance(x_, y_, relative);
+        point(x_, y_, relative);
+        return t.implicitLineTo(x_, y_, relative);
+    }
+
+    void lineTo(double x_, double y_, bool relative) {
+        advance(x_, y_, relative);
+        point(x_, y_, relative);
+        t.lineTo(x_, y_, relative);
+    }
+
+    void horizontalLineTo(double x_, bool relative) {
+        if (axisAligned) {
+            advance(x_, relative ? 0 : y, relative);
+            t.horizontalLineTo(transform.a * x_ + (relative ? 0 : transform.e), relative);
+        } else {
+            lineTo(x_, relative ? 0 : y, relative);
+        }
+    }
+
+    void verticalLineTo(double y_, bool relative) {
+        if (axisAligned) {
+            advance(relative ? 0 : x, y_, relative);
+            t.verticalLineTo(transform.d * y_ + (relative ? 0 : transform.f), relative);
+        } else {
+            lineTo(relative ? 0 : x, y_, relative);
+        }
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x_, double y_, bool relative) {
+        advance(x_, y_, relative);
+        point(x1, y1, relative);
+        point(x2, y2, relative);
+        point(x_, y_, relative);
+        t.curveTo(x1, y1, x2, y2, x_, y_, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x_, double y_, bool relative) {
+        advance(x_, y_, relative);
+        point(x2, y2, relative);
+        point(x_, y_, relative);
+        t.smoothCurveTo(x2, y2, x_, y_, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x_, double y_, bool relative) {
+        advance(x_, y_, relative);
+        point(x1, y1, relative);
+        point(x_, y_, relative);
+        t.quadraticCurveTo(x1, y1, x_, y_, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x_, double y_, bool relative) {
+        advance(x_, y_, relative);
+        point(x_, y_, relative);
+        t.smoothQuadraticCurveTo(x_, y_, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x_,
+             double y_,
+             bool relative) {
+        advance(x_, y_, relative);
+        point(x_, y_, relative);
+        if (!detail::transformEllipse(transform.a, transform.b, transform.c, transform.d, rx, ry,
+                                      xAxisRotation)) {
+            t.lineTo(x_, y_, relative);
+            return;
+        }
+        const bool mirrored = transform.determinant() < 0;
+        t.arc(rx, ry, xAxisRotation, largeArcFlag, mirrored != sweepFlag, x_, y_, relative);
+    }
+
+private:
+    void advance(const double x_, const double y_, const bool relative) {
+        x = relative ? x + x_ : x_;
+        y = relative ? y + y_ : y_;
+    }
+
+    void point(double& x_, double& y_, const bool relative) const {
+        if (relative) {
+            transform.transformVector(x_, y_);
+        } else {
+            transform.transformPoint(x_, y_);
+        }
+    }
+
+    VertexReceiver& t;
+    const AffineTransform transform;
+    const bool axisAligned;
+
+    // The current point and the start of the current subpath, before the transform.
+    double x = 0, y = 0;
+    double startX = 0, startY = 0;
+    bool started = false;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <mapbox/svg/path_buffer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include <cstddef>
+
+namespace mapbox {
+namespace svg {
+
+struct PathStatistics {
+    // All commands, implicit repetitions included.
+    std::size_t commands = 0;
+    // Moveto commands, and drawing commands that directly follow a closepath.
+    std::size_t subpaths = 0;
+    // Numbers in the text for each PathVerb, arc flags included. The pairs after the first one of
+    // a moveto are implicit linetos, and count as LineTo.
+    std::size_t numbers[10] = {};
+
+    // Number of coordinates a PathBuffer needs for the path: the numbers without the arc flags.
+    std::size_t coordinates() const {
+        std::size_t count = 0;
+        for (const std::size_t n : numbers) {
+            count += n;
+        }
+        return count - numbers[static_cast<uint8_t>(PathVerb::Arc)] / 7 * 2;
+    }
+};
+
+namespace detail {
+
+class StatisticsReceiver {
+public:
+    using Number = UnconvertedNumber;
+
+    void reset() {
+        statistics = PathStatistics();
+        closed = false;
+    }
+
+    void moveTo(Number, Number, bool) {
+        add(PathVerb::MoveTo, 2);
+        ++statistics.subpaths;
+        closed = false;
+    }
+
+    void implicitLineTo(Number, Number, bool) {
+        draw(PathVerb::LineTo, 2);
+    }
+
+    void closePath() {
+        add(PathVerb::ClosePath, 0);
+        closed = true;
+    }
+
+    void lineTo(Number, Number, bool) {
+        draw(PathVerb::LineTo, 2);
+    }
+
+    void horizontalLineTo(Number, bool) {
+        draw(PathVerb::HorizontalLineTo, 1);
+    }
+
+    void verticalLineTo(Number, bool) {
+        draw(PathVerb::VerticalLineTo, 1);
+    }
+
+    void curveTo(Number, Number, Number, Number, Number, Number, bool) {
+        draw(PathVerb::CurveTo, 6);
+    }
+
+    void smoothCurveTo(Number, Number, Number, Number, bool) {
+        draw(PathVerb::SmoothCurveTo, 4);
+    }
+
+    void quadraticCurveTo(Number, Number, Number, Number, bool) {
+        draw(PathVerb::QuadraticCurveTo, 4);
+    }
+
+    void smoothQuadraticCurveTo(Number, Number, bool) {
+        draw(PathVerb::SmoothQuadraticCurveTo, 2);
+    }
+
+    void arc(Number, Number, Number, bool, bool, Number, Number, bool) {
+        draw(PathVerb::Arc, 7);
+    }
+
+    PathStatistics statistics;
+
+private:
+    void add(const PathVerb verb, const std::size_t numbers) {
+        ++statistics.commands;
+        statistics.numbers[static_cast<uint8_t>(verb)] += numbers;
+    }
+
+    void draw(const PathVerb verb, const std::size_t numbers) {
+        add(verb, numbers);
+        if (closed) {
+            ++statistics.subpaths;
+            closed = false;
+        }
+    }
+
+    bool closed = false;
+};
+
+} // namespace detail
+
+// Checks a path against the grammar without converting any numbers, and counts what a full parse
+// would produce. Errors and their offsets are the same as PathParser's.
+//
+// Usage:
+//
+// mapbox::svg::PathValidator validator;
+// if (validator("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z")) {
+//     const mapbox::svg::PathStatistics& stats = validator.statistics();
+//     buffer.reserve(stats.commands, stats.coordinates());
+// }
+//
+// The statistics cover the commands before an error, like the calls a receiver would have seen.
+
+class PathValidator {
+public:
+    PathValidator() : parser(receiver) {
+    }
+    PathValidator(const PathValidator&) = delete;
+    PathValidator(PathValidator&&) = delete;
+
+    bool operator()(const char* str) {
+        receiver.reset();
+        return parser(str);
+    }
+
+    template <typename String>
+    auto operator()(const String& str) -> decltype(str.data(), str.size(), bool()) {
+        return (*this)(str.data(), str.size());
+    }
+
+    bool operator()(const char* str, std::size_t length) {
+        receiver.reset();
+        return parser(str, length);
+    }
+
+    bool hasError() const {
+        return parser.hasError();
+    }
+
+    PathParseErrorType errorType() const {
+        return parser.errorType();
+    }
+
+    std::ptrdiff_t errorOffset() const {
+        return parser.errorOffset();
+    }
+
+    const PathStatistics& statistics() const {
+        return receiver.statistics;
+    }
+
+private:
+    detail::StatisticsReceiver receiver;
+    PathParser<detail::StatisticsReceiver, UnconvertedNumber> parser;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,564 @@
+#pragma once
+
+#include <mapbox/svg/number_parser.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <string>
+
+namespace mapbox {
+namespace svg {
+namespace detail {
+
+// Writes mantissa * 10^exponent in the shorter of plain and scientific notation, without a
+// leading zero before the decimal point. Returns the number of characters, at most 26.
+inline std::size_t writeDecimal(const bool negative, uint64_t mantissa, int exponent, char* out) {
+    if (mantissa == 0) {
+        out[0] = '0';
+        return 1;
+    }
+    while (mantissa % 10 == 0) {
+        mantissa /= 10;
+        ++exponent;
+    }
+    char digits[20];
+    int count = 0;
+    for (; mantissa != 0; mantissa /= 10) {
+        digits[19 - count++] = char('0' + mantissa % 10);
+    }
+    const char* const first = digits + 20 - count;
+
+    char* cursor = out;
+    if (negative) {
+        *cursor++ = '-';
+    }
+    int exponentDigits = 1;
+    for (int e = exponent < 0 ? -exponent : exponent; e >= 10; e /= 10) {
+        ++exponentDigits;
+    }
+    const int scientific = count + 1 + (exponent < 0) + exponentDigits;
+    const int plain = exponent >= 0 ? count + exponent : std::max(count, -exponent) + 1;
+    if (scientific < plain) {
+        cursor = std::copy(first, first + count, cursor);
+        cursor += std::snprintf(cursor, 8, "e%d", exponent);
+    } else if (exponent >= 0) {
+        cursor = std::copy(first, first + count, cursor);
+        cursor = std::fill_n(cursor, exponent, '0');
+    } else if (-exponent >= count) {
+        *cursor++ = '.';
+        cursor = std::fill_n(cursor, -exponent - count, '0');
+        cursor = std::copy(first, first + count, cursor);
+    } else {
+        cursor = std::copy(first, first + count + exponent, cursor);
+        *cursor++ = '.';
+        cursor = std::copy(first + count + exponent, first + count, cursor);
+    }
+    return std::size_t(cursor - out);
+}
+
+#if defined(__SIZEOF_INT128__)
+
+// Finds the fewest decimals, at most 21, with which magnitude * 10^places rounds to an integer
+// `digits` that reads back as `magnitude`, for magnitudes below 2^53 that are not tiny. The test
+// is exact: it checks whether the integer lies within the interval of reals that round to the
+// double, in units of 2^-(shift + 2). Returns false if no such number of decimals was found.
+inline bool shortestDecimals(const double magnitude, uint64_t& digits, int& places, int&) {
+    using uint128 = unsigned __int128;
+    const double limit = double(maxExactMantissa);
+    if (!(magnitude >= std::numeric_limits<double>::min() && magnitude < limit)) {
+        return false;
+    }
+    int exponent = 0;
+    const uint64_t m = uint64_t(std::ldexp(std::frexp(magnitude, &exponent), 53));
+    const int shift = 53 - exponent;
+    if (shift > 125) {
+        return false;
+    }
+    // Ties round to the even mantissa, and the gap below a power of two is half as wide.
+    const bool inclusive = m % 2 == 0;
+    const uint128 below = m == maxExactMantissa / 2 ? 1 : 2;
+
+    uint128 result = 0;
+    const auto fits = [&](const int q) {
+        const uint128 power = q <= 16 ? uint128(integerPowerOfTen(unsigned(q)))
+                                      : uint128(integerPowerOfTen(16)) * integerPowerOfTen(q - 16);
+        const uint128 low = (uint128(4) * m - below) * power;
+        const uint128 high = (uint128(4) * m + 2) * power;
+        const uint128 rounded = ((uint128(m) * power) + ((uint128(1) << shift) >> 1)) >> shift;
+        for (uint128 n = rounded; n <= rounded + (below == 1); ++n) {
+            const uint128 scaled = n << (shift + 2);
+            if (inclusive ? low <= scaled && scaled <= high : low < scaled && scaled < high) {
+                result = n;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Integers are common enough to try first. Beyond that, every number that fits with some
+    // decimals also fits with more.
+    int lowest = 1, highest = 21;
+    if (fits(0)) {
+        digits = uint64_t(result);
+        places = 0;
+        return true;
+    }
+    if (!fits(highest)) {
+        return false;
+    }
+    while (lowest < highest) {
+        const int middle = (lowest + highest) / 2;
+        if (fits(middle)) {
+            highest = middle;
+        } else {
+            lowest = middle + 1;
+        }
+    }
+    fits(lowest);
+    digits = uint64_t(result);
+    places = lowest;
+    return true;
+}
+
+#else
+
+// Tries one more decimal at a time while the scaled value is an exact integer, so that the
+// candidate converts back with a single correctly rounded division. When that runs out, all
+// candidates with up to 15 significant digits were covered.
+inline bool shortestDecimals(const double magnitude, uint64_t& digits, int& places, int& covered) {
+    const double limit = double(maxExactMantissa);
+    if (!(magnitude < limit)) {
+        return false;
+    }
+    for (places = 0; places <= 22; ++places) {
+        const double scaled = std::round(magnitude * exactPowerOfTen(places));
+        if (scaled >= limit) {
+            covered = 15;
+            return false;
+        }
+        if (scaled / exactPowerOfTen(places) == magnitude) {
+            digits = uint64_t(scaled);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
+
+// Writes the shortest decimal that parseNumber reads back as exactly `value`. Returns the number
+// of characters, at most 26. Values that no path can express, infinities and NaN, are written as
+// 0.
+inline std::size_t writeShortest(const double value, char* out) {
+    const double magnitude = std::abs(value);
+    const bool negative = value < 0;
+    if (magnitude == 0 || !std::isfinite(magnitude)) {
+        out[0] = '0';
+        return 1;
+    }
+
+    uint64_t mantissa = 0;
+    int places = 0;
+    int covered = 0;
+    if (shortestDecimals(magnitude, mantissa, places, covered)) {
+        return writeDecimal(negative, mantissa, -places, out);
+    }
+
+    // Otherwise take the digits from snprintf, and check them with the parser.
+    for (int digits = covered + 1; digits <= 17; ++digits) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.*e", digits - 1, magnitude);
+        mantissa = 0;
+        const char* cursor = text;
+        for (; *cursor != 'e'; ++cursor) {
+            if (isDigit(*cursor)) {
+                mantissa = mantissa * 10 + uint64_t(*cursor - '0');
+            }
+        }
+        const int exponent = std::atoi(cursor + 1) - (digits - 1);
+        const std::size_t length = writeDecimal(false, mantissa, exponent, text);
+        double parsed = 0;
+        parseNumber(text, text + length, parsed);
+        if (parsed == magnitude || digits == 17) {
+            return writeDecimal(negative, mantissa, exponent, out);
+        }
+    }
+    return 0;
+}
+
+} // namespace detail
+
+// NormalizedReceiver (see PathNormalizer) that writes the path back as a short `d` string.
+//
+// Usage:
+//
+// std::string d;
+// mapbox::svg::NormalizedPathWriter writer(d);
+// mapbox::svg::PathFlattener<mapbox::svg::NormalizedPathWriter> flattener(writer, 0.25);
+//
+// See PathWriter for the output.
+
+class NormalizedPathWriter {
+public:
+    // Writes numbers with at most `precision` decimals, or, if it is negative, the shortest that
+    // read back as the exact value.
+    NormalizedPathWriter(std::string& out_, int precision_ = -1)
+        : out(out_),
+          precision(std::min(precision_, 15)),
+          scale(precision < 0 ? 1 : detail::exactPowerOfTen(precision)) {
+        reset();
+    }
+    NormalizedPathWriter(const NormalizedPathWriter&) = delete;
+    NormalizedPathWriter(NormalizedPathWriter&&) = delete;
+
+    // Forgets the current point before writing another path. The output is appended to as is.
+    void reset() {
+        x = y = 0;
+        startX = startY = 0;
+        controlX = controlY = 0;
+        previous = Previous::None;
+        implicit = 0;
+        last = Token::None;
+    }
+
+    void moveTo(double x_, double y_) {
+        const double ux = units(x_), uy = units(y_);
+        Text absolute, relative;
+        absolute.coordinate(*this, ux, x_).coordinate(*this, uy, y_);
+        relative.coordinate(*this, ux - x).coordinate(*this, uy - y);
+        emit('M', absolute, relative, exact(ux, x) && exact(uy, y));
+        // Pairs after a moveto are linetos, relative if it is, so a lineto needs no letter.
+        implicit = implicit == 'm' ? 'l' : 'L';
+        x = startX = ux;
+        y = startY = uy;
+        previous = Previous::None;
+    }
+
+    void closePath() {
+        out += 'Z';
+        implicit = 0;
+        last = Token::None;
+        x = startX;
+        y = startY;
+        previous = Previous::None;
+    }
+
+    void lineTo(double x_, double y_) {
+        const double ux = units(x_), uy = units(y_);
+        Text absolute, relative;
+        if (uy == y) {
+            absolute.coordinate(*this, ux, x_);
+            relative.coordinate(*this, ux - x);
+            emit('H', absolute, relative, exact(ux, x));
+        } else if (ux == x) {
+            absolute.coordinate(*this, uy, y_);
+            relative.coordinate(*this, uy - y);
+            emit('V', absolute, relative, exact(uy, y));
+        } else {
+            absolute.coordinate(*this, ux, x_).coordinate(*this, uy, y_);
+            relative.coordinate(*this, ux - x).coordinate(*this, uy - y);
+            emit('L', absolute, relative, exact(ux, x) && exact(uy, y));
+        }
+        x = ux;
+        y = uy;
+        previous = Previous::None;
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x_, double y_) {
+        const double ux1 = units(x1), uy1 = units(y1), ux2 = units(x2), uy2 = units(y2);
+        const double ux = units(x_), uy = units(y_);
+        Text absolute, relative;
+        bool exactRelative = exact(ux2, x) && exact(uy2, y) && exact(ux, x) && exact(uy, y);
+        const bool smooth = previous == Previous::Cubic
+                                ? ux1 == 2 * x - controlX && uy1 == 2 * y - controlY
+                                : ux1 == x && uy1 == y;
+        if (!smooth) {
+            absolute.coordinate(*this, ux1, x1).coordinate(*this, uy1, y1);
+            relative.coordinate(*this, ux1 - x).coordinate(*this, uy1 - y);
+            exactRelative = exactRelative && exact(ux1, x) && exact(uy1, y);
+        }
+        absolute.coordinate(*this, ux2, x2).coordinate(*this, uy2, y2);
+        absolute.coordinate(*this, ux, x_).coordinate(*this, uy, y_);
+        relative.coordinate(*this, ux2 - x).coordinate(*this, uy2 - y);
+        relative.coordinate(*this, ux - x).coordinate(*this, uy - y);
+        emit(smooth ? 'S' : 'C', absolute, relative, exactRelative);
+        x = ux;
+        y = uy;
+        controlX = ux2;
+        controlY = uy2;
+        previous = Previous::Cubic;
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x_, double y_) {
+        const double ux1 = units(x1), uy1 = units(y1), ux = units(x_), uy = units(y_);
+        Text absolute, relative;
+        bool exactRelative = exact(ux, x) && exact(uy, y);
+        const bool smooth = previous == Previous::Quadratic
+                                ? ux1 == 2 * x - controlX && uy1 == 2 * y - controlY
+                                : ux1 == x && uy1 == y;
+        if (!smooth) {
+            absolute.coordinate(*this, ux1, x1).coordinate(*this, uy1, y1);
+            relative.coordinate(*this, ux1 - x).coordinate(*this, uy1 - y);
+            exactRelative = exactRelative && exact(ux1, x) && exact(uy1, y);
+        }
+        absolute.coordinate(*this, ux, x_).coordinate(*this, uy, y_);
+        relative.coordinate(*this, ux - x).coordinate(*this, uy - y);
+        emit(smooth ? 'T' : 'Q', absolute, relative, exactRelative);
+        x = ux;
+        y = uy;
+        controlX = ux1;
+        controlY = uy1;
+        previous = Previous::Quadratic;
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x_,
+             double y_) {
+        const double ux = units(x_), uy = units(y_);
+        Text absolute, relative;
+        for (Text* text : { &absolute, &relative }) {
+            text->value(*this, std::abs(rx)).value(*this, std::abs(ry));
+            text->value(*this, xAxisRotation).flag(largeArcFlag).flag(sweepFlag);
+        }
+        absolute.coordinate(*this, ux, x_).coordinate(*this, uy, y_);
+        relative.coordinate(*this, ux - x).coordinate(*this, uy - y);
+        emit('A', absolute, relative, exact(ux, x) && exact(uy, y));
+        x = ux;
+        y = uy;
+        previous = Previous::None;
+    }
+
+private:
+    // What the output ends with, which decides whether the next number needs a separator.
+    enum class Token : uint8_t { None, Number, NumberWithPoint, Flag };
+
+    // The arguments of one command.
+    struct Text {
+        char text[256];
+        std::size_t length = 0;
+        char first = 0;
+        Token last = Token::None;
+
+        // `value` is the coordinate the units were rounded from.
+        Text& coordinate(const NormalizedPathWriter& writer,
+                         const double units,
+                         const double value) {
+            char number[32];
+            return append(number, writer.formatUnits(units, value, number));
+        }
+
+        // A difference of units. Those only count when they are small enough to be exact.
+        Text& coordinate(const NormalizedPathWriter& writer, const double units) {
+            return coordinate(writer, units, units / writer.scale);
+        }
+
+        Text& value(const NormalizedPathWriter& writer, const double value) {
+            return coordinate(writer, writer.units(value), value);
+        }
+
+        Text& flag(const bool value) {
+            const char digit = value ? '1' : '0';
+            if (separated(last, digit)) {
+                text[length++] = ' ';
+            }
+            if (length == 0) {
+                first = digit;
+            }
+            text[length++] = digit;
+            last = Token::Flag;
+            return *this;
+        }
+
+        Text& append(const char* number, const std::size_t size) {
+            if (separated(last, number[0])) {
+                text[length++] = ' ';
+            }
+            if (length == 0) {
+                first = number[0];
+            }
+            bool point = false;
+            for (std::size_t i = 0; i < size; ++i) {
+                point = point || number[i] == '.' || number[i] == 'e';
+                text[length++] = number[i];
+            }
+            last = point ? Token::NumberWithPoint : Token::Number;
+            return *this;
+        }
+    };
+
+    enum class Previous : uint8_t { None, Cubic, Quadratic };
+
+    // Whether a separator is needed to keep the next character from continuing the output.
+    static bool separated(const Token last, const char next) {
+        switch (last) {
+            case Token::Number: return next != '-';
+            case Token::NumberWithPoint: return next != '-' && next != '.';
+            default: return false;
+        }
+    }
+
+    // Coordinates are tracked in the units of the output: integers counting 10^-precision, or
+    // plain values for the shortest round trip.
+    double units(const double value) const {
+        return precision < 0 ? value : std::round(value * scale);
+    }
+
+    // Writes the units as a decimal, or, beyond the range of integers, `value` itself: it has no
+    // decimals to round off at that size, while dividing the units by the scale would change it.
+    std::size_t formatUnits(const double units, const double value, char* number) const {
+        if (precision < 0) {
+            return detail::writeShortest(units, number);
+        }
+        if (std::abs(units) < 9e18) {
+            return detail::writeDecimal(units < 0, uint64_t(std::abs(units)), -precision, number);
+        }
+        return detail::writeShortest(value, number);
+    }
+
+    // Whether a relative coordinate reads back as exactly the absolute one. Differences of
+    // integers are exact, as long as they stay below 2^53.
+    bool exact(const double target, const double origin) const {
+        return precision < 0 ? origin + (target - origin) == target
+                             : std::abs(target) < 9e15 && std::abs(origin) < 9e15;
+    }
+
+    // Writes the command in the shorter of its absolute and relative forms, leaving out the
+    // letter if it repeats the previous one.
+    void emit(const char command, const Text& absolute, const Text& relative, const bool exact) {
+        const char lower = char(command - 'A' + 'a');
+        const std::size_t absoluteCost = cost(command, absolute);
+        const bool useRelative = exact && cost(lower, relative) < absoluteCost;
+        const char letter = useRelative ? lower : command;
+        const Text& text = useRelative ? relative : absolute;
+        if (letter != implicit) {
+            out += letter;
+        } else if (separated(last, text.first)) {
+            out += ' ';
+        }
+        out.append(text.text, text.length);
+        implicit = letter;
+        last = text.last;
+    }
+
+    std::size_t cost(const char letter, const Text& text) const {
+        return text.length + (letter != implicit || separated(last, text.first));
+    }
+
+    std::string& out;
+    const int precision;
+    const double scale;
+
+    // The current point, the start of the subpath and the last control point, in units.
+    double x, y;
+    double startX, startY;
+    double controlX, controlY;
+    Previous previous;
+
+    // The command that may follow without its letter, and the end of the output.
+    char implicit;
+    Token last;
+};
+
+// VertexReceiver that writes the path back as a short `d` string, the inverse of PathParser.
+//
+// Usage:
+//
+// std::string d;
+// mapbox::svg::PathWriter writer(d, 3);
+// mapbox::svg::PathParser<mapbox::svg::PathWriter> parser(writer);
+// parser("M 6.0000, 12.0000 L 4, 4 a 2 2 0 1 1 -2 2 A 2 2 0 0 1 6 12 Z");
+// // d == "M6 12 4 4A2 2 0 112 6a2 2 0 014 6Z"
+//
+// Each command gets the shorter of its absolute and relative forms, lines and curves become
+// horizontal, vertical or smooth where their points allow it, repeated command letters and
+// separators are left out where the grammar allows it, and numbers drop leading zeros and use
+// an exponent when that is shorter. Numbers have at most `precision` decimals, or are the shortest
+// that read back as the exact value if it is negative. Relative forms are only used when they
+// add up to the same coordinates.
+//
+// The output is appended to the given string, so one buffer can be reused for many paths: clear
+// it and call `reset()` in between.
+
+class PathWriter {
+public:
+    PathWriter(std::string& out, int precision = -1) : writer(out, precision), normalizer(writer) {
+    }
+    PathWriter(const PathWriter&) = delete;
+    PathWriter(PathWriter&&) = delete;
+
+    void reset() {
+        writer.reset();
+        normalizer.reset();
+    }
+
+    // VertexReceiver interface.
+
+    void moveTo(double x, double y, bool relative) {
+        normalizer.moveTo(x, y, relative);
+    }
+
+    void implicitLineTo(double x, double y, bool relative) {
+        normalizer.implicitLineTo(x, y, relative);
+    }
+
+    void closePath() {
+        normalizer.closePath();
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        normalizer.lineTo(x, y, relative);
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        normalizer.horizontalLineTo(x, relative);
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        normalizer.verticalLineTo(y, relative);
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        normalizer.curveTo(x1, y1, x2, y2, x, y, relative);
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        normalizer.smoothCurveTo(x2, y2, x, y, relative);
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        normalizer.quadraticCurveTo(x1, y1, x, y, relative);
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        normalizer.smoothQuadraticCurveTo(x, y, relative);
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y,
+             bool relative) {
+        normalizer.arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative);
+    }
+
+private:
+    NormalizedPathWriter writer;
+    PathNormalizer<NormalizedPathWriter> normalizer;
+};
+
+} // namespace svg
+} // namespace mapbox
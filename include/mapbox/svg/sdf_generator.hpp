@@ -0,0 +1,323 @@
+#pragma once
+
+#include <mapbox/svg/fill_rule.hpp>
+#include <mapbox/svg/worker_threads.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+
+struct SdfOptions {
+    // Size of the area the path is drawn in, in pixels, without the buffer.
+    unsigned width = 24;
+    unsigned height = 24;
+
+    // Pixels added on every side, so that the field can extend beyond the shape.
+    unsigned buffer = 3;
+
+    // Distance in pixels that the 8-bit range covers, and the part of the range inside the shape:
+    // the edge maps to 255 * (1 - cutoff).
+    double radius = 8;
+    double cutoff = 0.25;
+
+    FillRule fillRule = FillRule::NonZero;
+
+    // Number of threads for the rows, or 0 for the number of cores.
+    unsigned threads = 0;
+};
+
+namespace detail {
+
+struct SdfSegment {
+    double x0, y0, x1, y1;
+    // Saves a division for every distance.
+    double inverseLengthSquared;
+};
+
+inline SdfSegment
+makeSdfSegment(const double x0, const double y0, const double x1, const double y1) {
+    const double lengthSquared = (x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0);
+    return { x0, y0, x1, y1, lengthSquared > 0 ? 1 / lengthSquared : 0 };
+}
+
+inline double segmentDistanceSquared(const SdfSegment& s, const double px, const double py) {
+    const double dx = s.x1 - s.x0, dy = s.y1 - s.y0;
+    double t = ((px - s.x0) * dx + (py - s.y0) * dy) * s.inverseLengthSquared;
+    t = std::min(1.0, std::max(0.0, t));
+    const double ex = s.x0 + t * dx - px, ey = s.y0 + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+// Lists of segment indices in compressed form: bucket `b` holds
+// `items[offsets[b]] .. items[offsets[b + 1] - 1]`. `visit(segment, add)` calls `add(bucket)` for
+// every bucket of a segment, and runs twice: once to count, once to fill.
+struct SdfBuckets {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> items;
+
+    template <typename Visit>
+    void build(const std::size_t buckets, const std::size_t segments, Visit visit) {
+        offsets.assign(buckets + 1, 0);
+        for (std::size_t i = 0; i < segments; ++i) {
+            visit(i, [&](const std::size_t bucket) { ++offsets[bucket + 1]; });
+        }
+        for (std::size_t b = 0; b < buckets; ++b) {
+            offsets[b + 1] += offsets[b];
+        }
+        items.resize(offsets[buckets]);
+        std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < segments; ++i) {
+            visit(i, [&](const std::size_t bucket) { items[next[bucket]++] = uint32_t(i); });
+        }
+    }
+};
+
+} // namespace detail
+
+// LineReceiver (see PathFlattener) that collects a flattened path and computes an 8-bit signed
+// distance field of its fill.
+//
+// Usage:
+//
+// mapbox::svg::SdfGenerator sdf;
+// mapbox::svg::PathFlattener<mapbox::svg::SdfGenerator> flattener(sdf, 0.1);
+// mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+// mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+// parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z");
+// std::vector<uint8_t> field;
+// sdf.generate(mapbox::svg::SdfOptions(), field);
+//
+// Coordinates are in pixels of the drawing area, so put a PathTransform in front to scale the
+// path to the chosen size. Every subpath is closed for filling, as SVG does. Each pixel stores
+// 255 - 255 * (d / radius + cutoff), rounded and clamped, where d is the distance from the pixel
+// center to the outline, negative inside.
+//
+// The segments are sorted into a grid, and each pixel measures the segments of the rings of cells
+// around it until the next ring is farther than the closest segment so far, or than the distance
+// at which the value saturates. The winding numbers come from the segments sorted into pixel
+// rows, once per row. Rows are split between threads.
+
+class SdfGenerator {
+public:
+    SdfGenerator() {
+        reset();
+    }
+    SdfGenerator(const SdfGenerator&) = delete;
+    SdfGenerator(SdfGenerator&&) = delete;
+
+    // Removes the path, keeping the allocated memory.
+    void reset() {
+        segments.clear();
+        x = y = startX = startY = 0;
+    }
+
+    // Number of segments collected, including the ones that close subpaths.
+    std::size_t size() const {
+        return segments.size() + (x != startX || y != startY);
+    }
+
+    void moveTo(double x_, double y_) {
+        close();
+        x = startX = x_;
+        y = startY = y_;
+    }
+
+    void closePath() {
+        close();
+    }
+
+    void lineTo(double x_, double y_) {
+        segments.push_back({ x, y, x_, y_, 0 });
+        x = x_;
+        y = y_;
+    }
+
+    // Writes (width + 2 * buffer) * (height + 2 * buffer) bytes into `field`, row by row.
+    void generate(const SdfOptions& options, std::vector<uint8_t>& field) const {
+        const std::size_t width = options.width + 2 * std::size_t(options.buffer);
+        const std::size_t height = options.height + 2 * std::size_t(options.buffer);
+        field.assign(width * height, 0);
+        if (field.empty()) {
+            return;
+        }
+
+        std::vector<detail::SdfSegment> edges;
+        edges.reserve(size());
+        const double offset = options.buffer;
+        for (const detail::SdfSegment& s : segments) {
+            edges.push_back(
+                detail::makeSdfSegment(s.x0 + offset, s.y0 + offset, s.x1 + offset, s.y1 + offset));
+        }
+        if (x != startX || y != startY) {
+            edges.push_back(
+                detail::makeSdfSegment(x + offset, y + offset, startX + offset, startY + offset));
+        }
+
+        // Cells of half the largest distance that matters keep the rings searched small.
+        const double cellSize =
+            std::max(options.radius * std::max(options.cutoff, 1 - options.cutoff) / 2, 1.0);
+        const std::size_t columns = std::size_t(std::ceil(width / cellSize));
+        const std::size_t rows = std::size_t(std::ceil(height / cellSize));
+
+        detail::SdfBuckets grid;
+        grid.build(columns * rows, edges.size(), [&](const std::size_t i, auto add) {
+            visitCells(edges[i], cellSize, columns, rows, add);
+        });
+
+        // Segments by the pixel rows whose centers they cross, with the end below excluded.
+        detail::SdfBuckets rowEdges;
+        rowEdges.build(height, edges.size(), [&](const std::size_t i, auto add) {
+            const detail::SdfSegment& e = edges[i];
+            const double top = std::max(std::ceil(std::min(e.y0, e.y1) - 0.5), 0.0);
+            const double bottom = std::min(std::ceil(std::max(e.y0, e.y1) - 0.5), double(height));
+            for (double row = top; row < bottom; ++row) {
+                add(std::size_t(row));
+            }
+        });
+
+        const auto work = [&](const std::size_t firstRow, const std::size_t lastRow) {
+            std::vector<std::pair<double, int>> crossings;
+            for (std::size_t row = firstRow; row < lastRow; ++row) {
+                const double py = row + 0.5;
+                crossings.clear();
+                for (uint32_t k = rowEdges.offsets[row]; k < rowEdges.offsets[row + 1]; ++k) {
+                    const detail::SdfSegment& e = edges[rowEdges.items[k]];
+                    crossings.emplace_back(e.x0 + (py - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0),
+                                           e.y1 > e.y0 ? 1 : -1);
+                }
+                std::sort(crossings.begin(), crossings.end());
+
+                const std::size_t cellY = std::min(std::size_t(py / cellSize), rows - 1);
+                const double fy = py - cellY * cellSize;
+                int winding = 0;
+                std::size_t next = 0;
+                for (std::size_t column = 0; column < width; ++column) {
+                    const double px = column + 0.5;
+                    while (next < crossings.size() && crossings[next].first < px) {
+                        winding += crossings[next++].second;
+                    }
+
+                    // Rings of cells around the pixel, until the next one can't be closer.
+                    const std::size_t cellX = std::min(std::size_t(px / cellSize), columns - 1);
+                    // Distance to the sides of the pixel's cell.
+                    const double fx = px - cellX * cellSize;
+                    const double margin =
+                        std::min(std::min(fx, cellSize - fx), std::min(fy, cellSize - fy));
+                    const std::size_t rings = std::max(std::max(cellX, columns - 1 - cellX),
+                                                       std::max(cellY, rows - 1 - cellY));
+                    // Beyond this distance, the value saturates at 255 inside or 0 outside.
+                    const bool inside = isInside(options.fillRule, winding);
+                    const double reach =
+                        options.radius * (inside ? options.cutoff : 1 - options.cutoff);
+                    double best = reach * reach;
+                    const auto visit = [&](const std::size_t cy, std::size_t left,
+                                           std::size_t right) {
+                        const uint32_t last = grid.offsets[cy * columns + right + 1];
+                        for (uint32_t k = grid.offsets[cy * columns + left]; k < last; ++k) {
+                            best = std::min(
+                                best, detail::segmentDistanceSquared(edges[grid.items[k]], px, py));
+                        }
+                    };
+                    for (std::size_t ring = 0; ring <= rings; ++ring) {
+                        const double gap = (double(ring) - 1) * cellSize + margin;
+                        if (ring > 0 && gap * gap >= best) {
+                            break;
+                        }
+                        const std::size_t left = cellX >= ring ? cellX - ring : 0;
+                        const std::size_t right = std::min(cellX + ring, columns - 1);
+                        if (cellY >= ring) {
+                            visit(cellY - ring, left, right);
+                        }
+                        if (ring > 0 && cellY + ring < rows) {
+                            visit(cellY + ring, left, right);
+                        }
+                        const std::size_t top = cellY >= ring ? cellY - ring + 1 : 0;
+                        const std::size_t bottom = std::min(cellY + ring, rows);
+                        for (std::size_t cy = top; ring > 0 && cy < bottom; ++cy) {
+                            if (cellX >= ring) {
+                                visit(cy, cellX - ring, cellX - ring);
+                            }
+                            if (cellX + ring < columns) {
+                                visit(cy, cellX + ring, cellX + ring);
+                            }
+                        }
+                    }
+
+                    const double distance = inside ? -std::sqrt(best) : std::sqrt(best);
+                    const double value =
+                        std::floor(255 - 255 * (distance / options.radius + options.cutoff) + 0.5);
+                    field[row * width + column] = uint8_t(std::min(255.0, std::max(0.0, value)));
+                }
+            }
+        };
+
+        unsigned threads = options.threads;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // Threads only pay off for fields with enough rows.
+        threads = unsigned(std::max<std::size_t>(1, std::min<std::size_t>(threads, height / 32)));
+        const auto band = [&](const unsigned i) {
+            work(height * i / threads, height * (i + 1) / threads);
+        };
+        detail::runOnThreads(threads, band);
+    }
+
+private:
+    void close() {
+        if (x != startX || y != startY) {
+            segments.push_back({ x, y, startX, startY, 0 });
+        }
+        x = startX;
+        y = startY;
+    }
+
+    // Calls `add(cell)` for the cells the segment passes through. Parts outside of the grid go
+    // into the cells at its border, which are the closest.
+    template <typename Add>
+    static void visitCells(const detail::SdfSegment& e,
+                           const double cellSize,
+                           const std::size_t columns,
+                           const std::size_t rows,
+                           Add add) {
+        // Clamped before the conversion, which is undefined for huge and non-finite values.
+        const auto clampCell = [](const double v, const std::size_t count) {
+            return !(v > 0) ? std::size_t(0)
+                            : v < double(count - 1) ? std::size_t(v) : count - 1;
+        };
+        const double minY = std::min(e.y0, e.y1), maxY = std::max(e.y0, e.y1);
+        const std::size_t first = clampCell(minY / cellSize, rows);
+        const std::size_t last = clampCell(maxY / cellSize, rows);
+        const double slope = e.y1 != e.y0 ? (e.x1 - e.x0) / (e.y1 - e.y0) : 0;
+        // Keeps rounding from missing a cell that the segment only touches.
+        const double margin = 1e-9 * cellSize;
+        for (std::size_t row = first; row <= last; ++row) {
+            double xa = e.x0, xb = e.x1;
+            if (e.y1 != e.y0) {
+                const double top = row == first ? minY : std::max(minY, row * cellSize);
+                const double bottom = row == last ? maxY : std::min(maxY, (row + 1) * cellSize);
+                xa = e.x0 + (top - e.y0) * slope;
+                xb = e.x0 + (bottom - e.y0) * slope;
+            }
+            const std::size_t left = clampCell((std::min(xa, xb) - margin) / cellSize, columns);
+            const std::size_t right = clampCell((std::max(xa, xb) + margin) / cellSize, columns);
+            for (std::size_t column = left; column <= right; ++column) {
+                add(row * columns + column);
+            }
+        }
+    }
+
+    std::vector<detail::SdfSegment> segments;
+    double x, y;
+    double startX, startY;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,631 @@
+#pragma once
+
+#include <mapbox/svg/char_scan.hpp>
+#include <mapbox/svg/number_parser.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_slice.hpp>
+#include <mapbox/svg/path_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+namespace detail {
+
+inline bool sliceEquals(const PathSlice& slice, const char* str) {
+    const std::size_t length = std::strlen(str);
+    return slice.size == length && std::memcmp(slice.data, str, length) == 0;
+}
+
+// Skips whitespace with at most one comma in it, as between numbers in attribute values.
+inline const char* skipSeparator(const char* cursor, const char* last) {
+    cursor = skipWhitespace(cursor, last);
+    if (cursor != last && *cursor == ',') {
+        cursor = skipWhitespace(cursor + 1, last);
+    }
+    return cursor;
+}
+
+// Returns the first occurrence of `pattern` in [first, last), or nullptr.
+inline const char* find(const char* first, const char* last, const char* pattern) {
+    const std::size_t length = std::strlen(pattern);
+    while (std::size_t(last - first) >= length) {
+        const char* found = static_cast<const char*>(std::memchr(first, pattern[0], last - first));
+        if (!found || std::size_t(last - found) < length) {
+            return nullptr;
+        }
+        if (std::memcmp(found, pattern, length) == 0) {
+            return found;
+        }
+        first = found + 1;
+    }
+    return nullptr;
+}
+
+inline bool isNameEnd(const char c) {
+    return isWhitespace(c) || c == '/' || c == '>' || c == '=';
+}
+
+} // namespace detail
+
+// One tag of an SVG document, as read by SvgTokenizer. Slices point into the document.
+class SvgTag {
+public:
+    enum class Type : uint8_t { Start, End, Empty };
+
+    Type type = Type::Start;
+
+    // The element name without its namespace prefix, e.g. `path` for `<svg:path>`.
+    PathSlice name = { nullptr, 0 };
+
+    // The element name as written, e.g. `svg:path`.
+    PathSlice qualifiedName = { nullptr, 0 };
+
+    bool is(const char* localName) const {
+        return detail::sliceEquals(name, localName);
+    }
+
+    // Finds the value of an attribute, without the quotes. Entities aren't decoded, since path
+    // data and transforms don't need them.
+    bool attribute(const char* attributeName, PathSlice& value) const {
+        bool found = false;
+        attributes([&](const PathSlice& n, const PathSlice& v) {
+            if (!found && detail::sliceEquals(n, attributeName)) {
+                value = v;
+                found = true;
+            }
+        });
+        return found;
+    }
+
+    // Calls `visit(name, value)` for each attribute, in document order.
+    template <typename Visit>
+    void attributes(Visit visit) const {
+        const char* cursor = attributesBegin;
+        while (true) {
+            cursor = detail::skipWhitespace(cursor, attributesEnd);
+            if (cursor == attributesEnd) {
+                return;
+            }
+            const char* nameBegin = cursor;
+            while (!detail::isNameEnd(*cursor)) {
+                ++cursor;
+            }
+            const PathSlice attributeName = { nameBegin, std::size_t(cursor - nameBegin) };
+            cursor = detail::skipWhitespace(cursor, attributesEnd) + 1;
+            cursor = detail::skipWhitespace(cursor, attributesEnd);
+            const char quote = *cursor++;
+            const char* valueEnd = static_cast<const char*>(
+                std::memchr(cursor, quote, std::size_t(attributesEnd - cursor)));
+            visit(attributeName, PathSlice{ cursor, std::size_t(valueEnd - cursor) });
+            cursor = valueEnd + 1;
+        }
+    }
+
+private:
+    friend class SvgTokenizer;
+
+    // The attributes, already checked by the tokenizer.
+    const char* attributesBegin = nullptr;
+    const char* attributesEnd = nullptr;
+};
+
+// Pull tokenizer for the tags of an SVG (or any XML) document, without building a tree.
+//
+// Usage:
+//
+// mapbox::svg::SvgTokenizer tokenizer(data, size);
+// mapbox::svg::SvgTag tag;
+// while (tokenizer.next(tag)) {
+//     ...
+// }
+//
+// Comments, processing instructions, the doctype, CDATA sections and text are skipped. The
+// tokenizer checks the syntax of tags and attributes, but not that start and end tags match.
+
+class SvgTokenizer {
+public:
+    SvgTokenizer(const char* data, std::size_t size)
+        : first(data), cursor(data), last(data + size) {
+    }
+
+    // Reads the next tag. Returns false at the end of the document or on a syntax error.
+    bool next(SvgTag& tag) {
+        while (cursor != last) {
+            const char* open =
+                static_cast<const char*>(std::memchr(cursor, '<', std::size_t(last - cursor)));
+            if (!open) {
+                cursor = last;
+                return false;
+            }
+            cursor = open + 1;
+            if (cursor == last) {
+                return fail(open);
+            }
+            if (*cursor == '!') {
+                if (!skipDeclaration(open)) {
+                    return false;
+                }
+            } else if (*cursor == '?') {
+                const char* close = detail::find(cursor, last, "?>");
+                if (!close) {
+                    return fail(open);
+                }
+                cursor = close + 2;
+            } else {
+                return readTag(open, tag);
+            }
+        }
+        return false;
+    }
+
+    bool failed() const {
+        return error != nullptr;
+    }
+
+    // Offset of the malformed markup from the start of the document.
+    std::ptrdiff_t errorOffset() const {
+        return error ? error - first : 0;
+    }
+
+private:
+    bool fail(const char* at) {
+        error = at;
+        cursor = last;
+        return false;
+    }
+
+    // Comments, CDATA sections and declarations such as the doctype, with an internal subset in
+    // brackets.
+    bool skipDeclaration(const char* open) {
+        const char* close = nullptr;
+        if (last - cursor >= 3 && std::memcmp(cursor, "!--", 3) == 0) {
+            close = detail::find(cursor + 3, last, "-->");
+            cursor = close ? close + 3 : last;
+        } else if (last - cursor >= 8 && std::memcmp(cursor, "![CDATA[", 8) == 0) {
+            close = detail::find(cursor + 8, last, "]]>");
+            cursor = close ? close + 3 : last;
+        } else {
+            int depth = 0;
+            char quote = 0;
+            for (; cursor != last; ++cursor) {
+                const char c = *cursor;
+                if (quote) {
+                    quote = c == quote ? 0 : quote;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '[') {
+                    ++depth;
+                } else if (c == ']') {
+                    --depth;
+                } else if (c == '>' && depth <= 0) {
+                    close = cursor++;
+                    break;
+                }
+            }
+        }
+        return close ? true : fail(open);
+    }
+
+    bool readTag(const char* open, SvgTag& tag) {
+        tag.type = SvgTag::Type::Start;
+        if (*cursor == '/') {
+            tag.type = SvgTag::Type::End;
+            ++cursor;
+        }
+        const char* nameBegin = cursor;
+        const char* localName = cursor;
+        while (cursor != last && !detail::isNameEnd(*cursor)) {
+            if (*cursor == ':') {
+                localName = cursor + 1;
+            }
+            ++cursor;
+        }
+        if (cursor == nameBegin || cursor == last) {
+            return fail(open);
+        }
+        tag.name = { localName, std::size_t(cursor - localName) };
+        tag.qualifiedName = { nameBegin, std::size_t(cursor - nameBegin) };
+        tag.attributesBegin = cursor;
+
+        while (true) {
+            const char* attribute = detail::skipWhitespace(cursor, last);
+            if (attribute == last) {
+                return fail(open);
+            }
+            if (*attribute == '>') {
+                tag.attributesEnd = attribute;
+                cursor = attribute + 1;
+                return true;
+            }
+            if (*attribute == '/' && tag.type == SvgTag::Type::Start && last - attribute >= 2 &&
+                attribute[1] == '>') {
+                tag.type = SvgTag::Type::Empty;
+                tag.attributesEnd = attribute;
+                cursor = attribute + 2;
+                return true;
+            }
+            // Attributes need whitespace before them, and end tags have none.
+            if (attribute == cursor || tag.type == SvgTag::Type::End) {
+                return fail(open);
+            }
+            cursor = attribute;
+            while (cursor != last && !detail::isNameEnd(*cursor)) {
+                ++cursor;
+            }
+            if (cursor == attribute) {
+                return fail(open);
+            }
+            cursor = detail::skipWhitespace(cursor, last);
+            if (cursor == last || *cursor != '=') {
+                return fail(open);
+            }
+            cursor = detail::skipWhitespace(cursor + 1, last);
+            if (cursor == last || (*cursor != '"' && *cursor != '\'')) {
+                return fail(open);
+            }
+            const char* close = static_cast<const char*>(
+                std::memchr(cursor + 1, *cursor, std::size_t(last - cursor - 1)));
+            if (!close) {
+                return fail(open);
+            }
+            cursor = close + 1;
+        }
+    }
+
+    const char* const first;
+    const char* cursor;
+    const char* const last;
+    const char* error = nullptr;
+};
+
+// Parses an SVG transform list such as `translate(10 20) rotate(45)` into one matrix. Returns
+// false if the list is invalid, in which case SVG ignores the attribute.
+inline bool parseTransform(const char* cursor, const char* last, AffineTransform& result) {
+    const double pi = 3.14159265358979323846;
+    result = AffineTransform();
+    cursor = detail::skipWhitespace(cursor, last);
+    while (cursor != last) {
+        const char* nameBegin = cursor;
+        while (cursor != last && ((*cursor >= 'a' && *cursor <= 'z') || *cursor == 'X' ||
+                                  *cursor == 'Y')) {
+            ++cursor;
+        }
+        const PathSlice name = { nameBegin, std::size_t(cursor - nameBegin) };
+        cursor = detail::skipWhitespace(cursor, last);
+        if (cursor == last || *cursor != '(') {
+            return false;
+        }
+        cursor = detail::skipWhitespace(cursor + 1, last);
+        double v[6];
+        int count = 0;
+        while (cursor != last && *cursor != ')') {
+            const char* next = count < 6 ? detail::parseNumber(cursor, last, v[count]) : cursor;
+            if (next == cursor || !std::isfinite(v[count])) {
+                return false;
+            }
+            ++count;
+            cursor = detail::skipSeparator(next, last);
+        }
+        if (cursor == last) {
+            return false;
+        }
+        cursor = detail::skipSeparator(cursor + 1, last);
+
+        AffineTransform t;
+        if (detail::sliceEquals(name, "matrix") && count == 6) {
+            t = { v[0], v[1], v[2], v[3], v[4], v[5] };
+        } else if (detail::sliceEquals(name, "translate") && (count == 1 || count == 2)) {
+            t = TranslateTransform{ v[0], count == 2 ? v[1] : 0 };
+        } else if (detail::sliceEquals(name, "scale") && (count == 1 || count == 2)) {
+            t = ScaleTransform{ v[0], count == 2 ? v[1] : v[0], 0, 0 };
+        } else if (detail::sliceEquals(name, "rotate") && (count == 1 || count == 3)) {
+            const double angle = v[0] * pi / 180;
+            const double cosAngle = std::cos(angle), sinAngle = std::sin(angle);
+            t = { cosAngle, sinAngle, -sinAngle, cosAngle, 0, 0 };
+            if (count == 3) {
+                t = AffineTransform(TranslateTransform{ v[1], v[2] }) * t *
+                    AffineTransform(TranslateTransform{ -v[1], -v[2] });
+            }
+        } else if (detail::sliceEquals(name, "skewX") && count == 1) {
+            t.c = std::tan(v[0] * pi / 180);
+        } else if (detail::sliceEquals(name, "skewY") && count == 1) {
+            t.b = std::tan(v[0] * pi / 180);
+        } else {
+            return false;
+        }
+        result = result * t;
+    }
+    return true;
+}
+
+enum class SvgShapeType : uint8_t { Path, Rect, Circle, Ellipse, Line, Polyline, Polygon };
+
+// A rendered shape element found by SvgReader.
+class SvgShape {
+public:
+    SvgShapeType type = SvgShapeType::Path;
+
+    // The element, for attributes such as `id` or `fill`.
+    SvgTag tag;
+
+    // Maps the shape's coordinates to those of the document: the `transform` attributes of its
+    // ancestors and its own, combined.
+    AffineTransform transform;
+
+    // Sends the geometry to a VertexReceiver in the shape's own coordinates, as PathParser
+    // would. Basic shapes become the path the SVG specification defines for them. Returns false
+    // if the geometry has an error; what comes before the error is sent anyway, as SVG renders
+    // it.
+    template <typename VertexReceiver>
+    bool draw(VertexReceiver& t) const {
+        switch (type) {
+            case SvgShapeType::Path: return drawPath(t);
+            case SvgShapeType::Rect: return drawRect(t);
+            case SvgShapeType::Circle:
+            case SvgShapeType::Ellipse: return drawEllipse(t);
+            case SvgShapeType::Line: return drawLine(t);
+            default: return drawPoly(t);
+        }
+    }
+
+    // Sends the geometry in document coordinates.
+    template <typename VertexReceiver>
+    bool drawTransformed(VertexReceiver& t) const {
+        PathTransform<VertexReceiver> transformed(t, transform);
+        return draw(transformed);
+    }
+
+private:
+    // Reads a length attribute. Units are ignored, so only user units and `px` are exact.
+    bool length(const char* name, double& value) const {
+        PathSlice slice;
+        if (!tag.attribute(name, slice)) {
+            return false;
+        }
+        const char* begin = detail::skipWhitespace(slice.data, slice.data + slice.size);
+        return detail::parseNumber(begin, slice.data + slice.size, value) != begin &&
+               std::isfinite(value);
+    }
+
+    double length(const char* name) const {
+        double value = 0;
+        return length(name, value) ? value : 0;
+    }
+
+    template <typename VertexReceiver>
+    bool drawPath(VertexReceiver& t) const {
+        PathSlice d;
+        if (!tag.attribute("d", d)) {
+            return true;
+        }
+        PathParser<VertexReceiver> parser(t);
+        return parser(d.data, d.size);
+    }
+
+    template <typename VertexReceiver>
+    bool drawRect(VertexReceiver& t) const {
+        const double x = length("x"), y = length("y");
+        const double width = length("width"), height = length("height");
+        if (!(width > 0 && height > 0)) {
+            return true;
+        }
+        double rx = 0, ry = 0;
+        const bool hasRx = length("rx", rx) && rx >= 0;
+        const bool hasRy = length("ry", ry) && ry >= 0;
+        rx = hasRx ? rx : hasRy ? ry : 0;
+        ry = hasRy ? ry : rx;
+        rx = std::min(rx, width / 2);
+        ry = std::min(ry, height / 2);
+        if (rx > 0 && ry > 0) {
+            t.moveTo(x + rx, y, false);
+            t.lineTo(x + width - rx, y, false);
+            t.arc(rx, ry, 0, false, true, x + width, y + ry, false);
+            t.lineTo(x + width, y + height - ry, false);
+            t.arc(rx, ry, 0, false, true, x + width - rx, y + height, false);
+            t.lineTo(x + rx, y + height, false);
+            t.arc(rx, ry, 0, false, true, x, y + height - ry, false);
+            t.lineTo(x, y + ry, false);
+            t.arc(rx, ry, 0, false, true, x + rx, y, false);
+        } else {
+            t.moveTo(x, y, false);
+            t.horizontalLineTo(x + width, false);
+            t.verticalLineTo(y + height, false);
+            t.horizontalLineTo(x, false);
+        }
+        t.closePath();
+        return true;
+    }
+
+    template <typename VertexReceiver>
+    bool drawEllipse(VertexReceiver& t) const {
+        const double cx = length("cx"), cy = length("cy");
+        double rx = 0, ry = 0;
+        if (type == SvgShapeType::Circle) {
+            rx = ry = length("r");
+        } else {
+            // Either radius defaults to the other one.
+            const bool hasRx = length("rx", rx);
+            const bool hasRy = length("ry", ry);
+            rx = hasRx ? rx : ry;
+            ry = hasRy ? ry : rx;
+        }
+        if (!(rx > 0 && ry > 0)) {
+            return true;
+        }
+        t.moveTo(cx + rx, cy, false);
+        t.arc(rx, ry, 0, false, true, cx, cy + ry, false);
+        t.arc(rx, ry, 0, false, true, cx - rx, cy, false);
+        t.arc(rx, ry, 0, false, true, cx, cy - ry, false);
+        t.arc(rx, ry, 0, false, true, cx + rx, cy, false);
+        t.closePath();
+        return true;
+    }
+
+    template <typename VertexReceiver>
+    bool drawLine(VertexReceiver& t) const {
+        t.moveTo(length("x1"), length("y1"), false);
+        t.lineTo(length("x2"), length("y2"), false);
+        return true;
+    }
+
+    template <typename VertexReceiver>
+    bool drawPoly(VertexReceiver& t) const {
+        PathSlice points;
+        if (!tag.attribute("points", points)) {
+            return true;
+        }
+        const char* cursor = points.data;
+        const char* const last = points.data + points.size;
+        cursor = detail::skipWhitespace(cursor, last);
+        bool first = true;
+        while (cursor != last) {
+            double x = 0, y = 0;
+            const char* next = detail::parseNumber(cursor, last, x);
+            if (next == cursor) {
+                return false;
+            }
+            cursor = detail::skipSeparator(next, last);
+            next = detail::parseNumber(cursor, last, y);
+            if (next == cursor) {
+                return false;
+            }
+            cursor = detail::skipSeparator(next, last);
+            if (first) {
+                t.moveTo(x, y, false);
+            } else {
+                t.lineTo(x, y, false);
+            }
+            first = false;
+        }
+        if (type == SvgShapeType::Polygon && !first) {
+            t.closePath();
+        }
+        return true;
+    }
+};
+
+// Pull reader for the shapes of an SVG document: `<path>`, `<rect>`, `<circle>`, `<ellipse>`,
+// `<line>`, `<polyline>` and `<polygon>`, with the transforms they inherit.
+//
+// Usage:
+//
+// mapbox::svg::MappedFile file;
+// file.open("sprite.svg");
+// mapbox::svg::SvgReader reader(file.data(), file.size());
+// mapbox::svg::SvgShape shape;
+// while (reader.next(shape)) {
+//     shape.drawTransformed(receiver);
+// }
+//
+// The document is read as it is pulled, without building a tree: the reader only keeps the
+// name and transform of each open element, and an end tag that doesn't close the innermost one
+// is an error at its name. Shapes inside `<defs>`, `<symbol>`, `<clipPath>`, `<mask>`,
+// `<pattern>` and `<marker>`, and those with `display="none"` or inside such elements, aren't
+// rendered by themselves and are skipped. `<use>` references, CSS and the viewBox of nested
+// `<svg>` elements aren't applied.
+
+class SvgReader {
+public:
+    SvgReader(const char* data, std::size_t size) : tokenizer(data, size), first(data) {
+    }
+
+    // Finds the next rendered shape. Returns false at the end of the document or on an error.
+    bool next(SvgShape& shape) {
+        SvgTag tag;
+        while (tokenizer.next(tag)) {
+            if (tag.type == SvgTag::Type::End) {
+                // An end tag has to close the innermost open element.
+                if (stack.empty() || !sameName(stack.back().name, tag.qualifiedName)) {
+                    error = tag.qualifiedName.data;
+                    return false;
+                }
+                stack.pop_back();
+                continue;
+            }
+            Group group = stack.empty() ? Group() : stack.back();
+            PathSlice value;
+            AffineTransform own;
+            if (tag.attribute("transform", value) &&
+                parseTransform(value.data, value.data + value.size, own)) {
+                group.transform = group.transform * own;
+            }
+            group.hidden = group.hidden || isDefinition(tag) ||
+                           (tag.attribute("display", value) && detail::sliceEquals(value, "none"));
+            if (tag.type == SvgTag::Type::Start) {
+                group.name = tag.qualifiedName;
+                stack.push_back(group);
+            }
+            SvgShapeType type;
+            if (!group.hidden && shapeType(tag, type)) {
+                shape.type = type;
+                shape.tag = tag;
+                shape.transform = group.transform;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool failed() const {
+        return tokenizer.failed() || error;
+    }
+
+    // Offset of the malformed markup from the start of the document.
+    std::ptrdiff_t errorOffset() const {
+        return tokenizer.failed() ? tokenizer.errorOffset() : error ? error - first : 0;
+    }
+
+    // Number of elements that are open at the current position.
+    std::size_t depth() const {
+        return stack.size();
+    }
+
+private:
+    struct Group {
+        PathSlice name = { nullptr, 0 };
+        AffineTransform transform;
+        bool hidden = false;
+    };
+
+    static bool sameName(const PathSlice& a, const PathSlice& b) {
+        return a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+
+    static bool isDefinition(const SvgTag& tag) {
+        return tag.is("defs") || tag.is("symbol") || tag.is("clipPath") || tag.is("mask") ||
+               tag.is("pattern") || tag.is("marker");
+    }
+
+    static bool shapeType(const SvgTag& tag, SvgShapeType& type) {
+        static const struct {
+            const char* name;
+            SvgShapeType type;
+        } shapes[] = {
+            { "path", SvgShapeType::Path },         { "rect", SvgShapeType::Rect },
+            { "circle", SvgShapeType::Circle },     { "ellipse", SvgShapeType::Ellipse },
+            { "line", SvgShapeType::Line },         { "polyline", SvgShapeType::Polyline },
+            { "polygon", SvgShapeType::Polygon },
+        };
+        for (const auto& shape : shapes) {
+            if (tag.is(shape.name)) {
+                type = shape.type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SvgTokenizer tokenizer;
+    const char* const first;
+    const char* error = nullptr;
+    std::vector<Group> stack;
+};
+
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mapbox {
+namespace svg {
+namespace detail {
+
+// Joins the threads it holds when it goes out of scope, so that no joinable std::thread is ever
+// destroyed.
+class ThreadGroup {
+public:
+    ThreadGroup() = default;
+    ThreadGroup(const ThreadGroup&) = delete;
+    ThreadGroup(ThreadGroup&&) = delete;
+
+    ~ThreadGroup() {
+        for (std::thread& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads;
+};
+
+// Calls `work(i)` for each `i` below `count`, every call on its own thread but for `work(0)`,
+// which runs on the calling thread, like the calls for which no thread could be started. Returns
+// when all of them are done, and then rethrows the first exception any of them threw.
+template <typename Work>
+void runOnThreads(const unsigned count, Work& work) {
+    std::mutex mutex;
+    std::exception_ptr error;
+    const auto run = [&](const unsigned i) {
+        try {
+            work(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    {
+        ThreadGroup group;
+        unsigned started = 1;
+        try {
+            group.threads.reserve(count - 1);
+            for (; started < count; ++started) {
+                group.threads.emplace_back(run, started);
+            }
+        } catch (...) {
+            // Out of threads or memory: the calling thread does the rest.
+        }
+        run(0);
+        for (unsigned i = started; i < count; ++i) {
+            run(i);
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace detail
+} // namespace svg
+} // namespace mapbox
@@ -0,0 +1,94 @@
+#include "path.hpp"
+
+#include <mapbox/svg/batch_parser.hpp>
+#include <mapbox/svg/path_buffer.hpp>
+
+#include "expect.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    std::vector<std::string> strings;
+    for (int i = 0; i < 5000; ++i) {
+        if (i % 7 == 3) {
+            strings.push_back("M" + std::to_string(i) + " 0L1 2#");
+        } else {
+            strings.push_back("M" + std::to_string(i) + " 0L1 2Z");
+        }
+    }
+    std::vector<PathSlice> paths;
+    for (const std::string& str : strings) {
+        paths.push_back({ str.data(), str.size() });
+    }
+
+    for (unsigned threads : { 1u, 3u, 8u }) {
+        std::vector<Path> output(paths.size());
+        const std::vector<PathParseResult> results = parseBatch(
+            paths.data(), paths.size(), [] { return PathRecorder(); },
+            [&](std::size_t i, PathRecorder& receiver, const PathParseResult&) {
+                output[i].swap(receiver.path);
+                receiver.path.clear();
+            },
+            threads);
+
+        EXPECT_EQUALS(paths.size(), results.size());
+        bool matches = true;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const bool valid = i % 7 != 3;
+            matches = matches && results[i].success == valid;
+            matches = matches && results[i].error ==
+                                     (valid ? PathParseErrorType::None
+                                            : PathParseErrorType::CommandParsing);
+            matches = matches && results[i].errorOffset ==
+                                     (valid ? 0 : std::ptrdiff_t(strings[i].size()));
+            matches = matches && output[i].size() == (valid ? 3u : 2u) &&
+                      output[i][0] == PathCommand::MoveTo(double(i), 0, false);
+        }
+        EXPECT_TRUE(matches);
+    }
+
+    // Workers reuse their receiver.
+    std::atomic<int> receivers{ 0 };
+    parseBatch(
+        paths.data(), paths.size(),
+        [&] {
+            ++receivers;
+            return PathBuffer();
+        },
+        [](std::size_t, PathBuffer& buffer, const PathParseResult&) { buffer.clear(); }, 2);
+    EXPECT_EQUALS(2, receivers.load());
+
+    EXPECT_TRUE(parseBatch(
+                    paths.data(), 0, [] { return PathBuffer(); },
+                    [](std::size_t, PathBuffer&, const PathParseResult&) {})
+                    .empty());
+
+    // Exceptions from any thread reach the caller once all workers are joined.
+    for (unsigned threads : { 1u, 4u }) {
+        for (std::size_t failing : { std::size_t(0), paths.size() - 1 }) {
+            std::atomic<int> parsed{ 0 };
+            bool thrown = false;
+            try {
+                parseBatch(
+                    paths.data(), paths.size(), [] { return PathBuffer(); },
+                    [&](std::size_t i, PathBuffer&, const PathParseResult&) {
+                        ++parsed;
+                        if (i == failing) {
+                            throw std::runtime_error("failed");
+                        }
+                    },
+                    threads);
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            EXPECT_TRUE(thrown);
+            EXPECT_TRUE(parsed.load() > 0);
+        }
+    }
+}
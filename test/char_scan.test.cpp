@@ -0,0 +1,64 @@
+#include <mapbox/svg/char_scan.hpp>
+#include <mapbox/svg/number_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+int main() {
+    using namespace mapbox::svg::detail;
+
+    EXPECT_EQUALS(0xFFFEu, digitMask16("a123456789012345"));
+    EXPECT_EQUALS(0xFFF7u, digitMask16("123.456789012345"));
+    EXPECT_EQUALS(0x7FFFu, digitMask16("123456789012345/"));
+    EXPECT_EQUALS(0xFFFFu, digitMask16("1234567890123456789"));
+    EXPECT_EQUALS(0x0003u, digitMask16("09:\xB0 /-+eE.,:;\x80"));
+
+    EXPECT_EQUALS(0u, parseDigits8("12345678", 0));
+    EXPECT_EQUALS(1u, parseDigits8("1,345678", 1));
+    EXPECT_EQUALS(1234u, parseDigits8("1234 678", 4));
+    EXPECT_EQUALS(12345678u, parseDigits8("12345678", 8));
+    EXPECT_EQUALS(90000009u, parseDigits8("90000009", 8));
+    EXPECT_EQUALS(0u, parseDigits8Before("12345678" + 8, 0));
+    EXPECT_EQUALS(678u, parseDigits8Before("1234.678" + 8, 3));
+    EXPECT_EQUALS(12345678u, parseDigits8Before("12345678" + 8, 8));
+
+    const std::string spaces = "   \t\r\n                                          x   ";
+    const char* const first = spaces.data();
+    const char* const last = first + spaces.size();
+    EXPECT_EQUALS(first + spaces.find('x'), skipWhitespace(first, last));
+    EXPECT_EQUALS(first + 5, skipWhitespace(first, first + 5));
+    EXPECT_EQUALS(last, skipWhitespace(last - 3, last));
+
+    // The vector and scalar paths agree for every position of a number in a longer buffer.
+    std::mt19937 random(3);
+    const char alphabet[] = "0123456789.e-+, \t";
+    unsigned long mismatches = 0;
+    for (int i = 0; i < 20000; ++i) {
+        std::string text;
+        for (int k = 0; k < 40; ++k) {
+            text += alphabet[random() % (sizeof(alphabet) - 1)];
+        }
+        const char* first = text.data();
+        const char* last = first + text.size();
+        for (const char* p = first; p + 16 <= last; ++p) {
+            uint32_t expected = 0;
+            for (unsigned k = 0; k < 16; ++k) {
+                expected |= uint32_t(isDigit(p[k])) << k;
+            }
+            mismatches += digitMask16(p) != expected;
+        }
+        double value = 0;
+        const char* end = parseNumber(first, last, value);
+        if (end != first) {
+            // Compare with the result for a copy that is too short for the vector path.
+            const std::string copy(first, end);
+            double expected = 0;
+            parseNumber(copy.data(), copy.data() + copy.size(), expected);
+            mismatches += !(value == expected || (std::isinf(value) && std::isinf(expected)));
+        }
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+}
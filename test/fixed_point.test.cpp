@@ -0,0 +1,129 @@
+#include <mapbox/svg/fixed_point.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename Fixed>
+struct Scan {
+    bool valid;
+    typename Fixed::integer_type raw;
+};
+
+template <typename Fixed>
+Scan<Fixed> scan(const char* str) {
+    Fixed value = Fixed::fromRaw(0);
+    const char* last = str + std::strlen(str);
+    const bool valid = mapbox::svg::detail::parseNumber(str, last, value) == last;
+    return { valid, value.raw };
+}
+
+using Fixed8 = mapbox::svg::FixedPoint<8>;
+using Fixed16 = mapbox::svg::FixedPoint<16>;
+using Fixed30 = mapbox::svg::FixedPoint<30>;
+using Integer = mapbox::svg::FixedPoint<0>;
+using Tile = mapbox::svg::FixedPoint<0, int16_t>;
+
+// Records the raw values of every coordinate it receives.
+struct RawReceiver {
+    std::vector<int32_t> raw;
+
+    void moveTo(Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x.raw, y.raw });
+    }
+    void closePath() {
+    }
+    void lineTo(Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x.raw, y.raw });
+    }
+    void horizontalLineTo(Fixed8 x, bool) {
+        raw.push_back(x.raw);
+    }
+    void verticalLineTo(Fixed8 y, bool) {
+        raw.push_back(y.raw);
+    }
+    void curveTo(Fixed8 x1, Fixed8 y1, Fixed8 x2, Fixed8 y2, Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x1.raw, y1.raw, x2.raw, y2.raw, x.raw, y.raw });
+    }
+    void smoothCurveTo(Fixed8 x2, Fixed8 y2, Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x2.raw, y2.raw, x.raw, y.raw });
+    }
+    void quadraticCurveTo(Fixed8 x1, Fixed8 y1, Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x1.raw, y1.raw, x.raw, y.raw });
+    }
+    void smoothQuadraticCurveTo(Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { x.raw, y.raw });
+    }
+    void arc(Fixed8 rx, Fixed8 ry, Fixed8 rotation, bool, bool, Fixed8 x, Fixed8 y, bool) {
+        raw.insert(raw.end(), { rx.raw, ry.raw, rotation.raw, x.raw, y.raw });
+    }
+};
+
+} // namespace
+
+int main() {
+    EXPECT_EQUALS(1536, scan<Fixed8>("6").raw);
+    EXPECT_EQUALS(3200, scan<Fixed8>("12.5").raw);
+    EXPECT_EQUALS(-64, scan<Fixed8>("-.25").raw);
+    EXPECT_EQUALS(25600, scan<Fixed8>("1e2").raw);
+    EXPECT_EQUALS(0, scan<Fixed8>("0e99999").raw);
+    EXPECT_EQUALS(0, scan<Fixed8>("1e-99999").raw);
+
+    // Rounding to the nearest multiple of 1/256, ties away from zero.
+    EXPECT_EQUALS(26, scan<Fixed8>("0.1").raw);
+    EXPECT_EQUALS(1, scan<Fixed8>("0.001953125").raw);
+    EXPECT_EQUALS(0, scan<Fixed8>("0.001953124").raw);
+    EXPECT_EQUALS(-1, scan<Fixed8>("-0.001953125").raw);
+    EXPECT_EQUALS(1, scan<Fixed8>("0.0019531250000000000000000001").raw);
+    EXPECT_EQUALS(0, scan<Fixed8>("0.0019531249999999999999999999").raw);
+
+    // Digits past the 19th still decide the rounding when the boundaries are fine: 2^-31 is the
+    // tie between 0 and 2^-30.
+    EXPECT_EQUALS(1, scan<Fixed30>("4.6566128730773925782e-10").raw);
+    EXPECT_EQUALS(1, scan<Fixed30>("4.656612873077392578125e-10").raw);
+    EXPECT_EQUALS(-1, scan<Fixed30>("-4.656612873077392578125000e-10").raw);
+    EXPECT_EQUALS(0, scan<Fixed30>("4.656612873077392578124999999e-10").raw);
+    EXPECT_EQUALS(1, scan<Fixed30>("0.000000000465661287307739257812500000000000000001").raw);
+
+    // Out of range numbers are rejected.
+    EXPECT_EQUALS(32767, scan<Tile>("32767").raw);
+    EXPECT_EQUALS(-32767, scan<Tile>("-32767.4").raw);
+    EXPECT_FALSE(scan<Tile>("32767.5").valid);
+    EXPECT_FALSE(scan<Tile>("1e5").valid);
+    EXPECT_FALSE(scan<Fixed8>("1e99999").valid);
+    EXPECT_TRUE(scan<Fixed8>("8388607.99").valid);
+    EXPECT_FALSE(scan<Fixed8>("8388608").valid);
+    EXPECT_EQUALS(-2147483647 - 1, scan<Integer>("-2147483648").raw);
+    EXPECT_FALSE(scan<Integer>("2147483648").valid);
+    EXPECT_EQUALS(-32768, scan<Tile>("-32768.49").raw);
+    EXPECT_FALSE(scan<Tile>("-32768.5").valid);
+    EXPECT_FALSE(scan<Fixed30>("2.0000000000000000000001").valid);
+
+    // Matches rounding the exact value for random inputs.
+    std::mt19937_64 random(7);
+    unsigned long mismatches = 0;
+    char buffer[64];
+    for (int i = 0; i < 100000; ++i) {
+        const double value = double(int64_t(random() % 200000000) - 100000000) / 65536.0;
+        std::snprintf(buffer, sizeof(buffer), "%.*f", int(random() % 8), value);
+        const double exact = std::strtod(buffer, nullptr) * 65536.0;
+        const double expected = exact < 0 ? -std::floor(-exact + 0.5) : std::floor(exact + 0.5);
+        mismatches += scan<Fixed16>(buffer).raw != int32_t(expected);
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+
+    RawReceiver receiver;
+    mapbox::svg::PathParser<RawReceiver, Fixed8> parser(receiver);
+    EXPECT_TRUE(parser("M6,12.5h-1a2 2 0 1 1-2 2"));
+    EXPECT_TRUE((std::vector<int32_t>{ 1536, 3200, -256, 512, 512, 0, -512, 512 }) == receiver.raw);
+    EXPECT_FALSE(parser("M1e7 0"));
+    EXPECT_TRUE(mapbox::svg::PathParseErrorType::NumberParsing == parser.errorType());
+    EXPECT_EQUALS(1, parser.errorOffset());
+}
@@ -0,0 +1,123 @@
+#include <mapbox/svg/mvt_encoder.hpp>
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_transform.hpp>
+
+#include "expect.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Encodes the path, which only has lines, as one feature.
+std::vector<uint32_t> encode(
+    const char* path,
+    mapbox::svg::MvtEncoder::GeometryType type = mapbox::svg::MvtEncoder::Polygon,
+    mapbox::svg::FillRule fillRule = mapbox::svg::FillRule::NonZero) {
+    std::vector<uint32_t> geometry;
+    mapbox::svg::MvtEncoder encoder(geometry, type, fillRule);
+    mapbox::svg::PathFlattener<mapbox::svg::MvtEncoder> flattener(encoder);
+    mapbox::svg::PathNormalizer<decltype(flattener)> normalizer(flattener);
+    mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+    parser(path);
+    encoder.finish();
+    return geometry;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    EXPECT_EQUALS(0u, MvtEncoder::zigzag(0));
+    EXPECT_EQUALS(1u, MvtEncoder::zigzag(-1));
+    EXPECT_EQUALS(2u, MvtEncoder::zigzag(1));
+    EXPECT_EQUALS(4294967295u, MvtEncoder::zigzag(INT32_MIN));
+
+    // The polygon example of the specification.
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 6, 12, 18, 10, 12, 24, 44, 15 }) ==
+                encode("M3 6L8 12L20 34Z"));
+
+    // The line example: the cursor carries over to the next subpath.
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 4, 4, 18, 0, 16, 16, 0, 9, 17, 17, 10, 4, 8 }) ==
+                encode("M2 2L2 10L10 10M1 1L3 5", MvtEncoder::LineString));
+
+    // Points round to the grid, and those that land on the previous one are dropped, as is the
+    // last point of a ring if it is back at the start.
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 0, 0, 26, 20, 0, 0, 20, 19, 0, 15 }) ==
+                encode("M0.2 -0.4L10 0L9.6 0.3L10 10L0 10L0 0Z"));
+
+    // Subpaths are rings even when they are left open. Those with fewer than three points or
+    // without area are dropped, and don't move the cursor.
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 0, 0, 18, 6, 0, 0, 6, 15 }) ==
+                encode("M5 5M1 1L1.1 1.1L5 5ZM1 1L2 1M0 0L2 0L4 0ZM0 0L3 0L3 3"));
+
+    // Lines need a segment, and a closepath draws the one back to the start.
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 0, 0, 10, 2, 2 }) ==
+                encode("M5 5M1 1L1.1 1.1M0 0L1 1M4 4", MvtEncoder::LineString));
+
+    // Drawing after a closepath starts over at the start of the ring.
+    EXPECT_TRUE(
+        (std::vector<uint32_t>{ 9, 0, 0, 18, 2, 0, 0, 2, 15, 9, 1, 1, 18, 0, 3, 2, 0, 15 }) ==
+        encode("M0 0L1 0L1 1ZL0 -2L1 -2"));
+    EXPECT_TRUE(
+        (std::vector<uint32_t>{ 9, 0, 0, 26, 2, 0, 0, 2, 1, 1, 9, 0, 0, 18, 0, 3, 2, 0 }) ==
+        encode("M0 0L1 0L1 1ZL0 -2L1 -2", MvtEncoder::LineString));
+
+    // With the nonzero rule, rings wound against the first one are holes, and all of them are
+    // reversed if the first one runs counterclockwise on the screen. A ring wound like the one
+    // around it is filled, and stays an exterior ring.
+    const std::vector<uint32_t> square{ 9,  0, 0,  26, 20, 0,  0, 20, 19, 0, 15,
+                                        9,  4, 15, 26, 0,  12, 12, 0, 0, 11, 15 };
+    EXPECT_TRUE(square == encode("M0 0h10v10h-10zM2 2v6h6v-6z"));
+    EXPECT_TRUE(square == encode("M0 0v10h10v-10zM2 2h6v6h-6z"));
+    EXPECT_TRUE((std::vector<uint32_t>{ 9, 0, 0, 26, 20, 0, 0, 20, 19, 0, 15,
+                                        9, 4, 15, 26, 12, 0, 0, 12, 11, 0, 15 }) ==
+                encode("M0 0h10v10h-10zM2 2h6v6h-6z"));
+    EXPECT_TRUE(encode("M0 0h10v10h-5h-5zM4 4h2v2h-2z") ==
+                encode("M0 0v10h5h5v-10zM4 4v2h2v-2z"));
+
+    // With the even-odd rule, holes are found by nesting whichever way they are drawn, and
+    // follow their exterior ring. Islands inside holes are exterior rings again.
+    const FillRule evenOdd = FillRule::EvenOdd;
+    EXPECT_TRUE(square == encode("M0 0h10v10h-10zM2 2h6v6h-6z", MvtEncoder::Polygon, evenOdd));
+    EXPECT_TRUE(square == encode("M0 0h10v10h-10zM2 2v6h6v-6z", MvtEncoder::Polygon, evenOdd));
+    EXPECT_TRUE(square == encode("M2 2h6v6h-6zM0 0h10v10h-10z", MvtEncoder::Polygon, evenOdd));
+    EXPECT_TRUE(square == encode("M0 0v10h10v-10zM2 2h6v6h-6z", MvtEncoder::Polygon, evenOdd));
+    std::vector<uint32_t> island = square;
+    island.insert(island.end(), { 9, 7, 4, 26, 4, 0, 0, 4, 3, 0, 15 });
+    EXPECT_TRUE(island == encode("M0 0h10v10h-10zM2 2h6v6h-6zM4 4h2v2h-2z", MvtEncoder::Polygon,
+                                 evenOdd));
+
+    // A whole pipeline, scaled into a tile of extent 4096 and flattened in tile units.
+    std::vector<uint32_t> geometry;
+    MvtEncoder encoder(geometry);
+    PathFlattener<MvtEncoder> flattener(encoder, 0.5);
+    PathNormalizer<decltype(flattener)> normalizer(flattener);
+    PathTransform<decltype(normalizer), ScaleTransform> transform(normalizer,
+                                                                  { 4096 / 24.0, 4096 / 24.0 });
+    PathParser<decltype(transform)> parser(transform);
+    EXPECT_TRUE(parser("M12 2a10 10 0 1 0 0 20a10 10 0 1 0 0-20z"));
+    encoder.finish();
+    EXPECT_EQUALS(MvtEncoder::command(MvtEncoder::MoveTo, 1), geometry.front());
+    EXPECT_EQUALS(MvtEncoder::command(MvtEncoder::ClosePath, 1), geometry.back());
+    EXPECT_EQUALS(geometry.size(), 3 + 1 + 2 * std::size_t(geometry[3] >> 3) + 1);
+    const auto decode = [](const uint32_t value) {
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    };
+    int32_t x = decode(geometry[1]), y = decode(geometry[2]);
+    int32_t minY = y, maxY = y;
+    for (std::size_t i = 4; i + 2 < geometry.size(); i += 2) {
+        x += decode(geometry[i]);
+        y += decode(geometry[i + 1]);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+    // The ring doesn't end on its first point.
+    EXPECT_TRUE(x != decode(geometry[1]) || y != decode(geometry[2]));
+    EXPECT_EQUALS(341, minY);
+    EXPECT_EQUALS(3755, maxY);
+}
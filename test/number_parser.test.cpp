@@ -0,0 +1,147 @@
+#include <mapbox/svg/number_parser.hpp>
+
+#include "expect.hpp"
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+struct Scan {
+    double value;
+    std::ptrdiff_t length;
+};
+
+Scan scan(const char* str) {
+    Scan result{ 0, 0 };
+    const char* last = str + std::strlen(str);
+    result.length = mapbox::svg::detail::parseNumber(str, last, result.value) - str;
+    return result;
+}
+
+float scanFloat(const char* str) {
+    float value = 0;
+    mapbox::svg::detail::parseNumber(str, str + std::strlen(str), value);
+    return value;
+}
+
+bool sameBits(const double a, const double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool sameBits(const float a, const float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+} // namespace
+
+int main() {
+    EXPECT_EQUALS(1.5, scan("1.5.5").value);
+    EXPECT_EQUALS(3, scan("1.5.5").length);
+    EXPECT_EQUALS(0.5, scan(".5").value);
+    EXPECT_EQUALS(-1, scan("-1-2").value);
+    EXPECT_EQUALS(2, scan("-1-2").length);
+    EXPECT_EQUALS(2, scan("+2").value);
+    EXPECT_EQUALS(1, scan("1.").value);
+    EXPECT_EQUALS(2, scan("1.").length);
+    EXPECT_EQUALS(100, scan("1.e2").value);
+    EXPECT_EQUALS(-0.025, scan("-2.5E-2").value);
+    EXPECT_EQUALS(1, scan("1e").value);
+    EXPECT_EQUALS(1, scan("1e").length);
+    EXPECT_EQUALS(1, scan("1e+").length);
+    EXPECT_EQUALS(0, scan("0x10").value);
+    EXPECT_EQUALS(1, scan("0x10").length);
+    EXPECT_TRUE(std::signbit(scan("-0").value));
+
+    // The scanner stops at the end of the slice, even in the middle of a number.
+    double value = 0;
+    const char* slice = "12.5e3";
+    EXPECT_EQUALS(slice + 4, mapbox::svg::detail::parseNumber(slice, slice + 4, value));
+    EXPECT_EQUALS(12.5, value);
+    EXPECT_EQUALS(slice + 4, mapbox::svg::detail::parseNumber(slice, slice + 5, value));
+    EXPECT_EQUALS(12.5, value);
+    EXPECT_EQUALS(slice, mapbox::svg::detail::parseNumber(slice, slice, value));
+
+    // Nothing but a sign or a decimal point is not a number.
+    EXPECT_EQUALS(0, scan(".").length);
+    EXPECT_EQUALS(0, scan("-").length);
+    EXPECT_EQUALS(0, scan("-.e1").length);
+    EXPECT_EQUALS(0, scan("inf").length);
+    EXPECT_EQUALS(0, scan("nan").length);
+
+    EXPECT_TRUE(std::isinf(scan("1e999").value));
+    EXPECT_EQUALS(0, scan("1e-999").value);
+    EXPECT_EQUALS(1e300, scan("1e300").value);
+    EXPECT_EQUALS(123e30, scan("123e30").value);
+    EXPECT_EQUALS(0.1, scan("0.1000000000000000000000000000001").value);
+    EXPECT_EQUALS(12345678901234567890e-10, scan("1234567890.1234567890").value);
+
+    // Halfway cases that a naive multiply-by-power-of-ten conversion rounds the wrong way.
+    EXPECT_TRUE(sameBits(std::strtod("9007199254740993", nullptr), scan("9007199254740993").value));
+    EXPECT_TRUE(sameBits(std::strtod("2.2250738585072011e-308", nullptr),
+                         scan("2.2250738585072011e-308").value));
+    EXPECT_TRUE(sameBits(std::strtod("7.3177701707893310e+15", nullptr),
+                         scan("7.3177701707893310e+15").value));
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int> exponents(-30, 30);
+    unsigned long mismatches = 0;
+    char buffer[64];
+    for (int i = 0; i < 100000; ++i) {
+        const double value = double(random() >> 11) * std::pow(10.0, exponents(random) - 16);
+        std::snprintf(buffer, sizeof(buffer), "%.*e", int(random() % 18), value);
+        if (!sameBits(std::strtod(buffer, nullptr), scan(buffer).value)) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+
+    // Floats are rounded once, from the decimal digits.
+    EXPECT_EQUALS(1.5f, scanFloat("1.5"));
+    EXPECT_EQUALS(0.1f, scanFloat("0.1"));
+    EXPECT_EQUALS(-3e-5f, scanFloat("-3e-5"));
+    EXPECT_TRUE(std::isinf(scanFloat("1e39")));
+    EXPECT_TRUE(sameBits(std::numeric_limits<float>::max(), scanFloat("3.4028235677973366e38")));
+    // Rounding the nearest double, 1.00000005960464477539..., to float would give 1.
+    EXPECT_TRUE(sameBits(std::strtof("1.000000059604644775390626", nullptr),
+                         scanFloat("1.000000059604644775390626")));
+    EXPECT_TRUE(sameBits(std::strtof("1.4e-45", nullptr), scanFloat("1.4e-45")));
+
+    mismatches = 0;
+    char halfway[128];
+    for (int i = 0; i < 100000; ++i) {
+        const float value = float(random() >> 40) * std::pow(10.0f, float(exponents(random) % 20));
+        std::snprintf(buffer, sizeof(buffer), "%.*e", int(random() % 12), double(value));
+        std::string text = buffer;
+        if (i % 4 == 0) {
+            // Exactly halfway between two floats, or just above.
+            const float next = std::nextafter(value, 2 * value + 1);
+            std::snprintf(halfway, sizeof(halfway), "%.70e", (double(value) + double(next)) / 2);
+            text = halfway;
+            if (i % 8) {
+                text.insert(text.find('e'), "1");
+            }
+        }
+        if (!sameBits(std::strtof(text.c_str(), nullptr), scanFloat(text.c_str()))) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+
+    // A comma decimal separator in LC_NUMERIC must not change the result.
+    const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8" };
+    for (const char* locale : locales) {
+        if (std::setlocale(LC_NUMERIC, locale)) {
+            break;
+        }
+    }
+    EXPECT_EQUALS(1.25, scan("1.25").value);
+    EXPECT_EQUALS(4, scan("1.25").length);
+    EXPECT_EQUALS(0.1, scan("0.1000000000000000000000000000001").value);
+    std::setlocale(LC_NUMERIC, "C");
+}
@@ -87,6 +87,23 @@ public:
                equals(xAxisRotation, other.xAxisRotation);
     }
 
+    // The arguments in the order of the VertexReceiver call, with the arc flags as 0 or 1.
+    std::vector<double> values() const {
+        switch (type) {
+            case Type::MoveTo: case Type::LineTo: case Type::SmoothQuadraticCurveTo:
+                return { x, y };
+            case Type::ClosePath: return {};
+            case Type::HorizontalLineTo: return { x };
+            case Type::VerticalLineTo: return { y };
+            case Type::CurveTo: return { x1, y1, x2, y2, x, y };
+            case Type::SmoothCurveTo: return { x2, y2, x, y };
+            case Type::QuadraticCurveTo: return { x1, y1, x, y };
+            case Type::Arc:
+                return { x1, y1, xAxisRotation, double(largeArcFlag), double(sweepFlag), x, y };
+        }
+        return {};
+    }
+
 public:
     static PathCommand MoveTo(double x, double y, bool relative) {
         return { Type::MoveTo, relative, false, false, x, y, 0, 0, 0, 0, 0 };
@@ -206,6 +223,116 @@ using Path = std::vector<PathCommand>;
     return os;
 }
 
+// Records the calls it receives from PathParser.
+struct PathRecorder {
+public:
+    Path path;
+
+    void moveTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::MoveTo(x, y, relative));
+    }
+
+    void closePath() {
+        path.emplace_back(PathCommand::ClosePath());
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::LineTo(x, y, relative));
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        path.emplace_back(PathCommand::HorizontalLineTo(x, relative));
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        path.emplace_back(PathCommand::VerticalLineTo(y, relative));
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::CurveTo(x1, y1, x2, y2, x, y, relative));
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::SmoothCurveTo(x2, y2, x, y, relative));
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::QuadraticCurveTo(x1, y1, x, y, relative));
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::SmoothQuadraticCurveTo(x, y, relative));
+    }
+
+    void arc(double rx, double ry, double xAxisRotation, bool largeArcFlag, bool sweepFlag, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::Arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative));
+    }
+};
+
+// Records the calls it receives from PathNormalizer, as absolute commands.
+struct NormalizedPathRecorder {
+public:
+    Path path;
+
+    void moveTo(double x, double y) {
+        path.emplace_back(PathCommand::MoveTo(x, y, false));
+    }
+
+    void closePath() {
+        path.emplace_back(PathCommand::ClosePath());
+    }
+
+    void lineTo(double x, double y) {
+        path.emplace_back(PathCommand::LineTo(x, y, false));
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y) {
+        path.emplace_back(PathCommand::CurveTo(x1, y1, x2, y2, x, y, false));
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y) {
+        path.emplace_back(PathCommand::QuadraticCurveTo(x1, y1, x, y, false));
+    }
+
+    void arc(double rx,
+             double ry,
+             double xAxisRotation,
+             bool largeArcFlag,
+             bool sweepFlag,
+             double x,
+             double y) {
+        path.emplace_back(
+            PathCommand::Arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, false));
+    }
+};
+
+// Records endpoints only, the way PathParser sends them to a receiver with just these methods:
+// curves and arcs arrive as lines. Implicit linetos are recorded as LineTo.
+struct EndpointRecorder {
+public:
+    Path path;
+
+    void moveTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::MoveTo(x, y, relative));
+    }
+
+    void implicitLineTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::LineTo(x, y, relative));
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::LineTo(x, y, relative));
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        path.emplace_back(PathCommand::HorizontalLineTo(x, relative));
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        path.emplace_back(PathCommand::VerticalLineTo(y, relative));
+    }
+};
+
 } // namespace test
 } // namespace svg
 } // namespace mapbox
@@ -0,0 +1,137 @@
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace {
+
+struct BoxReceiver {
+    mapbox::svg::BoundingBox box;
+
+    void moveTo(double x, double y) {
+        box.extend(x, y);
+    }
+
+    void closePath() {
+    }
+
+    void lineTo(double x, double y) {
+        box.extend(x, y);
+    }
+};
+
+bool near(const double expected, const double actual, const double tolerance = 1e-9) {
+    return std::abs(expected - actual) <= tolerance;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    PathBounds bounds;
+    PathParser<PathBounds> parser(bounds);
+
+    EXPECT_TRUE(bounds.bounds().empty());
+
+    // A circle of radius 2 around (4, 6) made of two arcs.
+    EXPECT_TRUE(parser("M2 6A2 2 0 0 1 6 6A2 2 0 0 1 2 6Z"));
+    EXPECT_TRUE(near(2, bounds.bounds().minX));
+    EXPECT_TRUE(near(6, bounds.bounds().maxX));
+    EXPECT_TRUE(near(4, bounds.bounds().minY));
+    EXPECT_TRUE(near(8, bounds.bounds().maxY));
+
+    bounds.reset();
+    EXPECT_TRUE(parser("M0 0C0 10 10 10 10 0"));
+    EXPECT_TRUE(near(0, bounds.bounds().minX));
+    EXPECT_TRUE(near(10, bounds.bounds().maxX));
+    EXPECT_TRUE(near(0, bounds.bounds().minY));
+    EXPECT_TRUE(near(7.5, bounds.bounds().maxY));
+
+    // Both extrema of an S-shaped cubic in the same axis.
+    bounds.reset();
+    EXPECT_TRUE(parser("M0 0C10 10 -10 10 0 0"));
+    EXPECT_TRUE(near(-2.886751345948129, bounds.bounds().minX));
+    EXPECT_TRUE(near(2.886751345948129, bounds.bounds().maxX));
+
+    bounds.reset();
+    EXPECT_TRUE(parser("M0 0Q5 10 10 0"));
+    EXPECT_TRUE(near(5, bounds.bounds().maxY));
+
+    // Relative, smooth and horizontal and vertical commands.
+    bounds.reset();
+    EXPECT_TRUE(parser("m10 10h5v-20H0zt10 0s10 10 10 0"));
+    EXPECT_TRUE(near(0, bounds.bounds().minX));
+    EXPECT_TRUE(near(-10, bounds.bounds().minY));
+    EXPECT_TRUE(near(30, bounds.bounds().maxX));
+    EXPECT_TRUE(near(130.0 / 9, bounds.bounds().maxY));
+
+    bounds.reset();
+    EXPECT_TRUE(parser("M0 0Q10 10 20 0T40 0"));
+    EXPECT_TRUE(near(-5, bounds.bounds().minY));
+    EXPECT_TRUE(near(5, bounds.bounds().maxY));
+
+    // A half ellipse rotated by 90 degrees, swept counterclockwise.
+    bounds.reset();
+    EXPECT_TRUE(parser("M10 0A20 10 90 1 0 -10 0"));
+    EXPECT_TRUE(near(-10, bounds.bounds().minX));
+    EXPECT_TRUE(near(10, bounds.bounds().maxX));
+    EXPECT_TRUE(near(-20, bounds.bounds().minY));
+    EXPECT_TRUE(near(0, bounds.bounds().maxY));
+
+    // Zero radii make a straight line.
+    bounds.reset();
+    EXPECT_TRUE(parser("M0 0A0 5 0 0 1 10 0"));
+    EXPECT_TRUE(near(0, bounds.bounds().maxY));
+
+    // Random paths: the exact bounds contain a fine flattening and are at most its tolerance
+    // larger.
+    const double tolerance = 0.001;
+    BoxReceiver flattened;
+    PathFlattener<BoxReceiver> flattener(flattened, tolerance);
+    PathNormalizer<PathFlattener<BoxReceiver>> normalizer(flattener);
+    PathParser<decltype(normalizer)> flattenParser(normalizer);
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> coordinate(-50, 50);
+    const char commands[] = "LlHhVvCcSsQqTtAaZ";
+    const int arguments[] = { 2, 2, 1, 1, 1, 1, 6, 6, 4, 4, 4, 4, 2, 2, 7, 7, 0 };
+    unsigned long mismatches = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::string path = "M" + std::to_string(coordinate(random)) + " " +
+                           std::to_string(coordinate(random));
+        for (int k = 0; k < 4; ++k) {
+            const std::size_t command = random() % (sizeof(arguments) / sizeof(arguments[0]));
+            path += commands[command];
+            for (int a = 0; a < arguments[command]; ++a) {
+                const bool flag = (commands[command] == 'A' || commands[command] == 'a') &&
+                                  (a == 3 || a == 4);
+                path += " " + std::to_string(flag ? int(random() % 2) : coordinate(random));
+            }
+        }
+
+        bounds.reset();
+        flattened.box = BoundingBox();
+        normalizer.reset();
+        const bool parsed = parser(path) && flattenParser(path);
+
+        const BoundingBox& exact = bounds.bounds();
+        const BoundingBox& approximate = flattened.box;
+        const double slack = 1e-7;
+        const bool contains = exact.minX <= approximate.minX + slack &&
+                              exact.minY <= approximate.minY + slack &&
+                              exact.maxX >= approximate.maxX - slack &&
+                              exact.maxY >= approximate.maxY - slack;
+        const bool tight = approximate.minX - exact.minX <= tolerance + slack &&
+                           approximate.minY - exact.minY <= tolerance + slack &&
+                           exact.maxX - approximate.maxX <= tolerance + slack &&
+                           exact.maxY - approximate.maxY <= tolerance + slack;
+        mismatches += !parsed || !contains || !tight;
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+}
@@ -0,0 +1,129 @@
+#include "path.hpp"
+
+#include <mapbox/svg/path_buffer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cstdlib>
+
+namespace mapbox {
+namespace svg {
+namespace test {
+
+// Hands out memory from a fixed block and never frees it.
+struct Arena {
+    alignas(8) char data[4096];
+    std::size_t used = 0;
+};
+
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena;
+
+    ArenaAllocator(Arena* arena_) : arena(arena_) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {
+    }
+
+    T* allocate(std::size_t n) {
+        const std::size_t offset = (arena->used + 7) & ~std::size_t(7);
+        if (offset + n * sizeof(T) > sizeof(arena->data)) {
+            std::abort();
+        }
+        arena->used = offset + n * sizeof(T);
+        return reinterpret_cast<T*>(arena->data + offset);
+    }
+
+    void deallocate(T*, std::size_t) {
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+};
+
+} // namespace test
+} // namespace svg
+} // namespace mapbox
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    const char* path = "M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Zh1v2H3V4c1 2 3 4 5 6s1 2 3 4q1 2 3 4t5 6";
+
+    PathRecorder expected;
+    PathParser<PathRecorder> expectedParser(expected);
+    EXPECT_TRUE(expectedParser(path));
+
+    PathBuffer buffer;
+    PathParser<PathBuffer> parser(buffer);
+    EXPECT_TRUE(parser(path));
+    EXPECT_EQUALS(expected.path.size(), buffer.size());
+    EXPECT_EQUALS(std::size_t(2 + 2 + 5 + 5 + 1 + 1 + 1 + 1 + 6 + 4 + 4 + 2), buffer.coordinateSize());
+
+    PathRecorder replayed;
+    buffer.replay(replayed);
+    EXPECT_EQUALS(expected.path, replayed.path);
+
+    // A receiver with only some of the methods gets the same calls as from PathParser.
+    EndpointRecorder expectedEndpoints;
+    PathParser<EndpointRecorder> endpointParser(expectedEndpoints);
+    EXPECT_TRUE(endpointParser(path));
+    EndpointRecorder endpoints;
+    buffer.replay(endpoints);
+    EXPECT_EQUALS(expectedEndpoints.path, endpoints.path);
+    EXPECT_EQUALS(PathCommand::LineTo(4, 4, false), endpoints.path[1]);
+
+    std::size_t index = 0;
+    bool matches = true;
+    for (const auto command : buffer) {
+        const PathCommand& original = expected.path[index++];
+        matches = matches && static_cast<uint8_t>(command.verb()) == static_cast<uint8_t>(original.type) &&
+                  command.relative() == original.relative;
+        if (command.verb() == PathVerb::Arc) {
+            matches = matches && command.largeArcFlag() == original.largeArcFlag &&
+                      command.sweepFlag() == original.sweepFlag &&
+                      command.coordinates()[3] == original.x;
+        }
+    }
+    EXPECT_TRUE(matches);
+    EXPECT_EQUALS(expected.path.size(), index);
+
+    // Reuse keeps the memory.
+    const std::size_t memory = buffer.memoryUsage();
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(parser("M0 0Z"));
+    EXPECT_EQUALS(2u, buffer.size());
+    EXPECT_EQUALS(memory, buffer.memoryUsage());
+
+    // Single precision coordinates from an arena.
+    Arena arena;
+    BasicPathBuffer<float, ArenaAllocator<float>> floatBuffer{ ArenaAllocator<float>(&arena) };
+    floatBuffer.reserve(16, 64);
+    PathParser<BasicPathBuffer<float, ArenaAllocator<float>>> floatParser(floatBuffer);
+    EXPECT_TRUE(floatParser("M0.5 0.25L1 2Z"));
+    EXPECT_EQUALS(std::size_t(16 + 64 * sizeof(float)), floatBuffer.memoryUsage());
+    EXPECT_TRUE(arena.used >= floatBuffer.memoryUsage());
+
+    PathRecorder floats;
+    floatBuffer.replay(floats);
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(0.5, 0.25, false),
+                      test::PathCommand::LineTo(1, 2, false),
+                      test::PathCommand::ClosePath(),
+                  }),
+                  floats.path);
+}
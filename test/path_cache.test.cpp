@@ -0,0 +1,139 @@
+#include "path.hpp"
+
+#include <mapbox/svg/path_cache.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+mapbox::svg::test::Path parse(const std::string& path) {
+    mapbox::svg::test::PathRecorder receiver;
+    mapbox::svg::PathParser<mapbox::svg::test::PathRecorder> parser(receiver);
+    parser(path);
+    return receiver.path;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    // Hits replay the same commands as parsing.
+    {
+        PathCache cache(1 << 20, 4);
+        const std::string path = "M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z";
+        for (int i = 0; i < 3; ++i) {
+            PathRecorder receiver;
+            EXPECT_TRUE(cache.replay(path, receiver));
+            EXPECT_EQUALS(parse(path), receiver.path);
+        }
+        // Also to receivers with only some of the methods.
+        EndpointRecorder endpoints, expected;
+        EXPECT_TRUE(cache.replay(path, endpoints));
+        PathParser<EndpointRecorder> parser(expected);
+        parser(path);
+        EXPECT_EQUALS(expected.path, endpoints.path);
+        const PathCacheStatistics statistics = cache.statistics();
+        EXPECT_EQUALS(3ull, (unsigned long long)statistics.hits);
+        EXPECT_EQUALS(1ull, (unsigned long long)statistics.misses);
+        EXPECT_EQUALS(0ull, (unsigned long long)statistics.evictions);
+        EXPECT_EQUALS(std::size_t(1), statistics.entries);
+        EXPECT_EQUALS(cache.get(path)->memoryUsage(), statistics.memoryUsage);
+    }
+
+    // Invalid paths keep their result and the commands before the error.
+    {
+        PathCache cache(1 << 20);
+        PathRecorder receiver;
+        EXPECT_FALSE(cache.replay("M1 2L3 4#", receiver));
+        receiver.path.clear();
+        EXPECT_FALSE(cache.replay("M1 2L3 4#", receiver));
+        EXPECT_EQUALS(parse("M1 2L3 4#"), receiver.path);
+        const auto entry = cache.get("M1 2L3 4#");
+        EXPECT_EQUALS(PathParseErrorType::CommandParsing, entry->result().error);
+        EXPECT_EQUALS(std::ptrdiff_t(9), entry->result().errorOffset);
+    }
+
+    // Least recently used entries are evicted to stay within the budget, and evicted entries
+    // stay valid while they are held.
+    {
+        PathCache cache(2048, 1);
+        const std::string first = "M0 0L1 1", second = "M0 0L2 2";
+        const auto held = cache.get(first);
+        const std::size_t cost = held->memoryUsage();
+        std::vector<std::string> paths;
+        for (int i = 0; i < 100; ++i) {
+            paths.push_back("M" + std::to_string(i) + " 5L1 1");
+        }
+        cache.get(second);
+        for (const std::string& path : paths) {
+            cache.get(second);
+            cache.get(path);
+        }
+        const PathCacheStatistics statistics = cache.statistics();
+        EXPECT_TRUE(statistics.memoryUsage <= 2048);
+        EXPECT_TRUE(statistics.entries >= 2048 / (cost + 8) - 1);
+        EXPECT_EQUALS(102ull, (unsigned long long)(statistics.entries + statistics.evictions));
+        EXPECT_EQUALS(100ull, (unsigned long long)statistics.hits);
+
+        // The frequently used path survived, the first one didn't.
+        const uint64_t misses = statistics.misses;
+        cache.get(second);
+        EXPECT_EQUALS(misses, cache.statistics().misses);
+        cache.get(first);
+        EXPECT_EQUALS(misses + 1, cache.statistics().misses);
+        PathRecorder receiver;
+        held->replay(receiver);
+        EXPECT_EQUALS(parse(first), receiver.path);
+
+        cache.clear();
+        EXPECT_EQUALS(std::size_t(0), cache.statistics().entries);
+        EXPECT_EQUALS(std::size_t(0), cache.statistics().memoryUsage);
+    }
+
+    // Paths too big for a shard are parsed but not kept.
+    {
+        PathCache cache(256, 1);
+        PathRecorder receiver;
+        const std::string path = "M0 0L1 1L2 2L3 3L4 4L5 5L6 6L7 7L8 8L9 9Z";
+        EXPECT_TRUE(cache.replay(path, receiver));
+        EXPECT_EQUALS(parse(path), receiver.path);
+        EXPECT_EQUALS(std::size_t(0), cache.statistics().entries);
+    }
+
+    // Threads sharing a cache all get the right paths.
+    {
+        FloatPathCache cache(64 << 10, 8);
+        std::vector<std::string> paths;
+        for (int i = 0; i < 500; ++i) {
+            paths.push_back("M" + std::to_string(i) + " 1h2v3c1 2 3 4 5 6z");
+        }
+        std::atomic<int> mismatches{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 20000; ++i) {
+                    const std::string& path = paths[(i * (t + 1) * 7919u) % paths.size()];
+                    const auto entry = cache.get(path);
+                    mismatches += entry->path().size() != 5 ||
+                                  entry->path().coordinateData()[0] !=
+                                      float(std::stoi(path.substr(1)));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQUALS(0, mismatches.load());
+        const PathCacheStatistics statistics = cache.statistics();
+        EXPECT_EQUALS(80000ull, (unsigned long long)(statistics.hits + statistics.misses));
+        EXPECT_TRUE(statistics.memoryUsage <= (64 << 10));
+    }
+}
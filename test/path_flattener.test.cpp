@@ -0,0 +1,122 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+struct Point {
+    double x, y;
+};
+
+struct PolylineReceiver {
+    std::vector<Point> points;
+    unsigned long moves = 0;
+    unsigned long closes = 0;
+
+    void moveTo(double x, double y) {
+        ++moves;
+        points.push_back({ x, y });
+    }
+
+    void closePath() {
+        ++closes;
+    }
+
+    void lineTo(double x, double y) {
+        points.push_back({ x, y });
+    }
+};
+
+double distanceToSegment(const Point& p, const Point& a, const Point& b) {
+    const double dx = b.x - a.x, dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0;
+    t = std::max(0.0, std::min(1.0, t));
+    return std::hypot(p.x - a.x - t * dx, p.y - a.y - t * dy);
+}
+
+// Largest distance from a point on the curve to the polyline.
+template <typename Curve>
+double deviation(const std::vector<Point>& points, Curve curve) {
+    double result = 0;
+    for (int i = 0; i <= 1000; ++i) {
+        const Point p = curve(i / 1000.0);
+        double nearest = INFINITY;
+        for (std::size_t j = 1; j < points.size(); ++j) {
+            nearest = std::min(nearest, distanceToSegment(p, points[j - 1], points[j]));
+        }
+        result = std::max(result, nearest);
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    const double tolerance = 0.1;
+    PolylineReceiver receiver;
+    PathFlattener<PolylineReceiver> flattener(receiver, tolerance);
+    PathNormalizer<PathFlattener<PolylineReceiver>> normalizer(flattener);
+    PathParser<PathNormalizer<PathFlattener<PolylineReceiver>>> parser(normalizer);
+
+    EXPECT_TRUE(parser("M0 0C0 100 100 100 100 0"));
+    EXPECT_TRUE(receiver.points.size() > 2);
+    EXPECT_TRUE(deviation(receiver.points, [](double t) {
+                    const double u = 1 - t;
+                    return Point{ 300 * u * t * t + 100 * t * t * t, 300 * u * u * t + 300 * u * t * t };
+                }) <= tolerance);
+    EXPECT_EQUALS(100, receiver.points.back().x);
+    EXPECT_EQUALS(0, receiver.points.back().y);
+
+    receiver.points.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0Q50 100 100 0"));
+    EXPECT_TRUE(deviation(receiver.points, [](double t) {
+                    const double u = 1 - t;
+                    return Point{ 2 * u * t * 50 + t * t * 100, 2 * u * t * 100 };
+                }) <= tolerance);
+
+    // Straight curves need a single segment.
+    receiver.points.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0C1 1 2 2 3 3"));
+    EXPECT_EQUALS(2u, receiver.points.size());
+
+    // The radii are too small to reach the end point, so they are scaled up to a half circle.
+    receiver.points.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0A1 1 0 0 1 10 0"));
+    EXPECT_TRUE(receiver.points.size() > 3);
+    bool onCircle = true;
+    for (const Point& p : receiver.points) {
+        onCircle = onCircle && std::abs(std::hypot(p.x - 5, p.y) - 5) < 1e-9 && p.y <= 1e-9;
+    }
+    EXPECT_TRUE(onCircle);
+    EXPECT_TRUE(deviation(receiver.points, [](double t) {
+                    return Point{ 5 - 5 * std::cos(t * M_PI), -5 * std::sin(t * M_PI) };
+                }) <= tolerance);
+
+    // A rotated ellipse, swept the other way.
+    receiver.points.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M10 0A20 10 90 1 0 -10 0"));
+    bool onEllipse = true;
+    for (const Point& p : receiver.points) {
+        onEllipse = onEllipse && std::abs(p.x * p.x / 100 + p.y * p.y / 400 - 1) < 1e-9 && p.y <= 1e-9;
+    }
+    EXPECT_TRUE(onEllipse);
+
+    // Zero radii make a straight line, and coincident end points no segment at all.
+    receiver.points.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0A0 5 0 0 1 10 0A5 5 0 0 1 10 0Z"));
+    EXPECT_EQUALS(2u, receiver.points.size());
+    EXPECT_EQUALS(1ul, receiver.closes);
+}
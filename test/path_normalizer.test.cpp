@@ -0,0 +1,76 @@
+#include "path.hpp"
+
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+
+#include "expect.hpp"
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    NormalizedPathRecorder receiver;
+    PathNormalizer<NormalizedPathRecorder> normalizer(receiver);
+    PathParser<PathNormalizer<NormalizedPathRecorder>> parser(normalizer);
+
+    EXPECT_TRUE(parser("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(6, 12, false),
+                      test::PathCommand::LineTo(4, 4, false),
+                      test::PathCommand::Arc(2, 2, 0, true, true, 2, 6, false),
+                      test::PathCommand::Arc(2, 2, 0, false, true, 6, 12, false),
+                      test::PathCommand::ClosePath(),
+                  }),
+                  receiver.path);
+
+    // Lines, and relative commands after closing a subpath.
+    receiver.path.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("m1 1h2v3H0V1l1 1zm1 1l1 0"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(1, 1, false),
+                      test::PathCommand::LineTo(3, 1, false),
+                      test::PathCommand::LineTo(3, 4, false),
+                      test::PathCommand::LineTo(0, 4, false),
+                      test::PathCommand::LineTo(0, 1, false),
+                      test::PathCommand::LineTo(1, 2, false),
+                      test::PathCommand::ClosePath(),
+                      test::PathCommand::MoveTo(2, 2, false),
+                      test::PathCommand::LineTo(3, 2, false),
+                  }),
+                  receiver.path);
+
+    // The pairs after the first one of a moveto are lines, relative ones included.
+    receiver.path.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0 16 0 16 16zm1 1 2 2 1 0"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(0, 0, false),
+                      test::PathCommand::LineTo(16, 0, false),
+                      test::PathCommand::LineTo(16, 16, false),
+                      test::PathCommand::ClosePath(),
+                      test::PathCommand::MoveTo(1, 1, false),
+                      test::PathCommand::LineTo(3, 3, false),
+                      test::PathCommand::LineTo(4, 3, false),
+                  }),
+                  receiver.path);
+
+    // Smooth curves reflect the previous control point only after a curve of the same kind.
+    receiver.path.clear();
+    normalizer.reset();
+    EXPECT_TRUE(parser("M0 0c1 1 2 1 3 0s2-1 3 0S8 2 9 0L10 0s1 1 2 0Q13 1 14 0t2 0 2 0L20 0T22 0"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(0, 0, false),
+                      test::PathCommand::CurveTo(1, 1, 2, 1, 3, 0, false),
+                      test::PathCommand::CurveTo(4, -1, 5, -1, 6, 0, false),
+                      test::PathCommand::CurveTo(7, 1, 8, 2, 9, 0, false),
+                      test::PathCommand::LineTo(10, 0, false),
+                      test::PathCommand::CurveTo(10, 0, 11, 1, 12, 0, false),
+                      test::PathCommand::QuadraticCurveTo(13, 1, 14, 0, false),
+                      test::PathCommand::QuadraticCurveTo(15, -1, 16, 0, false),
+                      test::PathCommand::QuadraticCurveTo(17, 1, 18, 0, false),
+                      test::PathCommand::LineTo(20, 0, false),
+                      test::PathCommand::QuadraticCurveTo(20, 0, 22, 0, false),
+                  }),
+                  receiver.path);
+}
@@ -4,6 +4,8 @@
 
 #include "expect.hpp"
 
+#include <string>
+
 namespace mapbox {
 namespace svg {
 namespace test {
@@ -57,6 +59,94 @@ public:
 } // namespace svg
 } // namespace mapbox
 
+namespace {
+
+// Receives endpoints only: curves and arcs become lines.
+struct EndpointReceiver {
+    std::string log;
+
+    void moveTo(double x, double y, bool relative) {
+        add('M', x, y, relative);
+    }
+    void lineTo(double x, double y, bool relative) {
+        add('L', x, y, relative);
+    }
+    void horizontalLineTo(double x, bool relative) {
+        add('H', x, 0, relative);
+    }
+    void verticalLineTo(double y, bool relative) {
+        add('V', 0, y, relative);
+    }
+    void add(const char command, const double x, const double y, const bool relative) {
+        log += std::string(1, relative ? char(command + 'a' - 'A') : command) +
+               std::to_string(int(x)) + "," + std::to_string(int(y)) + " ";
+    }
+};
+
+// Ignores the control points of cubic curves, and everything but subpaths.
+struct OutlineReceiver {
+    std::string log;
+
+    void moveTo(mapbox::svg::UnconvertedNumber, mapbox::svg::UnconvertedNumber, bool) {
+        log += "M ";
+    }
+    void closePath() {
+        log += "Z ";
+    }
+    void curveTo(mapbox::svg::UnconvertedNumber,
+                 mapbox::svg::UnconvertedNumber,
+                 mapbox::svg::UnconvertedNumber,
+                 mapbox::svg::UnconvertedNumber,
+                 double x,
+                 double y,
+                 bool) {
+        log += "C" + std::to_string(int(x)) + "," + std::to_string(int(y)) + " ";
+    }
+};
+
+// Takes coordinates of any type.
+struct TemplateReceiver {
+    std::string log;
+
+    template <typename X, typename Y>
+    void moveTo(X x, Y y, bool) {
+        log += "M" + std::to_string(int(x + y)) + " ";
+    }
+    template <typename X, typename Y>
+    void lineTo(X x, Y y, bool) {
+        log += "L" + std::to_string(int(x + y)) + " ";
+    }
+    template <typename X>
+    void horizontalLineTo(X x, bool) {
+        log += "H" + std::to_string(int(x)) + " ";
+    }
+    template <typename Y>
+    void verticalLineTo(Y y, bool) {
+        log += "V" + std::to_string(int(y)) + " ";
+    }
+    template <typename T>
+    void curveTo(T, T, T, T, T x, T y, bool) {
+        log += "C" + std::to_string(int(x + y)) + " ";
+    }
+};
+
+// Has curveTo methods that all miss a parameter.
+struct MismatchedReceiver {
+    void moveTo(double, double, bool) {
+    }
+    void curveTo(double, double, double, double, double, double) {
+    }
+    template <typename T>
+    void curveTo(T, T, T, T, T, T, T, T) {
+    }
+};
+
+static_assert(mapbox::svg::detail::HasMatchingMethods<TemplateReceiver, double>::value, "");
+static_assert(mapbox::svg::detail::HasMatchingMethods<EndpointReceiver, double>::value, "");
+static_assert(!mapbox::svg::detail::HasMatchingMethods<MismatchedReceiver, double>::value, "");
+
+} // namespace
+
 int main() {
     using namespace mapbox::svg;
     using namespace mapbox::svg::test;
@@ -88,4 +178,81 @@ int main() {
                       test::PathCommand::MoveTo(0, 0, false),
                   }),
                   receiver.path);
+
+    receiver.path.clear();
+    EXPECT_TRUE(parser("M1.5.5L-1-2+3e1,.5e-1"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(1.5, 0.5, false),
+                      test::PathCommand::LineTo(-1, -2, false),
+                      test::PathCommand::LineTo(30, 0.05, false),
+                  }),
+                  receiver.path);
+
+    receiver.path.clear();
+    EXPECT_FALSE(parser("M0,0L1e999,0"));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, parser.errorType());
+    EXPECT_EQUALS(5, parser.errorOffset());
+
+    // Slices are parsed without reading past their end.
+    const char* data = "M1,2L3,45";
+    receiver.path.clear();
+    EXPECT_TRUE(parser(data, 8));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(1, 2, false),
+                      test::PathCommand::LineTo(3, 4, false),
+                  }),
+                  receiver.path);
+
+    receiver.path.clear();
+    EXPECT_FALSE(parser(data + 4, 3));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, parser.errorType());
+    EXPECT_EQUALS(3, parser.errorOffset());
+
+    receiver.path.clear();
+    EXPECT_FALSE(parser(std::string("M1 2\0L3 4", 10)));
+    EXPECT_EQUALS(PathParseErrorType::CommandParsing, parser.errorType());
+    EXPECT_EQUALS(5, parser.errorOffset());
+
+    // Float coordinates are rounded once, and overflow the float range sooner.
+    PathParser<PathVertexReceiver, float> floatParser(receiver);
+    receiver.path.clear();
+    EXPECT_TRUE(floatParser("M0.1,2"));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(double(0.1f), 2, false),
+                  }),
+                  receiver.path);
+
+    receiver.path.clear();
+    EXPECT_FALSE(floatParser("M1e39,0"));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, floatParser.errorType());
+    EXPECT_EQUALS(1, floatParser.errorOffset());
+
+    // Receivers without curve methods get lines to the endpoints.
+    EndpointReceiver endpoints;
+    PathParser<EndpointReceiver> endpointParser(endpoints);
+    EXPECT_TRUE(endpointParser("M1 2C3 4 5 6 7 8s1 1 2 2Q1 1 3 3t4 4A1 1 0 0 1 9 10h5V6z"));
+    EXPECT_EQUALS(std::string("M1,2 L7,8 l2,2 L3,3 l4,4 L9,10 h5,0 V0,6 "), endpoints.log);
+
+    // Template parameters get coordinates.
+    TemplateReceiver templates;
+    PathParser<TemplateReceiver> templateParser(templates);
+    EXPECT_TRUE(templateParser("M1 2L3 4h5v6C1 2 3 4 5 6"));
+    EXPECT_EQUALS(std::string("M3 L7 H5 V6 C11 "), templates.log);
+
+    // Arguments a receiver doesn't convert are still checked, and so are dropped commands.
+    OutlineReceiver outline;
+    PathParser<OutlineReceiver> outlineParser(outline);
+    EXPECT_TRUE(outlineParser("M1 2C3 4 5 6 7 8L1 2 3 4ZM0 0"));
+    EXPECT_EQUALS(std::string("M C7,8 Z M "), outline.log);
+
+    EXPECT_FALSE(outlineParser("M1 2C3 4 5 1e999 7 8"));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, outlineParser.errorType());
+    EXPECT_EQUALS(11, outlineParser.errorOffset());
+
+    EXPECT_FALSE(outlineParser("M1 2L3 -"));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, outlineParser.errorType());
+    EXPECT_EQUALS(7, outlineParser.errorOffset());
+
+    EXPECT_FALSE(outlineParser("M1 2A1 1 0 2 1 3 3"));
+    EXPECT_EQUALS(PathParseErrorType::FlagParsing, outlineParser.errorType());
 }
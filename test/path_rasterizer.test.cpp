@@ -0,0 +1,200 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_rasterizer.hpp>
+
+#include "expect.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Point {
+    double x, y;
+};
+
+using Rings = std::vector<std::vector<Point>>;
+
+void draw(const Rings& rings, mapbox::svg::PathRasterizer& rasterizer) {
+    rasterizer.reset();
+    for (const auto& ring : rings) {
+        rasterizer.moveTo(ring[0].x, ring[0].y);
+        for (std::size_t i = 1; i < ring.size(); ++i) {
+            rasterizer.lineTo(ring[i].x, ring[i].y);
+        }
+    }
+}
+
+std::vector<uint8_t> render(const mapbox::svg::PathRasterizer& rasterizer,
+                            const unsigned width,
+                            const unsigned height,
+                            const mapbox::svg::RasterOptions& options) {
+    std::vector<uint8_t> alpha(width * height, 7);
+    rasterizer.rasterize(options, alpha.data(), width, height, width);
+    return alpha;
+}
+
+// Reference: the share of 16 x 16 samples in each pixel whose winding number is inside.
+std::vector<uint8_t> supersample(const Rings& rings,
+                                 const unsigned width,
+                                 const unsigned height,
+                                 const mapbox::svg::FillRule rule) {
+    std::vector<uint8_t> alpha;
+    for (unsigned row = 0; row < height; ++row) {
+        for (unsigned column = 0; column < width; ++column) {
+            int inside = 0;
+            for (int sy = 0; sy < 16; ++sy) {
+                for (int sx = 0; sx < 16; ++sx) {
+                    const double px = column + (sx + 0.5) / 16, py = row + (sy + 0.5) / 16;
+                    int winding = 0;
+                    for (const auto& ring : rings) {
+                        for (std::size_t i = 0; i < ring.size(); ++i) {
+                            const Point& a = ring[i];
+                            const Point& b = ring[(i + 1) % ring.size()];
+                            if ((a.y <= py) != (b.y <= py) &&
+                                a.x + (py - a.y) * (b.x - a.x) / (b.y - a.y) < px) {
+                                winding += b.y > a.y ? 1 : -1;
+                            }
+                        }
+                    }
+                    inside += mapbox::svg::isInside(rule, winding);
+                }
+            }
+            alpha.push_back(uint8_t(inside * 255 / 256));
+        }
+    }
+    return alpha;
+}
+
+int maxDifference(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    int difference = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        difference = std::max(difference, std::abs(int(a[i]) - int(b[i])));
+    }
+    return difference;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    // Squares on and between pixel edges, from a parsed path.
+    {
+        PathRasterizer rasterizer;
+        PathFlattener<PathRasterizer> flattener(rasterizer);
+        PathNormalizer<PathFlattener<PathRasterizer>> normalizer(flattener);
+        PathParser<PathNormalizer<PathFlattener<PathRasterizer>>> parser(normalizer);
+        EXPECT_TRUE(parser("M1 1h3v3H1zM5.5 1.5h2v2h-2z"));
+
+        const std::vector<uint8_t> alpha = render(rasterizer, 8, 8, RasterOptions());
+        EXPECT_EQUALS(0, int(alpha[0]));
+        EXPECT_EQUALS(255, int(alpha[1 * 8 + 1]));
+        EXPECT_EQUALS(255, int(alpha[3 * 8 + 3]));
+        EXPECT_EQUALS(0, int(alpha[4 * 8 + 4]));
+        EXPECT_EQUALS(64, int(alpha[1 * 8 + 5]));
+        EXPECT_EQUALS(128, int(alpha[1 * 8 + 6]));
+        EXPECT_EQUALS(255, int(alpha[2 * 8 + 6]));
+        EXPECT_EQUALS(128, int(alpha[2 * 8 + 7]));
+        EXPECT_EQUALS(0, int(alpha[5 * 8 + 6]));
+    }
+
+    // Fill rules, with a square inside another of the same direction.
+    {
+        PathRasterizer rasterizer;
+        draw({ { { 0, 0 }, { 8, 0 }, { 8, 8 }, { 0, 8 } },
+               { { 2, 2 }, { 6, 2 }, { 6, 6 }, { 2, 6 } } },
+             rasterizer);
+        RasterOptions options;
+        EXPECT_EQUALS(255, int(render(rasterizer, 8, 8, options)[4 * 8 + 4]));
+        options.fillRule = FillRule::EvenOdd;
+        EXPECT_EQUALS(0, int(render(rasterizer, 8, 8, options)[4 * 8 + 4]));
+        EXPECT_EQUALS(255, int(render(rasterizer, 8, 8, options)[1 * 8 + 1]));
+    }
+
+    // Covered area, for a triangle.
+    {
+        PathRasterizer rasterizer;
+        draw({ { { 1.3, 0.2 }, { 30.7, 5.9 }, { 12.1, 27.4 } } }, rasterizer);
+        const std::vector<uint8_t> alpha = render(rasterizer, 32, 32, RasterOptions());
+        double sum = 0;
+        for (const uint8_t value : alpha) {
+            sum += value / 255.0;
+        }
+        const double area =
+            std::abs((30.7 - 1.3) * (27.4 - 0.2) - (12.1 - 1.3) * (5.9 - 0.2)) / 2;
+        EXPECT_TRUE(std::abs(sum - area) < 0.1);
+    }
+
+    // Random polygons around a point, with an island inside, partly outside of the canvas,
+    // against supersampling. Accumulation only approximates pixels that several edges pass
+    // through, so edges stay apart. Tiles and threads split the canvas without changing the
+    // result by more than the rounding of a sum.
+    {
+        std::mt19937 random(3);
+        std::uniform_real_distribution<double> center(-4, 52), radius(10, 20);
+        PathRasterizer rasterizer;
+        int worst = 0, tileDifference = 0, threadMismatches = 0;
+        for (int i = 0; i < 100; ++i) {
+            const double cx = center(random), cy = center(random);
+            Rings rings(2, std::vector<Point>(std::size_t(5 + i % 9)));
+            for (std::size_t k = 0; k < rings[0].size(); ++k) {
+                const double angle = 2 * M_PI * k / rings[0].size(), r = radius(random);
+                rings[0][k] = { cx + r * std::cos(angle), cy + r * std::sin(angle) };
+                rings[1][k] = { cx + 0.3 * r * std::cos(angle), cy + 0.3 * r * std::sin(angle) };
+            }
+            draw(rings, rasterizer);
+
+            RasterOptions options;
+            options.fillRule = i % 2 ? FillRule::EvenOdd : FillRule::NonZero;
+            options.tileSize = 1000;
+            const std::vector<uint8_t> whole = render(rasterizer, 48, 40, options);
+            worst = std::max(worst,
+                             maxDifference(whole, supersample(rings, 48, 40, options.fillRule)));
+
+            options.tileSize = unsigned(3 + i % 14);
+            options.threads = 1;
+            const std::vector<uint8_t> tiled = render(rasterizer, 48, 40, options);
+            tileDifference = std::max(tileDifference, maxDifference(whole, tiled));
+            options.threads = 4;
+            threadMismatches += tiled != render(rasterizer, 48, 40, options);
+        }
+        // A grid of 16 x 16 samples is off by a few steps of 1 / 256 where edges cross it.
+        EXPECT_TRUE(worst <= 12);
+        EXPECT_TRUE(tileDifference <= 1);
+        EXPECT_EQUALS(0, threadMismatches);
+    }
+
+    // Coordinates far outside of the canvas, or not finite, fall into the tiles at its border.
+    {
+        PathRasterizer rasterizer;
+        draw({ { { -1e30, -1e30 }, { 1e30, -1e30 }, { 0, 1e30 } } }, rasterizer);
+        RasterOptions options;
+        options.tileSize = 8;
+        const std::vector<uint8_t> alpha = render(rasterizer, 20, 20, options);
+        EXPECT_TRUE(std::all_of(alpha.begin(), alpha.end(), [](uint8_t v) { return v == 255; }));
+
+        draw({ { { NAN, 0 }, { INFINITY, -INFINITY }, { 1, NAN }, { 2, 30 } } }, rasterizer);
+        EXPECT_EQUALS(std::size_t(20 * 20), render(rasterizer, 20, 20, options).size());
+    }
+
+    // Only the canvas is written, with rows apart by the stride.
+    {
+        PathRasterizer rasterizer;
+        draw({ { { -10, -10 }, { 100, -10 }, { 100, 100 }, { -10, 100 } } }, rasterizer);
+        std::vector<uint8_t> alpha(10 * 6, 7);
+        rasterizer.rasterize(RasterOptions(), alpha.data(), 5, 6, 10);
+        int written = 0, untouched = 0;
+        for (std::size_t i = 0; i < alpha.size(); ++i) {
+            written += i % 10 < 5 && alpha[i] == 255;
+            untouched += i % 10 >= 5 && alpha[i] == 7;
+        }
+        EXPECT_EQUALS(30, written);
+        EXPECT_EQUALS(30, untouched);
+    }
+}
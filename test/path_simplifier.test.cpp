@@ -0,0 +1,246 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_simplifier.hpp>
+
+#include "expect.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Point {
+    double x, y;
+};
+
+using Line = std::vector<Point>;
+
+struct Recorder {
+    std::vector<Line> lines;
+    std::vector<bool> closed;
+
+    void moveTo(double x, double y) {
+        lines.push_back({ { x, y } });
+        closed.push_back(false);
+    }
+
+    void closePath() {
+        closed.back() = true;
+    }
+
+    void lineTo(double x, double y) {
+        lines.back().push_back({ x, y });
+    }
+};
+
+template <typename Receiver>
+void draw(const Line& line, const bool close, Receiver& receiver) {
+    receiver.moveTo(line[0].x, line[0].y);
+    for (std::size_t i = 1; i < line.size(); ++i) {
+        receiver.lineTo(line[i].x, line[i].y);
+    }
+    if (close) {
+        receiver.closePath();
+    }
+}
+
+double distance(const Point& p, const Point& a, const Point& b) {
+    const double dx = b.x - a.x, dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    const double t =
+        lengthSquared > 0
+            ? std::min(1.0, std::max(0.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared))
+            : 0;
+    return std::hypot(a.x + t * dx - p.x, a.y + t * dy - p.y);
+}
+
+// The largest distance of an original point from the simplified line.
+double deviation(const Line& original, const Line& simplified) {
+    double worst = 0;
+    for (const Point& p : original) {
+        double best = INFINITY;
+        for (std::size_t i = 0; i + 1 < simplified.size(); ++i) {
+            best = std::min(best, distance(p, simplified[i], simplified[i + 1]));
+        }
+        worst = std::max(worst, best);
+    }
+    return worst;
+}
+
+bool crosses(const Point& a, const Point& b, const Point& c, const Point& d) {
+    const auto cross = [](const Point& o, const Point& p, const Point& q) {
+        return (p.x - o.x) * (q.y - o.y) - (p.y - o.y) * (q.x - o.x);
+    };
+    const double d1 = cross(a, b, c), d2 = cross(a, b, d);
+    const double d3 = cross(c, d, a), d4 = cross(c, d, b);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0)) && d1 && d2 && d3 && d4;
+}
+
+// Number of pairs of edges of a ring that cross.
+int crossings(const Line& ring) {
+    int count = 0;
+    const std::size_t n = ring.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 2; j < n; ++j) {
+            if (i == 0 && j == n - 1) {
+                continue;
+            }
+            count += crosses(ring[i], ring[i + 1], ring[j], ring[(j + 1) % n]);
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    // Points along straight lines are dropped; corners are kept.
+    {
+        Recorder recorder;
+        PathSimplifier<Recorder> simplifier(recorder, 0.1);
+        PathFlattener<PathSimplifier<Recorder>> flattener(simplifier);
+        PathNormalizer<PathFlattener<PathSimplifier<Recorder>>> normalizer(flattener);
+        PathParser<PathNormalizer<PathFlattener<PathSimplifier<Recorder>>>> parser(normalizer);
+        EXPECT_TRUE(parser("M0 0h1h1h1l1 .05 1-.05v3M0 10h2v2h-1h-1z"));
+        simplifier.finish();
+        EXPECT_EQUALS(std::size_t(2), recorder.lines.size());
+        EXPECT_EQUALS(std::size_t(3), recorder.lines[0].size());
+        EXPECT_EQUALS(5.0, recorder.lines[0][1].x);
+        EXPECT_EQUALS(3.0, recorder.lines[0][2].y);
+        EXPECT_FALSE(recorder.closed[0]);
+        EXPECT_EQUALS(std::size_t(4), recorder.lines[1].size());
+        EXPECT_TRUE(recorder.closed[1]);
+    }
+
+    // A ring smaller than the tolerance keeps three points.
+    {
+        Recorder recorder;
+        PathSimplifier<Recorder> simplifier(recorder, 10);
+        draw({ { 0, 0 }, { 1, 0 }, { 1.5, 0.5 }, { 1, 1 }, { 0, 1 } }, true, simplifier);
+        EXPECT_EQUALS(std::size_t(3), recorder.lines[0].size());
+    }
+
+    // Random walks stay within the tolerance, whether the window holds the whole line or not.
+    {
+        std::mt19937 random(9);
+        std::normal_distribution<double> step(0, 1);
+        double worst = 0;
+        std::size_t input = 0, output = 0;
+        for (int i = 0; i < 100; ++i) {
+            Line line(1, Point{ 0, 0 });
+            for (int k = 0; k < 50 + 20 * i; ++k) {
+                line.push_back({ line.back().x + step(random), line.back().y + step(random) });
+            }
+            Recorder recorder;
+            PathSimplifier<Recorder> simplifier(recorder, 2, i % 2 == 1,
+                                                std::size_t(i % 3 ? 1024 : 3 + i));
+            draw(line, false, simplifier);
+            simplifier.finish();
+            worst = std::max(worst, deviation(line, recorder.lines[0]));
+            input += line.size();
+            output += recorder.lines[0].size();
+        }
+        EXPECT_TRUE(worst <= 2);
+        EXPECT_TRUE(output * 2 < input);
+    }
+
+    // Thin wavy bands cross themselves once simplified, unless the topology is preserved.
+    {
+        std::mt19937 random(4);
+        std::uniform_real_distribution<double> noise(-0.3, 0.3);
+        int plain = 0, preserved = 0;
+        double worst = 0;
+        for (int i = 0; i < 100; ++i) {
+            Line ring;
+            for (int k = 0; k < 200; ++k) {
+                ring.push_back({ k * 0.5, 5 * std::sin(k / 14.0) + noise(random) });
+            }
+            for (int k = 200; k-- > 0;) {
+                ring.push_back({ k * 0.5, 1 + 5 * std::sin(k / 14.0) + noise(random) });
+            }
+            for (const bool preserveWindowTopology : { false, true }) {
+                Recorder recorder;
+                PathSimplifier<Recorder> simplifier(recorder, 1.5, preserveWindowTopology);
+                draw(ring, true, simplifier);
+                (preserveWindowTopology ? preserved : plain) += crossings(recorder.lines[0]) > 0;
+                Line closed = recorder.lines[0];
+                closed.push_back(closed[0]);
+                worst = std::max(worst, deviation(ring, closed));
+            }
+        }
+        EXPECT_TRUE(plain > 50);
+        EXPECT_EQUALS(0, preserved);
+        EXPECT_TRUE(worst <= 1.5);
+    }
+
+    // Rings longer than one window are untangled window by window: the outward side of the band
+    // and the start of the way back share the first window, where they no longer cross.
+    {
+        std::mt19937 random(5);
+        std::uniform_real_distribution<double> noise(-0.3, 0.3);
+        const std::size_t capacity = 256;
+        int plain = 0, preserved = 0;
+        double worst = 0;
+        for (int i = 0; i < 20; ++i) {
+            Line ring;
+            for (int k = 0; k < 200; ++k) {
+                ring.push_back({ k * 0.5, 5 * std::sin(k / 14.0) + noise(random) });
+            }
+            for (int k = 200; k-- > 0;) {
+                ring.push_back({ k * 0.5, 1 + 5 * std::sin(k / 14.0) + noise(random) });
+            }
+            for (const bool preserveWindowTopology : { false, true }) {
+                Recorder recorder;
+                PathSimplifier<Recorder> simplifier(recorder, 1.5, preserveWindowTopology,
+                                                    capacity);
+                draw(ring, true, simplifier);
+                Line closed = recorder.lines[0];
+                closed.push_back(closed[0]);
+                worst = std::max(worst, deviation(ring, closed));
+
+                // The index of each kept point in the ring, with the closing point last. A full
+                // window passes its last point on to the next one.
+                std::vector<std::size_t> indices;
+                for (const Point& p : closed) {
+                    std::size_t index = 0;
+                    while (ring[index].x != p.x || ring[index].y != p.y) {
+                        ++index;
+                    }
+                    indices.push_back(index);
+                }
+                indices.back() = ring.size();
+                int tangled = 0;
+                for (std::size_t a = 0; a + 1 < closed.size(); ++a) {
+                    for (std::size_t b = a + 2; b + 1 < closed.size(); ++b) {
+                        if (indices[a] / (capacity - 1) == indices[b] / (capacity - 1) &&
+                            !(a == 0 && b + 2 == closed.size())) {
+                            tangled += crosses(closed[a], closed[a + 1], closed[b], closed[b + 1]);
+                        }
+                    }
+                }
+                (preserveWindowTopology ? preserved : plain) += tangled;
+            }
+        }
+        EXPECT_TRUE(plain > 0);
+        EXPECT_EQUALS(0, preserved);
+        EXPECT_TRUE(worst <= 1.5);
+    }
+
+    // Drawing after a closepath starts at the start of the ring.
+    {
+        Recorder recorder;
+        PathSimplifier<Recorder> simplifier(recorder, 0.1);
+        draw({ { 0, 0 }, { 4, 0 }, { 4, 4 } }, true, simplifier);
+        simplifier.lineTo(0, 2);
+        simplifier.lineTo(0, 4);
+        simplifier.finish();
+        EXPECT_EQUALS(std::size_t(1), recorder.lines.size());
+        EXPECT_EQUALS(std::size_t(4), recorder.lines[0].size());
+        EXPECT_EQUALS(4.0, recorder.lines[0][3].y);
+    }
+}
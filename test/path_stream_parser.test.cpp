@@ -0,0 +1,190 @@
+#include "path.hpp"
+
+#include <mapbox/svg/path_stream_parser.hpp>
+
+#include "expect.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace mapbox {
+namespace svg {
+namespace test {
+
+struct PathVertexReceiver {
+public:
+    Path path;
+
+    void moveTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::MoveTo(x, y, relative));
+    }
+
+    void closePath() {
+        path.emplace_back(PathCommand::ClosePath());
+    }
+
+    void lineTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::LineTo(x, y, relative));
+    }
+
+    void horizontalLineTo(double x, bool relative) {
+        path.emplace_back(PathCommand::HorizontalLineTo(x, relative));
+    }
+
+    void verticalLineTo(double y, bool relative) {
+        path.emplace_back(PathCommand::VerticalLineTo(y, relative));
+    }
+
+    void curveTo(double x1, double y1, double x2, double y2, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::CurveTo(x1, y1, x2, y2, x, y, relative));
+    }
+
+    void smoothCurveTo(double x2, double y2, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::SmoothCurveTo(x2, y2, x, y, relative));
+    }
+
+    void quadraticCurveTo(double x1, double y1, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::QuadraticCurveTo(x1, y1, x, y, relative));
+    }
+
+    void smoothQuadraticCurveTo(double x, double y, bool relative) {
+        path.emplace_back(PathCommand::SmoothQuadraticCurveTo(x, y, relative));
+    }
+
+    void arc(double rx, double ry, double xAxisRotation, bool largeArcFlag, bool sweepFlag, double x, double y, bool relative) {
+        path.emplace_back(PathCommand::Arc(rx, ry, xAxisRotation, largeArcFlag, sweepFlag, x, y, relative));
+    }
+};
+
+struct Result {
+    bool success;
+    PathParseErrorType error;
+    std::ptrdiff_t offset;
+    Path path;
+
+    bool operator==(const Result& other) const {
+        return success == other.success && error == other.error && offset == other.offset &&
+               path == other.path;
+    }
+};
+
+::std::ostream& operator<<(::std::ostream& os, const Result& result) {
+    return os << (result.success ? "success" : "failure") << " " << result.error << " at "
+              << result.offset << " " << result.path;
+}
+
+Result parse(const std::string& str) {
+    PathVertexReceiver receiver;
+    PathParser<PathVertexReceiver> parser(receiver);
+    const bool success = parser(str);
+    return { success, parser.errorType(), success ? 0 : parser.errorOffset(), receiver.path };
+}
+
+// Parses `str` in chunks of `chunkSize` bytes, starting with a first chunk of `firstSize`.
+Result parseChunked(const std::string& str, std::size_t firstSize, std::size_t chunkSize) {
+    PathVertexReceiver receiver;
+    PathStreamParser<PathVertexReceiver> parser(receiver);
+    bool success = true;
+    std::size_t offset = 0;
+    std::size_t size = firstSize;
+    while (success && offset < str.size()) {
+        size = std::min(size, str.size() - offset);
+        success = parser(str.data() + offset, size);
+        offset += size;
+        size = chunkSize;
+    }
+    success = success && parser.finish();
+    return { success, parser.errorType(), success ? 0 : parser.errorOffset(), receiver.path };
+}
+
+} // namespace test
+} // namespace svg
+} // namespace mapbox
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    PathVertexReceiver receiver;
+    PathStreamParser<PathVertexReceiver> parser(receiver);
+    EXPECT_TRUE(parser("M6,12,4,4a2 2 0 1", 17));
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(6, 12, false),
+                      test::PathCommand::MoveTo(4, 4, false),
+                  }),
+                  receiver.path);
+    EXPECT_TRUE(parser(std::string(" 1-2 2A2 2 0 0 1 6 12Z")));
+    EXPECT_TRUE(parser.finish());
+    EXPECT_EQUALS((test::Path{
+                      test::PathCommand::MoveTo(6, 12, false),
+                      test::PathCommand::MoveTo(4, 4, false),
+                      test::PathCommand::Arc(2, 2, 0, true, true, -2, 2, true),
+                      test::PathCommand::Arc(2, 2, 0, false, true, 6, 12, false),
+                      test::PathCommand::ClosePath(),
+                  }),
+                  receiver.path);
+
+    receiver.path.clear();
+    parser.reset();
+    EXPECT_TRUE(parser("M1 2L3", 6));
+    EXPECT_FALSE(parser.finish());
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, parser.errorType());
+    EXPECT_EQUALS(6, parser.errorOffset());
+
+    // Every way of splitting the input has to give the same result as PathParser.
+    const char* inputs[] = {
+        "M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z",
+        "M 10.5 1.5 l -2 3 h -5 l -2 -3 H 10.5 z m 1e1 , 2E-1 c .5.5-1-1+2.5e+1 3 4 5",
+        "M0 0s1 2 3 4 5 6q1 2 3 4t5 6 7 8V9v-1.5e3Zm1 1a1 1 0 0 0 1 1 1 1 0 1 1 2 2a5 5 30 1150 5",
+        "M1,2,",
+        "M1 2,,3",
+        "M,1 2",
+        "M1 2Z1",
+        "M1 2 Z, M3 4",
+        "L1 2e999",
+        "M1 2a1 1 0 2 0 1 1",
+        "M1 2 # 3",
+        "M1 2 #  ",
+        "M1 2 #  1",
+        "a1 1 0 1",
+        "M 1",
+        "",
+        "  ",
+    };
+    for (const char* input : inputs) {
+        const std::string str = input;
+        const Result expected = parse(str);
+        for (std::size_t first = 0; first <= str.size(); ++first) {
+            EXPECT_EQUALS(expected, parseChunked(str, first, str.size()));
+        }
+        EXPECT_EQUALS(expected, parseChunked(str, 1, 1));
+        EXPECT_EQUALS(expected, parseChunked(str, 3, 2));
+    }
+
+    // A receiver with only some of the methods gets the same calls as from PathParser.
+    {
+        const char* path =
+            "M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Zh1v2c1 2 3 4 5 6s1 2 3 4q1 2 3 4t5 6";
+        EndpointRecorder expectedEndpoints;
+        PathParser<EndpointRecorder> endpointParser(expectedEndpoints);
+        EXPECT_TRUE(endpointParser(path));
+        EndpointRecorder endpoints;
+        PathStreamParser<EndpointRecorder> streamParser(endpoints);
+        EXPECT_TRUE(streamParser(path, 20));
+        EXPECT_TRUE(streamParser(path + 20, std::strlen(path) - 20));
+        EXPECT_TRUE(streamParser.finish());
+        EXPECT_EQUALS(expectedEndpoints.path, endpoints.path);
+        EXPECT_EQUALS(PathCommand::LineTo(4, 4, false), endpoints.path[1]);
+    }
+
+    // A long run of numbers without separators is parsed as it arrives, one number at a time.
+    std::string run = "M0 0l";
+    for (int i = 0; i < 2000; ++i) {
+        run += "1-2.5.5e1-3e-1";
+    }
+    const Result expected = parse(run);
+    EXPECT_EQUALS(std::size_t(3001), expected.path.size());
+    EXPECT_EQUALS(expected, parseChunked(run, 1, 1));
+    EXPECT_EQUALS(expected, parseChunked(run, 4, 3));
+    EXPECT_EQUALS(expected, parseChunked(run, 5, 64));
+}
@@ -0,0 +1,208 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_tessellator.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Point {
+    double x, y;
+};
+
+using Rings = std::vector<std::vector<Point>>;
+
+template <typename Tessellator>
+void draw(const Rings& rings, Tessellator& tessellator) {
+    tessellator.reset();
+    for (const auto& ring : rings) {
+        tessellator.moveTo(ring[0].x, ring[0].y);
+        for (std::size_t i = 1; i < ring.size(); ++i) {
+            tessellator.lineTo(ring[i].x, ring[i].y);
+        }
+        tessellator.closePath();
+    }
+}
+
+struct Mesh {
+    std::vector<float> vertices = std::vector<float>(2 * 4096);
+    std::vector<uint32_t> indices = std::vector<uint32_t>(3 * 8192);
+    mapbox::svg::PathTessellator tessellator{ vertices.data(), 4096, indices.data(),
+                                              indices.size() };
+
+    // Total area of the triangles, and whether they all turn the same way.
+    double area(bool& consistent) const {
+        double sum = 0;
+        int positive = 0, negative = 0;
+        for (std::size_t i = 0; i < tessellator.indexCount(); i += 3) {
+            const float* a = &vertices[2 * indices[i]];
+            const float* b = &vertices[2 * indices[i + 1]];
+            const float* c = &vertices[2 * indices[i + 2]];
+            const double twice =
+                (double(b[0]) - a[0]) * (double(c[1]) - a[1]) -
+                (double(c[0]) - a[0]) * (double(b[1]) - a[1]);
+            positive += twice > 0;
+            negative += twice < 0;
+            sum += std::abs(twice) / 2;
+        }
+        consistent = positive == 0 || negative == 0;
+        return sum;
+    }
+};
+
+double ringArea(const std::vector<Point>& ring) {
+    double sum = 0;
+    for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        sum += ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+    }
+    return std::abs(sum) / 2;
+}
+
+std::vector<Point> square(const double x0, const double y0, const double x1, const double y1) {
+    return { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+}
+
+std::vector<Point> reversed(std::vector<Point> ring) {
+    return { ring.rbegin(), ring.rend() };
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    // A square, from a parsed path.
+    {
+        Mesh mesh;
+        PathFlattener<PathTessellator> flattener(mesh.tessellator);
+        PathNormalizer<PathFlattener<PathTessellator>> normalizer(flattener);
+        PathParser<PathNormalizer<PathFlattener<PathTessellator>>> parser(normalizer);
+        EXPECT_TRUE(parser("M1 1h3v3H1z"));
+        EXPECT_TRUE(mesh.tessellator.tessellate());
+        EXPECT_EQUALS(std::size_t(4), mesh.tessellator.vertexCount());
+        EXPECT_EQUALS(std::size_t(6), mesh.tessellator.indexCount());
+        bool consistent = false;
+        EXPECT_EQUALS(9.0, mesh.area(consistent));
+        EXPECT_TRUE(consistent);
+    }
+
+    // A circle with a hole, both drawn clockwise: the hole only shows with even-odd.
+    {
+        Mesh mesh;
+        PathFlattener<PathTessellator> flattener(mesh.tessellator, 0.01);
+        PathNormalizer<PathFlattener<PathTessellator>> normalizer(flattener);
+        PathParser<PathNormalizer<PathFlattener<PathTessellator>>> parser(normalizer);
+        EXPECT_TRUE(parser("M0 10A10 10 0 0 1 20 10A10 10 0 0 1 0 10ZM5 10A5 5 0 0 1 15 10A5 5 0 0 "
+                           "1 5 10Z"));
+        bool consistent = false;
+        EXPECT_TRUE(mesh.tessellator.tessellate(FillRule::NonZero));
+        EXPECT_TRUE(std::abs(mesh.area(consistent) - M_PI * 100) < 0.5);
+        EXPECT_TRUE(consistent);
+        EXPECT_TRUE(mesh.tessellator.tessellate(FillRule::EvenOdd));
+        EXPECT_TRUE(std::abs(mesh.area(consistent) - M_PI * 75) < 0.5);
+        EXPECT_TRUE(consistent);
+    }
+
+    // Nested rings: an island in a hole, next to a separate square.
+    {
+        Mesh mesh;
+        draw({ square(0, 0, 10, 10), reversed(square(2, 2, 8, 8)), square(4, 4, 6, 6),
+               square(20, 0, 21, 1) },
+             mesh.tessellator);
+        bool consistent = false;
+        EXPECT_TRUE(mesh.tessellator.tessellate(FillRule::NonZero));
+        EXPECT_EQUALS(100.0 - 36 + 4 + 1, mesh.area(consistent));
+        EXPECT_TRUE(consistent);
+        EXPECT_TRUE(mesh.tessellator.tessellate(FillRule::EvenOdd));
+        EXPECT_EQUALS(100.0 - 36 + 4 + 1, mesh.area(consistent));
+    }
+
+    // Many frames side by side, with the holes drawn first and from right to left.
+    {
+        Mesh mesh;
+        Rings rings;
+        for (int i = 199; i >= 0; --i) {
+            rings.push_back(reversed(square(i * 20 + 2, 2, i * 20 + 8, 8)));
+        }
+        for (int i = 0; i < 200; ++i) {
+            rings.push_back(square(i * 20, 0, i * 20 + 10, 10));
+        }
+        draw(rings, mesh.tessellator);
+        bool consistent = false;
+        EXPECT_TRUE(mesh.tessellator.tessellate(FillRule::NonZero));
+        EXPECT_EQUALS(200 * (100.0 - 36), mesh.area(consistent));
+        EXPECT_TRUE(consistent);
+    }
+
+    // Random polygons around a point, with an island of the same or the opposite direction.
+    {
+        std::mt19937 random(5);
+        std::uniform_real_distribution<double> center(-100, 100), radius(10, 20);
+        Mesh mesh;
+        int wrong = 0, inconsistent = 0;
+        for (int i = 0; i < 200; ++i) {
+            const double cx = center(random), cy = center(random);
+            Rings rings(2, std::vector<Point>(std::size_t(3 + i % 150)));
+            for (std::size_t k = 0; k < rings[0].size(); ++k) {
+                const double angle = 2 * M_PI * k / rings[0].size(), r = radius(random);
+                rings[0][k] = { cx + r * std::cos(angle), cy + r * std::sin(angle) };
+                rings[1][k] = { cx + 0.3 * r * std::cos(angle), cy + 0.3 * r * std::sin(angle) };
+            }
+            const bool opposite = i % 3 == 0;
+            if (opposite) {
+                rings[1] = reversed(rings[1]);
+            }
+            draw(rings, mesh.tessellator);
+            const FillRule rule = i % 2 ? FillRule::EvenOdd : FillRule::NonZero;
+            const double expected = rule == FillRule::NonZero && !opposite
+                                        ? ringArea(rings[0])
+                                        : ringArea(rings[0]) - ringArea(rings[1]);
+            bool consistent = false;
+            wrong += !mesh.tessellator.tessellate(rule) ||
+                     std::abs(mesh.area(consistent) - expected) > 1e-3 * expected;
+            inconsistent += !consistent;
+        }
+        EXPECT_EQUALS(0, wrong);
+        EXPECT_EQUALS(0, inconsistent);
+    }
+
+    // Buffers that are too small, and an index type that is too small for the vertices.
+    {
+        std::vector<float> vertices(2 * 4);
+        std::vector<uint16_t> indices(3);
+        BasicPathTessellator<uint16_t> tessellator(vertices.data(), 4, indices.data(),
+                                                   indices.size());
+        draw({ square(0, 0, 1, 1) }, tessellator);
+        EXPECT_FALSE(tessellator.tessellate());
+        EXPECT_EQUALS(std::size_t(3), tessellator.indexCount());
+
+        draw({ { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0.5, 1.5 }, { 0, 1 } } }, tessellator);
+        EXPECT_TRUE(tessellator.failed());
+        EXPECT_FALSE(tessellator.tessellate());
+
+        std::vector<float> large(2 * 1000);
+        std::vector<uint8_t> bytes(3 * 1000);
+        BasicPathTessellator<uint8_t> narrow(large.data(), 1000, bytes.data(), bytes.size());
+        std::vector<Point> ring;
+        for (int k = 0; k < 300; ++k) {
+            ring.push_back({ std::cos(2 * M_PI * k / 300), std::sin(2 * M_PI * k / 300) });
+        }
+        draw({ ring }, narrow);
+        EXPECT_TRUE(narrow.failed());
+    }
+
+    // Degenerate rings leave nothing to fill.
+    {
+        Mesh mesh;
+        draw({ { { 0, 0 }, { 1, 1 } }, { { 2, 2 }, { 2, 2 }, { 2, 2 } } }, mesh.tessellator);
+        EXPECT_TRUE(mesh.tessellator.tessellate());
+        EXPECT_EQUALS(std::size_t(0), mesh.tessellator.vertexCount());
+        EXPECT_EQUALS(std::size_t(0), mesh.tessellator.indexCount());
+    }
+}
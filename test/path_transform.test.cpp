@@ -0,0 +1,210 @@
+#include "path.hpp"
+
+#include <mapbox/svg/elliptical_arc.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_transform.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Normalized commands of the path after the transform stage.
+template <typename Transform>
+mapbox::svg::test::Path transformed(const std::string& path, const Transform& matrix) {
+    mapbox::svg::test::NormalizedPathRecorder receiver;
+    mapbox::svg::PathNormalizer<decltype(receiver)> normalizer(receiver);
+    mapbox::svg::PathTransform<decltype(normalizer), Transform> transform(normalizer, matrix);
+    mapbox::svg::PathParser<decltype(transform)> parser(transform);
+    parser(path);
+    return receiver.path;
+}
+
+bool near(const double a, const double b) {
+    return std::abs(a - b) <= 1e-9 * (1 + std::abs(a) + std::abs(b));
+}
+
+// Whether the transformed point lies on the arc, not just on its ellipse.
+bool onArc(const mapbox::svg::EllipticalArc& arc, const double x, const double y) {
+    const double dx = x - arc.cx, dy = y - arc.cy;
+    const double u = (arc.cosPhi * dx + arc.sinPhi * dy) / arc.rx;
+    const double v = (-arc.sinPhi * dx + arc.cosPhi * dy) / arc.ry;
+    if (std::abs(u * u + v * v - 1) > 1e-6) {
+        return false;
+    }
+    const double twoPi = 2 * M_PI;
+    double offset = std::atan2(v, u) - arc.theta1;
+    offset = arc.deltaTheta > 0 ? offset : -offset;
+    offset = std::fmod(std::fmod(offset, twoPi) + twoPi, twoPi);
+    return offset <= std::abs(arc.deltaTheta) + 1e-6 || offset >= twoPi - 1e-6;
+}
+
+// Compares the normalized commands of the untransformed path, with the matrix applied
+// afterwards, to those of the transformed path. Arcs are compared by sampling.
+bool matches(const mapbox::svg::test::Path& original,
+             const mapbox::svg::test::Path& actual,
+             const mapbox::svg::AffineTransform& matrix) {
+    using Type = mapbox::svg::test::PathCommand::Type;
+    if (original.size() != actual.size()) {
+        return false;
+    }
+    double x = 0, y = 0, startX = 0, startY = 0;
+    double actualX = 0, actualY = 0;
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        const Type type = original[i].type;
+        const std::vector<double> o = original[i].values();
+        const std::vector<double> a = actual[i].values();
+        if (type == Type::Arc) {
+            mapbox::svg::EllipticalArc before, after;
+            const bool curved = mapbox::svg::EllipticalArc::fromEndpoints(
+                x, y, o[0], o[1], o[2], o[3], o[4], o[5], o[6], before);
+            double endX = o[5], endY = o[6];
+            matrix.transformPoint(endX, endY);
+            if (a.size() < 2 || !near(endX, a[a.size() - 2]) || !near(endY, a.back())) {
+                return false;
+            }
+            if (curved && actual[i].type == Type::Arc &&
+                mapbox::svg::EllipticalArc::fromEndpoints(actualX, actualY, a[0], a[1], a[2], a[3],
+                                                          a[4], a[5], a[6], after)) {
+                for (int k = 0; k <= 8; ++k) {
+                    const double theta = before.theta1 + before.deltaTheta * k / 8;
+                    double px = before.pointX(theta), py = before.pointY(theta);
+                    matrix.transformPoint(px, py);
+                    if (!onArc(after, px, py)) {
+                        return false;
+                    }
+                }
+            } else if (curved && matrix.determinant() != 0) {
+                return false;
+            }
+        } else {
+            if (type != actual[i].type || o.size() != a.size()) {
+                return false;
+            }
+            for (std::size_t k = 0; k < o.size(); k += 2) {
+                double px = o[k], py = o[k + 1];
+                matrix.transformPoint(px, py);
+                if (!near(px, a[k]) || !near(py, a[k + 1])) {
+                    return false;
+                }
+            }
+        }
+        if (type == Type::MoveTo) {
+            startX = o[0];
+            startY = o[1];
+        }
+        if (type == Type::ClosePath) {
+            x = startX;
+            y = startY;
+        } else {
+            x = o[o.size() - 2];
+            y = o.back();
+        }
+        if (!a.empty()) {
+            actualX = a[a.size() - 2];
+            actualY = a.back();
+        } else {
+            actualX = startX;
+            actualY = startY;
+            matrix.transformPoint(actualX, actualY);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    PathRecorder receiver;
+
+    // Translations leave relative commands alone, except a leading relative moveto.
+    {
+        PathTransform<PathRecorder, TranslateTransform> transform(receiver, { 10, 20 });
+        PathParser<decltype(transform)> parser(transform);
+        EXPECT_TRUE(parser("m1 1h2V3a1 1 0 0 1 1 1"));
+        EXPECT_EQUALS((test::Path{
+                          test::PathCommand::MoveTo(11, 21, false),
+                          test::PathCommand::HorizontalLineTo(2, true),
+                          test::PathCommand::VerticalLineTo(23, false),
+                          test::PathCommand::Arc(1, 1, 0, false, true, 1, 1, true),
+                      }),
+                      receiver.path);
+    }
+
+    // A mirroring scale keeps horizontal and vertical lines and flips the sweep of arcs.
+    receiver.path.clear();
+    {
+        PathTransform<PathRecorder, ScaleTransform> transform(receiver, { 2, -3, 1, 1 });
+        PathParser<decltype(transform)> parser(transform);
+        EXPECT_TRUE(parser("M1 1h2v1A1 2 0 0 1 5 5"));
+        EXPECT_EQUALS((test::Path{
+                          test::PathCommand::MoveTo(3, -2, false),
+                          test::PathCommand::HorizontalLineTo(4, true),
+                          test::PathCommand::VerticalLineTo(-3, true),
+                          test::PathCommand::Arc(2, 6, 0, false, false, 11, -14, false),
+                      }),
+                      receiver.path);
+    }
+
+    // Rotating by 90 degrees turns horizontal lines into lines, and rotates the ellipse.
+    receiver.path.clear();
+    {
+        PathTransform<PathRecorder> transform(receiver, { 0, 1, -1, 0, 0, 0 });
+        PathParser<decltype(transform)> parser(transform);
+        EXPECT_TRUE(parser("M1 2H3h1A4 2 0 0 1 0 0"));
+        EXPECT_EQUALS(4u, receiver.path.size());
+        EXPECT_TRUE(receiver.path[1] == test::PathCommand::LineTo(-2, 3, false));
+        EXPECT_TRUE(receiver.path[2] == test::PathCommand::LineTo(0, 1, true));
+        const test::PathCommand& arc = receiver.path[3];
+        EXPECT_TRUE(near(4, arc.x1) && near(2, arc.y1) && near(90, std::abs(arc.xAxisRotation)));
+        EXPECT_TRUE(arc.sweepFlag);
+    }
+
+    // The composition applies the right-hand transform first.
+    const AffineTransform composed = AffineTransform(TranslateTransform{ 1, 2 }) *
+                                     AffineTransform(ScaleTransform{ 2, 3, 0, 0 });
+    double px = 1, py = 1;
+    composed.transformPoint(px, py);
+    EXPECT_TRUE(near(3, px) && near(5, py));
+
+    // Random paths through every specialization match transforming the normalized path.
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> coordinate(-20, 20);
+    const char commands[] = "MmLlHhVvCcSsQqTtAaZz";
+    const int arguments[] = { 2, 2, 2, 2, 1, 1, 1, 1, 6, 6, 4, 4, 4, 4, 2, 2, 7, 7, 0, 0 };
+    const std::size_t commandCount = sizeof(arguments) / sizeof(arguments[0]);
+    unsigned long mismatches = 0;
+    for (int i = 0; i < 5000; ++i) {
+        std::string path = random() % 2 ? "m" : "M";
+        path += std::to_string(coordinate(random)) + " " + std::to_string(coordinate(random));
+        for (int k = 0; k < 6; ++k) {
+            const std::size_t command = random() % commandCount;
+            path += commands[command];
+            for (int a = 0; a < arguments[command]; ++a) {
+                const bool flag = arguments[command] == 7 && (a == 3 || a == 4);
+                path += " " + std::to_string(flag ? int(random() % 2) : coordinate(random));
+            }
+        }
+
+        const test::Path original = transformed(path, IdentityTransform());
+        const TranslateTransform translate{ double(coordinate(random)),
+                                            double(coordinate(random)) };
+        const ScaleTransform scale{ coordinate(random) / 4.0, coordinate(random) / 4.0,
+                                    double(coordinate(random)), double(coordinate(random)) };
+        const AffineTransform affine(coordinate(random) / 4.0, coordinate(random) / 4.0,
+                                     coordinate(random) / 4.0, coordinate(random) / 4.0,
+                                     coordinate(random), coordinate(random));
+        mismatches += !matches(original, transformed(path, translate), translate);
+        mismatches += !matches(original, transformed(path, scale), scale);
+        mismatches += !matches(original, transformed(path, affine), affine);
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+}
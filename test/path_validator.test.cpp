@@ -0,0 +1,66 @@
+#include <mapbox/svg/path_validator.hpp>
+
+#include "expect.hpp"
+#include "path.hpp"
+
+#include <random>
+#include <string>
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    PathValidator validator;
+    EXPECT_TRUE(validator("M6,12,4,4a2 2 0 1 1-2 2A2 2 0 0 1 6 12Z"));
+    EXPECT_FALSE(validator.hasError());
+    EXPECT_EQUALS(5u, validator.statistics().commands);
+    EXPECT_EQUALS(1u, validator.statistics().subpaths);
+    EXPECT_EQUALS(2u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::MoveTo)]);
+    EXPECT_EQUALS(2u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::LineTo)]);
+    EXPECT_EQUALS(14u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::Arc)]);
+    EXPECT_EQUALS(14u, validator.statistics().coordinates());
+
+    // A drawing command after a closepath starts a new subpath.
+    EXPECT_TRUE(validator("M0 0h1v1zl2 2 3 3zM5 5c1 1 2 2 3 3"));
+    EXPECT_EQUALS(9u, validator.statistics().commands);
+    EXPECT_EQUALS(3u, validator.statistics().subpaths);
+    EXPECT_EQUALS(4u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::LineTo)]);
+    EXPECT_EQUALS(6u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::CurveTo)]);
+
+    // The pairs after the first one of a moveto are linetos in the same subpath.
+    EXPECT_TRUE(validator("M0 0 16 0 16 16zm1 1 2 2"));
+    EXPECT_EQUALS(6u, validator.statistics().commands);
+    EXPECT_EQUALS(2u, validator.statistics().subpaths);
+    EXPECT_EQUALS(4u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::MoveTo)]);
+    EXPECT_EQUALS(6u, validator.statistics().numbers[static_cast<uint8_t>(PathVerb::LineTo)]);
+
+    EXPECT_FALSE(validator("M0,0L1e999,0"));
+    EXPECT_EQUALS(PathParseErrorType::NumberParsing, validator.errorType());
+    EXPECT_EQUALS(5, validator.errorOffset());
+    EXPECT_EQUALS(1u, validator.statistics().commands);
+    EXPECT_TRUE(validator("M0,0L1.7976931348623157e308,0.0000000000000000000001e-999"));
+    EXPECT_FALSE(validator("M0,0L1.7976931348623159e308,0"));
+    EXPECT_TRUE(validator("M0.000000000000000000000000000000000000001e347,00000000000000e999"));
+    EXPECT_FALSE(validator("M0.00001e314,0"));
+
+    // Errors and offsets match a full parse for random input.
+    PathRecorder receiver;
+    PathParser<PathRecorder> parser(receiver);
+    std::mt19937 random(5);
+    const char alphabet[] = "MmLlHhVvCcSsQqTtAaZz0123456789.-+eE, \n99999999";
+    unsigned long mismatches = 0;
+    for (int i = 0; i < 100000; ++i) {
+        std::string path = "M";
+        const std::size_t length = random() % 24;
+        for (std::size_t k = 0; k < length; ++k) {
+            path += alphabet[random() % (sizeof(alphabet) - 1)];
+        }
+        receiver.path.clear();
+        const bool expected = parser(path);
+        const bool actual = validator(path);
+        mismatches += expected != actual || parser.errorType() != validator.errorType() ||
+                      (!expected && parser.errorOffset() != validator.errorOffset()) ||
+                      receiver.path.size() != validator.statistics().commands;
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+}
@@ -0,0 +1,199 @@
+#include "path.hpp"
+
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/path_writer.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+mapbox::svg::test::Path normalized(const std::string& path, bool& valid) {
+    mapbox::svg::test::NormalizedPathRecorder receiver;
+    mapbox::svg::PathNormalizer<decltype(receiver)> normalizer(receiver);
+    mapbox::svg::PathParser<decltype(normalizer)> parser(normalizer);
+    valid = bool(parser(path));
+    return receiver.path;
+}
+
+std::string write(const std::string& path, const int precision = -1) {
+    std::string d;
+    mapbox::svg::PathWriter writer(d, precision);
+    mapbox::svg::PathParser<mapbox::svg::PathWriter> parser(writer);
+    parser(path);
+    return d;
+}
+
+std::string shortest(const double value) {
+    char text[32];
+    return std::string(text, mapbox::svg::detail::writeShortest(value, text));
+}
+
+// Whether the written path parses into the same commands, within the given tolerance.
+bool roundTrips(const std::string& path, const int precision) {
+    bool valid = false;
+    using Type = mapbox::svg::test::PathCommand::Type;
+    const mapbox::svg::test::Path original = normalized(path, valid);
+    const mapbox::svg::test::Path actual = normalized(write(path, precision), valid);
+    if (!valid || original.size() != actual.size()) {
+        return false;
+    }
+    const double tolerance = precision < 0 ? 0 : 0.50001 * std::pow(10.0, -precision);
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        const Type type = original[i].type;
+        std::vector<double> o = original[i].values();
+        std::vector<double> a = actual[i].values();
+        if (type != actual[i].type || o.size() != a.size()) {
+            return false;
+        }
+        if (type == Type::Arc) {
+            // Radii are written without their sign.
+            o[0] = std::abs(o[0]);
+            o[1] = std::abs(o[1]);
+        }
+        for (std::size_t k = 0; k < o.size(); ++k) {
+            // The points of smooth curves are reflected from rounded ones.
+            const bool curve = type == Type::CurveTo || type == Type::QuadraticCurveTo;
+            const double slack = curve ? 3 * tolerance : tolerance;
+            const double error = std::abs(o[k] - a[k]);
+            if (!(error <= slack * (1 + 1e-12 * std::abs(o[k])))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    // Numbers.
+    EXPECT_EQUALS(std::string("0"), shortest(0));
+    EXPECT_EQUALS(std::string("0"), shortest(-0.0));
+    EXPECT_EQUALS(std::string(".5"), shortest(0.5));
+    EXPECT_EQUALS(std::string("-.05"), shortest(-0.05));
+    EXPECT_EQUALS(std::string("12.25"), shortest(12.25));
+    EXPECT_EQUALS(std::string("1e3"), shortest(1000));
+    EXPECT_EQUALS(std::string("100"), shortest(100));
+    EXPECT_EQUALS(std::string("1e-4"), shortest(0.0001));
+    EXPECT_EQUALS(std::string(".001"), shortest(0.001));
+    EXPECT_EQUALS(std::string(".30000000000000004"), shortest(0.1 + 0.2));
+    EXPECT_EQUALS(std::string("17976931348623157e292"), shortest(1.7976931348623157e308));
+    EXPECT_EQUALS(std::string("5e-324"), shortest(5e-324));
+    EXPECT_EQUALS(std::string("123456789012345680"), shortest(123456789012345678.0));
+
+    // Random doubles read back exactly, with no more significant digits than snprintf needs.
+    std::mt19937_64 bits(7);
+    unsigned long wrong = 0;
+    for (int i = 0; i < 100000; ++i) {
+        double value = 0;
+        // Half of them are below 2^53, where coordinates usually are.
+        const uint64_t small = bits() % (uint64_t(1) << 52) + (uint64_t(1075 - i % 90) << 52);
+        const uint64_t pattern = i % 2 ? bits() : small;
+        std::memcpy(&value, &pattern, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        const std::string text = shortest(value);
+        double parsed = 0;
+        mapbox::svg::detail::parseNumber(text.data(), text.data() + text.size(), parsed);
+        int needed = 1;
+        for (char buffer[32]; needed < 17; ++needed) {
+            std::snprintf(buffer, sizeof(buffer), "%.*e", needed - 1, value);
+            if (std::strtod(buffer, nullptr) == value) {
+                break;
+            }
+        }
+        std::string digits;
+        for (const char c : text.substr(0, text.find('e'))) {
+            if (c >= '0' && c <= '9' && (!digits.empty() || c != '0')) {
+                digits += c;
+            }
+        }
+        const std::size_t significant = digits.find_last_not_of('0') + 1;
+        wrong += parsed != value || significant > std::size_t(needed);
+    }
+    EXPECT_EQUALS(0ul, wrong);
+
+    // Commands.
+    EXPECT_EQUALS(std::string("M6 12 4 4A2 2 0 112 6a2 2 0 014 6Z"),
+                  write("M 6.0000, 12.0000 L 4, 4 a 2 2 0 1 1 -2 2 A 2 2 0 0 1 6 12 Z"));
+    EXPECT_EQUALS(std::string("M10 10h5V-10H0Z"), write("M10 10L15 10L15 -10L0 -10Z"));
+    EXPECT_EQUALS(std::string("M0 0M1 1"), write("M0 0m1 1"));
+    EXPECT_EQUALS(std::string("M0 0 1 1 2 3ZL4 4"), write("M0 0L1 1L2 3ZL4 4"));
+    EXPECT_EQUALS(std::string("M100 100Zm1 1 1 1"), write("M100 100ZM101 101L102 102"));
+    EXPECT_EQUALS(std::string("M.5.5H.75-.5-1.25"), write("M0.5 0.5l0.25 0l-1.25 0l-0.75 0"));
+    EXPECT_EQUALS(std::string("M0 0C1 1 2 2 3 3S4 5 5 5"), write("M0 0C1 1 2 2 3 3C4 4 4 5 5 5"));
+    EXPECT_EQUALS(std::string("M100 100c10 10 20 20 30 30s10 20 20 20"),
+                  write("M100 100C110 110 120 120 130 130C140 140 140 150 150 150"));
+    EXPECT_EQUALS(std::string("M10 0q1 1 2 0t2 0"), write("M10 0Q11 1 12 0T14 0"));
+    EXPECT_EQUALS(std::string("M0 0S1 1 2 2"), write("M0 0C0 0 1 1 2 2"));
+    EXPECT_EQUALS(std::string("M100 100a5 5 30 101 1"), write("M100 100A-5 5 30 1 0 101 101"));
+
+    // Precision.
+    EXPECT_EQUALS(std::string("M.333.667 1 1"), write("M0.33333 0.66667L0.99999 1.00001", 3));
+    EXPECT_EQUALS(std::string("M11 2h1"), write("M11.04 2.04L12.04 2", 1));
+    EXPECT_EQUALS(std::string("M0 0H0"), write("M0.2 0.1L-0.3 -0.1", 0));
+    // Beyond the range of integers, coordinates are written as they are.
+    EXPECT_EQUALS(std::string("M1e20 0"), write("M1e20 0", 3));
+    EXPECT_EQUALS(std::string("M-12345678901234567e4 1.5V1e300"),
+                  write("M-123456789012345670000 1.5L-123456789012345670000 1e300", 3));
+
+    // Relative coordinates that don't add up to the exact value are written absolute.
+    EXPECT_EQUALS(std::string("M.1 0H.3"), write("M0.1 0L0.3 0"));
+
+    // The buffer is appended to, so it can be reused.
+    std::string d;
+    mapbox::svg::PathWriter writer(d);
+    mapbox::svg::PathParser<mapbox::svg::PathWriter> parser(writer);
+    parser("m1 1h1");
+    d.clear();
+    writer.reset();
+    parser("m1 1h1");
+    EXPECT_EQUALS(std::string("M1 1H2"), d);
+
+    // Random paths, written at full and at reduced precision, parse back into the same geometry.
+    std::mt19937 random(5);
+    std::uniform_int_distribution<int> integer(-200, 200);
+    std::uniform_real_distribution<double> real(-1000, 1000);
+    const char commands[] = "MmLlHhVvCcSsQqTtAaZz";
+    const int arguments[] = { 2, 2, 2, 2, 1, 1, 1, 1, 6, 6, 4, 4, 4, 4, 2, 2, 7, 7, 0, 0 };
+    const std::size_t commandCount = sizeof(arguments) / sizeof(arguments[0]);
+    unsigned long mismatches = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const int kind = i % 3;
+        const auto number = [&]() {
+            char text[32];
+            switch (kind) {
+                case 0: std::snprintf(text, sizeof(text), "%d", integer(random) / 10); break;
+                case 1: std::snprintf(text, sizeof(text), "%.2f", integer(random) / 20.0); break;
+                default: std::snprintf(text, sizeof(text), "%.17g", real(random)); break;
+            }
+            return std::string(text);
+        };
+        std::string path = random() % 2 ? "m" : "M";
+        path += number() + " " + number();
+        for (int k = 0; k < 8; ++k) {
+            const std::size_t command = random() % commandCount;
+            path += commands[command];
+            for (int a = 0; a < arguments[command]; ++a) {
+                const bool flag = arguments[command] == 7 && (a == 3 || a == 4);
+                path += " " + (flag ? std::to_string(random() % 2) : number());
+            }
+        }
+        mismatches += !roundTrips(path, -1);
+        mismatches += !roundTrips(path, 3);
+        // Writing is idempotent.
+        const std::string once = write(path, 3);
+        mismatches += once != write(once, 3);
+    }
+    EXPECT_EQUALS(0ul, mismatches);
+}
@@ -0,0 +1,192 @@
+#include <mapbox/svg/path_flattener.hpp>
+#include <mapbox/svg/path_normalizer.hpp>
+#include <mapbox/svg/path_parser.hpp>
+#include <mapbox/svg/sdf_generator.hpp>
+
+#include "expect.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Point {
+    double x, y;
+};
+
+using Rings = std::vector<std::vector<Point>>;
+
+void draw(const Rings& rings, mapbox::svg::SdfGenerator& sdf) {
+    sdf.reset();
+    for (const auto& ring : rings) {
+        sdf.moveTo(ring[0].x, ring[0].y);
+        for (std::size_t i = 1; i < ring.size(); ++i) {
+            sdf.lineTo(ring[i].x, ring[i].y);
+        }
+    }
+}
+
+// Reference: the winding number and the distance from every segment, for every pixel.
+std::vector<uint8_t> bruteForce(const Rings& rings, const mapbox::svg::SdfOptions& options) {
+    std::vector<mapbox::svg::detail::SdfSegment> edges;
+    const double offset = options.buffer;
+    for (const auto& ring : rings) {
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            const Point& a = ring[i];
+            const Point& b = ring[(i + 1) % ring.size()];
+            if (a.x != b.x || a.y != b.y) {
+                edges.push_back(mapbox::svg::detail::makeSdfSegment(a.x + offset, a.y + offset,
+                                                                    b.x + offset, b.y + offset));
+            }
+        }
+    }
+
+    const std::size_t width = options.width + 2 * options.buffer;
+    const std::size_t height = options.height + 2 * options.buffer;
+    std::vector<uint8_t> field;
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t column = 0; column < width; ++column) {
+            const double px = column + 0.5, py = row + 0.5;
+            int winding = 0;
+            double best = INFINITY;
+            for (const auto& e : edges) {
+                if (std::min(e.y0, e.y1) <= py && py < std::max(e.y0, e.y1) &&
+                    e.x0 + (py - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0) < px) {
+                    winding += e.y1 > e.y0 ? 1 : -1;
+                }
+                best = std::min(best, mapbox::svg::detail::segmentDistanceSquared(e, px, py));
+            }
+            const double distance = mapbox::svg::isInside(options.fillRule, winding)
+                                        ? -std::sqrt(best)
+                                        : std::sqrt(best);
+            const double value =
+                std::floor(255 - 255 * (distance / options.radius + options.cutoff) + 0.5);
+            field.push_back(uint8_t(std::min(255.0, std::max(0.0, value))));
+        }
+    }
+    return field;
+}
+
+Rings randomRings(std::mt19937& random, const double low, const double high) {
+    std::uniform_real_distribution<double> coordinate(low, high);
+    std::uniform_int_distribution<int> count(1, 12);
+    Rings rings(std::size_t(count(random) % 3 + 1));
+    for (auto& ring : rings) {
+        ring.resize(std::size_t(count(random) + 2));
+        for (auto& point : ring) {
+            point = { coordinate(random), coordinate(random) };
+        }
+    }
+    return rings;
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+
+    // A square, from a parsed path.
+    {
+        SdfGenerator sdf;
+        PathFlattener<SdfGenerator> flattener(sdf);
+        PathNormalizer<PathFlattener<SdfGenerator>> normalizer(flattener);
+        PathParser<PathNormalizer<PathFlattener<SdfGenerator>>> parser(normalizer);
+        EXPECT_TRUE(parser("M4 4h16v16H4z"));
+        EXPECT_EQUALS(std::size_t(4), sdf.size());
+
+        std::vector<uint8_t> field;
+        sdf.generate(SdfOptions(), field);
+        EXPECT_EQUALS(std::size_t(30 * 30), field.size());
+        EXPECT_EQUALS(255, int(field[15 * 30 + 15]));
+        // Half a pixel inside and outside of the edge.
+        EXPECT_EQUALS(207, int(field[15 * 30 + 7]));
+        EXPECT_EQUALS(175, int(field[15 * 30 + 6]));
+        EXPECT_EQUALS(0, int(field[0]));
+    }
+
+    // Fill rules, with a square inside another of the same direction.
+    {
+        SdfGenerator sdf;
+        draw({ { { 0, 0 }, { 24, 0 }, { 24, 24 }, { 0, 24 } },
+               { { 6, 6 }, { 18, 6 }, { 18, 18 }, { 6, 18 } } },
+             sdf);
+        SdfOptions options;
+        options.radius = 4;
+        std::vector<uint8_t> field;
+        sdf.generate(options, field);
+        EXPECT_EQUALS(255, int(field[15 * 30 + 15]));
+        options.fillRule = FillRule::EvenOdd;
+        sdf.generate(options, field);
+        EXPECT_EQUALS(0, int(field[15 * 30 + 15]));
+        EXPECT_EQUALS(255, int(field[15 * 30 + 6]));
+    }
+
+    // Random polygons, partly outside of the field, match the reference exactly.
+    {
+        std::mt19937 random(7);
+        SdfGenerator sdf;
+        std::vector<uint8_t> field;
+        int mismatches = 0;
+        for (int i = 0; i < 200; ++i) {
+            const Rings rings = randomRings(random, -10, 40);
+            draw(rings, sdf);
+            SdfOptions options;
+            options.fillRule = i % 2 ? FillRule::EvenOdd : FillRule::NonZero;
+            options.radius = i % 3 ? 8 : 2.5;
+            options.cutoff = i % 4 ? 0.25 : 0.75;
+            options.buffer = unsigned(i % 5);
+            options.width = 24 + unsigned(i % 7);
+            sdf.generate(options, field);
+            mismatches += field != bruteForce(rings, options);
+        }
+        EXPECT_EQUALS(0, mismatches);
+    }
+
+    // Threads split the rows without changing the result.
+    {
+        std::mt19937 random(11);
+        const Rings rings = randomRings(random, 0, 200);
+        SdfGenerator sdf;
+        draw(rings, sdf);
+        SdfOptions options;
+        options.width = options.height = 200;
+        options.buffer = 8;
+        options.radius = 16;
+        std::vector<uint8_t> single, parallel;
+        options.threads = 1;
+        sdf.generate(options, single);
+        options.threads = 4;
+        sdf.generate(options, parallel);
+        EXPECT_TRUE(single == parallel);
+        EXPECT_TRUE(single == bruteForce(rings, options));
+    }
+
+    // Coordinates far outside of the grid, or not finite, fall into its border cells.
+    {
+        SdfGenerator sdf;
+        sdf.moveTo(-1e100, -1e100);
+        sdf.lineTo(1e100, -1e100);
+        sdf.lineTo(0, 1e100);
+        std::vector<uint8_t> field;
+        sdf.generate(SdfOptions(), field);
+        EXPECT_TRUE(std::all_of(field.begin(), field.end(), [](uint8_t v) { return v == 255; }));
+
+        sdf.reset();
+        sdf.moveTo(NAN, 0);
+        sdf.lineTo(INFINITY, -INFINITY);
+        sdf.lineTo(1, 2);
+        sdf.generate(SdfOptions(), field);
+        EXPECT_EQUALS(std::size_t(30 * 30), field.size());
+    }
+
+    // An empty path is outside everywhere.
+    {
+        SdfGenerator sdf;
+        std::vector<uint8_t> field;
+        sdf.generate(SdfOptions(), field);
+        EXPECT_TRUE(std::all_of(field.begin(), field.end(), [](uint8_t v) { return v == 0; }));
+    }
+}
@@ -0,0 +1,228 @@
+#include "path.hpp"
+
+#include <mapbox/svg/mapped_file.hpp>
+#include <mapbox/svg/path_bounds.hpp>
+#include <mapbox/svg/svg_reader.hpp>
+
+#include "expect.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Shape {
+    mapbox::svg::SvgShapeType type;
+    std::string id;
+    mapbox::svg::test::Path path;
+    mapbox::svg::BoundingBox bounds;
+    bool valid;
+};
+
+std::vector<Shape> read(const std::string& document, bool& failed) {
+    std::vector<Shape> shapes;
+    mapbox::svg::SvgReader reader(document.data(), document.size());
+    mapbox::svg::SvgShape shape;
+    while (reader.next(shape)) {
+        mapbox::svg::test::PathRecorder receiver;
+        mapbox::svg::PathBounds bounds;
+        mapbox::svg::PathSlice id = { "", 0 };
+        shape.tag.attribute("id", id);
+        const bool valid = shape.draw(receiver);
+        shape.drawTransformed(bounds);
+        shapes.push_back(
+            { shape.type, std::string(id.data, id.size), receiver.path, bounds.bounds(), valid });
+    }
+    failed = reader.failed();
+    return shapes;
+}
+
+bool near(const double a, const double b) {
+    return std::abs(a - b) < 1e-9;
+}
+
+bool boundsNear(const mapbox::svg::BoundingBox& box,
+                double minX,
+                double minY,
+                double maxX,
+                double maxY) {
+    return near(box.minX, minX) && near(box.minY, minY) && near(box.maxX, maxX) &&
+           near(box.maxY, maxY);
+}
+
+} // namespace
+
+int main() {
+    using namespace mapbox::svg;
+    using namespace mapbox::svg::test;
+
+    // Tags and attributes, around everything else a document can contain.
+    {
+        const std::string document =
+            "<?xml version=\"1.0\"?>\n<!DOCTYPE svg [ <!ENTITY a \"<b>\"> ]>\n"
+            "<!-- <path d='M0 0'/> --><svg xmlns='http://www.w3.org/2000/svg'>"
+            "<style><![CDATA[ path > rect { } ]]></style>text &amp; more"
+            "<svg:path d = 'M1 2' id=\"a>b\"/></svg>";
+        SvgTokenizer tokenizer(document.data(), document.size());
+        SvgTag tag;
+        std::vector<std::string> tags;
+        while (tokenizer.next(tag)) {
+            tags.push_back(std::string(tag.type == SvgTag::Type::End     ? "/"
+                                       : tag.type == SvgTag::Type::Empty ? "+"
+                                                                         : "") +
+                           std::string(tag.name.data, tag.name.size));
+            if (tag.is("path")) {
+                PathSlice value;
+                EXPECT_TRUE(tag.attribute("d", value) && detail::sliceEquals(value, "M1 2"));
+                EXPECT_TRUE(tag.attribute("id", value) && detail::sliceEquals(value, "a>b"));
+                EXPECT_FALSE(tag.attribute("i", value));
+            }
+        }
+        EXPECT_FALSE(tokenizer.failed());
+        EXPECT_EQUALS(std::size_t(5), tags.size());
+        EXPECT_EQUALS(std::string("svg style /style +path /svg"),
+                      tags[0] + " " + tags[1] + " " + tags[2] + " " + tags[3] + " " + tags[4]);
+    }
+
+    // Malformed markup is reported where it starts.
+    for (const char* document : { "<svg><path d='M0 0/></svg>", "<svg><!-- </svg>",
+                                  "<svg><path d=M0/></svg>", "<svg><path/ ></svg>",
+                                  "<svg><pathd='M0'></svg>" }) {
+        SvgTokenizer tokenizer(document, std::strlen(document));
+        SvgTag tag;
+        while (tokenizer.next(tag)) {
+        }
+        EXPECT_TRUE(tokenizer.failed());
+        EXPECT_EQUALS(std::ptrdiff_t(5), tokenizer.errorOffset());
+    }
+
+    // Transform lists.
+    {
+        AffineTransform t;
+        const char* list = " translate(10,20) scale(2) , rotate(90 1 1)skewX(45)";
+        EXPECT_TRUE(parseTransform(list, list + std::strlen(list), t));
+        double x = 1, y = 0;
+        t.transformPoint(x, y);
+        // skewX(45) keeps (1, 0), rotate(90) around (1, 1) takes it to (2, 1), and so on.
+        EXPECT_TRUE(near(14, x) && near(22, y));
+        const char* matrix = "matrix(1 2 3 4 5 6)";
+        EXPECT_TRUE(parseTransform(matrix, matrix + std::strlen(matrix), t));
+        EXPECT_TRUE(t.a == 1 && t.b == 2 && t.c == 3 && t.d == 4 && t.e == 5 && t.f == 6);
+        for (const char* invalid : { "translate(1 2 3)", "scale(1", "rotate(1 2)", "foo(1)",
+                                     "matrix(1 2 3 4 5 6 7)", "translate(1)x" }) {
+            EXPECT_FALSE(parseTransform(invalid, invalid + std::strlen(invalid), t));
+        }
+    }
+
+    // Shapes, with inherited transforms, skipping definitions and hidden elements.
+    {
+        const std::string document =
+            "<svg xmlns='http://www.w3.org/2000/svg' viewBox='0 0 24 24'>"
+            "<defs><path id='hidden' d='M0 0h100'/></defs>"
+            "<g transform='translate(100 0)'><g transform='scale(2)'>"
+            "<path id='p' d='M1 1h2v2z' transform='translate(1 1)'/>"
+            "</g><rect id='r' x='1' y='2' width='3' height='4'/></g>"
+            "<g display='none'><circle r='1'/></g>"
+            "<rect id='rounded' x='0' y='0' width='10' height='4' rx='3'/>"
+            "<circle id='c' cx='5' cy='5' r='2'/>"
+            "<ellipse id='e' cx='0' cy='0' ry='3'/>"
+            "<line id='l' x1='1' y1='2' x2='3px' y2='4'/>"
+            "<polygon id='pg' points='0,0 4,0 4 3'/>"
+            "<polyline id='pl' points='0 0 1 1 2'/>"
+            "<rect id='empty' width='0' height='4'/>"
+            "</svg>";
+        bool failed = true;
+        const std::vector<Shape> shapes = read(document, failed);
+        EXPECT_FALSE(failed);
+        EXPECT_EQUALS(std::size_t(9), shapes.size());
+        EXPECT_EQUALS(std::string("p"), shapes[0].id);
+        EXPECT_EQUALS((Path{ PathCommand::MoveTo(1, 1, false),
+                             PathCommand::HorizontalLineTo(2, true),
+                             PathCommand::VerticalLineTo(2, true), PathCommand::ClosePath() }),
+                      shapes[0].path);
+        EXPECT_TRUE(boundsNear(shapes[0].bounds, 104, 4, 108, 8));
+
+        EXPECT_EQUALS(std::string("r"), shapes[1].id);
+        EXPECT_TRUE(boundsNear(shapes[1].bounds, 101, 2, 104, 6));
+
+        // Radii are clamped to half the size, and ry defaults to rx.
+        EXPECT_EQUALS(std::string("rounded"), shapes[2].id);
+        EXPECT_EQUALS(std::size_t(10), shapes[2].path.size());
+        EXPECT_TRUE(shapes[2].path[0] == PathCommand::MoveTo(3, 0, false));
+        EXPECT_TRUE(shapes[2].path[2] == PathCommand::Arc(3, 2, 0, false, true, 10, 2, false));
+        EXPECT_TRUE(boundsNear(shapes[2].bounds, 0, 0, 10, 4));
+
+        EXPECT_EQUALS(std::string("c"), shapes[3].id);
+        EXPECT_EQUALS((Path{ PathCommand::MoveTo(7, 5, false),
+                             PathCommand::Arc(2, 2, 0, false, true, 5, 7, false),
+                             PathCommand::Arc(2, 2, 0, false, true, 3, 5, false),
+                             PathCommand::Arc(2, 2, 0, false, true, 5, 3, false),
+                             PathCommand::Arc(2, 2, 0, false, true, 7, 5, false),
+                             PathCommand::ClosePath() }),
+                      shapes[3].path);
+
+        EXPECT_TRUE(shapes[4].type == SvgShapeType::Ellipse);
+        EXPECT_TRUE(boundsNear(shapes[4].bounds, -3, -3, 3, 3));
+
+        EXPECT_EQUALS((Path{ PathCommand::MoveTo(1, 2, false), PathCommand::LineTo(3, 4, false) }),
+                      shapes[5].path);
+
+        EXPECT_EQUALS((Path{ PathCommand::MoveTo(0, 0, false), PathCommand::LineTo(4, 0, false),
+                             PathCommand::LineTo(4, 3, false), PathCommand::ClosePath() }),
+                      shapes[6].path);
+
+        // A dangling coordinate is an error, after the points before it.
+        EXPECT_EQUALS(std::string("pl"), shapes[7].id);
+        EXPECT_FALSE(shapes[7].valid);
+        EXPECT_EQUALS((Path{ PathCommand::MoveTo(0, 0, false), PathCommand::LineTo(1, 1, false) }),
+                      shapes[7].path);
+
+        EXPECT_TRUE(shapes[8].path.empty());
+    }
+
+    // Unbalanced end tags.
+    {
+        bool failed = false;
+        read("<svg></svg></g>", failed);
+        EXPECT_TRUE(failed);
+    }
+
+    // End tags that don't match the open element, including its prefix.
+    for (const char* document : { "<svg><g></svg>", "<svg><g></svg:g>", "<svg><g></gg>" }) {
+        const std::string text = document;
+        SvgReader reader(text.data(), text.size());
+        SvgShape shape;
+        EXPECT_FALSE(reader.next(shape));
+        EXPECT_TRUE(reader.failed());
+        EXPECT_EQUALS(std::ptrdiff_t(10), reader.errorOffset());
+    }
+    {
+        bool failed = true;
+        read("<svg:svg><svg:g></svg:g><g/></svg:svg>", failed);
+        EXPECT_FALSE(failed);
+    }
+
+    // Reading from a file.
+    {
+        const char* filename = "svg_reader.test.svg";
+        std::FILE* file = std::fopen(filename, "wb");
+        const std::string document = "<svg><path d='M0 0L10 10'/></svg>";
+        std::fwrite(document.data(), 1, document.size(), file);
+        std::fclose(file);
+
+        MappedFile mapped;
+        EXPECT_TRUE(mapped.open(filename));
+        EXPECT_EQUALS(document, std::string(mapped.data(), mapped.size()));
+        SvgReader reader(mapped.data(), mapped.size());
+        SvgShape shape;
+        EXPECT_TRUE(reader.next(shape));
+        EXPECT_FALSE(reader.next(shape));
+        mapped.close();
+        std::remove(filename);
+        EXPECT_FALSE(mapped.open(filename));
+        EXPECT_EQUALS(std::size_t(0), mapped.size());
+    }
+}